@@ -0,0 +1,157 @@
+#ifndef BINARY_MESSAGE_H
+#define BINARY_MESSAGE_H
+
+#include <boost/beast/core/flat_buffer.hpp>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <span>
+
+namespace horiba::communication {
+
+/**
+ * @brief Types of binary messages sent by the ICL once binary mode is enabled
+ * with icl_binMode.
+ */
+enum class BinaryMessageType : std::uint8_t {
+  LOG = 0,
+  INFORMATION = 1,
+  DATA = 2,
+  UNKNOWN = 3,
+};
+
+/**
+ * @brief Decides the type of a binary message based on its content.
+ */
+using BinaryMessageClassifier =
+    std::function<BinaryMessageType(std::span<const std::byte> frame)>;
+
+/**
+ * @brief Default classifier for binary messages of the ICL.
+ *
+ * The first byte of the frame is interpreted as the type tag: 0 for logs, 1
+ * for information and 2 for data. Empty frames and other tags are unknown.
+ *
+ * @param frame The content of the binary message
+ *
+ * @return The type of the binary message
+ */
+BinaryMessageType default_binary_message_classifier(
+    std::span<const std::byte> frame);
+
+/**
+ * @brief Binary message received from the ICL.
+ *
+ * The message takes over the buffer the frame has been read into, so the
+ * content is never copied. It is immutable and shared between all the
+ * subscribers of its type.
+ */
+class BinaryMessage {
+ public:
+  /**
+   * @brief Builds a binary message from the buffer the frame has been read
+   * into.
+   *
+   * @param type The type of the message
+   * @param buffer The buffer containing the whole frame
+   */
+  BinaryMessage(BinaryMessageType type, boost::beast::flat_buffer buffer);
+
+  /**
+   * @brief Type of the message.
+   *
+   * @return The type of the message
+   */
+  [[nodiscard]] BinaryMessageType type() const;
+
+  /**
+   * @brief Content of the whole frame, including the type tag.
+   *
+   * @return View on the content of the message, valid as long as the message
+   * lives
+   */
+  [[nodiscard]] std::span<const std::byte> data() const;
+
+  /**
+   * @brief Size of the frame in bytes.
+   *
+   * @return The size of the message
+   */
+  [[nodiscard]] std::size_t size() const;
+
+ private:
+  BinaryMessageType message_type;
+  boost::beast::flat_buffer buffer;
+};
+
+/**
+ * @brief Thread safe queue of binary messages of one type, filled by the
+ * communicator and emptied by a subscriber.
+ *
+ * If a capacity is given, the oldest message is dropped when a new message
+ * arrives at a full queue, so a slow subscriber never holds back the
+ * communication.
+ */
+class BinaryMessageQueue {
+ public:
+  /**
+   * @brief Creates a queue.
+   *
+   * @param capacity Maximum amount of queued messages, 0 for no limit
+   */
+  explicit BinaryMessageQueue(std::size_t capacity = 0);
+
+  /**
+   * @brief Adds a message at the end of the queue.
+   *
+   * @param message The message to add
+   */
+  void push(std::shared_ptr<const BinaryMessage> message);
+
+  /**
+   * @brief Takes the oldest message from the queue, if any.
+   *
+   * @return The oldest message, or nullptr if the queue is empty
+   */
+  std::shared_ptr<const BinaryMessage> try_pop();
+
+  /**
+   * @brief Waits until a message is available and takes it from the queue.
+   *
+   * @param timeout Maximum time to wait for a message
+   *
+   * @return The oldest message, or nullptr if none arrived in time
+   */
+  std::shared_ptr<const BinaryMessage> wait_and_pop(
+      std::chrono::milliseconds timeout);
+
+  /**
+   * @brief Number of queued messages.
+   *
+   * @return The number of messages in the queue
+   */
+  [[nodiscard]] std::size_t size();
+
+  /**
+   * @brief Number of messages dropped because the queue was full.
+   *
+   * @return The number of dropped messages
+   */
+  [[nodiscard]] std::size_t dropped();
+
+ private:
+  std::size_t capacity;
+  std::size_t dropped_messages{0};
+  std::mutex mutex;
+  std::condition_variable message_available;
+  std::deque<std::shared_ptr<const BinaryMessage>> messages;
+};
+
+} /* namespace horiba::communication */
+
+#endif /* ifndef BINARY_MESSAGE_H */
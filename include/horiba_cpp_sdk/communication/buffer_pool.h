@@ -0,0 +1,56 @@
+#ifndef BUFFER_POOL_H
+#define BUFFER_POOL_H
+
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace horiba::communication {
+
+/**
+ * @brief Thread safe pool of text buffers.
+ *
+ * Released buffers keep their capacity, so once the pool is warmed up, reading
+ * and writing messages of similar size does not allocate.
+ */
+class BufferPool {
+ public:
+  /**
+   * @brief Creates an empty pool.
+   *
+   * @param max_buffers Maximum amount of buffers kept, additional released
+   * buffers are freed
+   */
+  explicit BufferPool(std::size_t max_buffers = 64);
+
+  /**
+   * @brief Takes a buffer from the pool.
+   *
+   * @return An empty buffer, with the capacity it had when released
+   */
+  std::string acquire();
+
+  /**
+   * @brief Gives a buffer back to the pool.
+   *
+   * @param buffer The buffer to give back
+   */
+  void release(std::string buffer);
+
+  /**
+   * @brief Number of buffers available in the pool.
+   *
+   * @return The number of buffers in the pool
+   */
+  [[nodiscard]] std::size_t size();
+
+ private:
+  std::size_t max_buffers;
+  std::mutex mutex;
+  std::vector<std::string> buffers;
+};
+
+} /* namespace horiba::communication */
+
+#endif /* ifndef BUFFER_POOL_H */
@@ -27,9 +27,40 @@ class Command {
    */
   [[nodiscard]] nlohmann::json json() const;
 
+  /**
+   * @brief Writes the JSON text of the command into a buffer, without building
+   * an intermediate JSON value. The buffer is cleared first but keeps its
+   * capacity, so reusing it avoids allocations.
+   *
+   * @param buffer The buffer to write the command into
+   */
+  void serialize(std::string& buffer) const;
+
+  /**
+   * @brief Unique id of the command. The ICL echoes it back in the response,
+   * which allows to match responses to their commands.
+   *
+   * @return The id of the command
+   */
+  [[nodiscard]] unsigned long long int id() const;
+
+  /**
+   * @brief Name of the ICL command, e.g. "ccd_getConfig".
+   *
+   * @return The name of the command
+   */
+  [[nodiscard]] const std::string& name() const;
+
+  /**
+   * @brief Parameters of the ICL command.
+   *
+   * @return The JSON parameters of the command
+   */
+  [[nodiscard]] const nlohmann::json& json_parameters() const;
+
  private:
   static std::atomic<unsigned long long int> next_id;
-  unsigned long long int id;
+  unsigned long long int command_id;
   std::string command;
   nlohmann::json parameters;
 };
@@ -1,16 +1,43 @@
 #ifndef COMMUNICATOR_H
 #define COMMUNICATOR_H
 
+#include <horiba_cpp_sdk/communication/binary_message.h>
+#include <horiba_cpp_sdk/communication/response.h>
+
+#include <boost/asio/async_result.hpp>
+#include <boost/asio/executor_work_guard.hpp>
+#include <boost/asio/post.hpp>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+
 namespace horiba::communication {
 
 class Command;
-class Response;
 
 /**
  * @brief Interface representing a communication channel with the ICL.
+ *
+ * Requests are asynchronous: many commands can be in flight at the same time
+ * and their responses are matched to them by the command id. The synchronous
+ * request_with_response() is built on top of the asynchronous request, and
+ * async_request() adapts it to boost::asio completion tokens, e.g. coroutines.
  */
 class Communicator {
  public:
+  /**
+   * @brief Completion handler of an asynchronous request.
+   *
+   * On success the exception pointer is null and the response is the one of
+   * the ICL. On failure the exception pointer is set and the response is empty.
+   */
+  using ResponseHandler =
+      std::function<void(std::exception_ptr error, Response response)>;
+
   virtual ~Communicator() = default;
 
   /**
@@ -30,6 +57,87 @@ class Communicator {
    */
   virtual bool is_open() = 0;
 
+  /**
+   * @brief Sends a command to the ICL without waiting for the response.
+   *
+   * The handler is called once the response with the id of the command has
+   * been received, or when the request failed. It is called from the thread
+   * that handles the communication, so it must not block.
+   *
+   * @param command The command for the ICL
+   * @param handler Handler called with the response of the ICL
+   */
+  virtual void request_async(const Command& command,
+                             ResponseHandler handler) = 0;
+
+  /**
+   * @brief Sends a command to the ICL without waiting for the response.
+   *
+   * @param command The command for the ICL
+   *
+   * @return Future of the response from the ICL
+   */
+  std::future<Response> request_async(const Command& command) {
+    auto promise = std::make_shared<std::promise<Response>>();
+    auto future = promise->get_future();
+    this->request_async(command, [promise](std::exception_ptr error,
+                                           Response response) {
+      if (error) {
+        promise->set_exception(error);
+        return;
+      }
+      promise->set_value(std::move(response));
+    });
+    return future;
+  }
+
+  /**
+   * @brief Sends a command to the ICL, completing with a boost::asio
+   * completion token.
+   *
+   * The completion handler is run on the executor associated with the token,
+   * not on the thread that handles the communication. With
+   * boost::asio::use_awaitable the request can be awaited in a coroutine:
+   *
+   *     auto response = co_await communicator.async_request(
+   *         command, boost::asio::use_awaitable);
+   *
+   * Errors, including a closed communicator, are reported to the handler.
+   *
+   * @param command The command for the ICL
+   * @param token The completion token, with the signature
+   * void(std::exception_ptr, Response)
+   *
+   * @return Depends on the completion token
+   */
+  template <typename CompletionToken>
+  auto async_request(const Command& command, CompletionToken&& token) {
+    return boost::asio::async_initiate<CompletionToken,
+                                       void(std::exception_ptr, Response)>(
+        [this](auto handler, const Command& queued_command) {
+          auto work = boost::asio::make_work_guard(handler);
+          // the response handler has to be copyable, asio handlers are not
+          auto shared_handler =
+              std::make_shared<decltype(handler)>(std::move(handler));
+          auto complete = [shared_handler, work](std::exception_ptr error,
+                                                 Response response) {
+            boost::asio::post(
+                work.get_executor(),
+                [shared_handler, error = std::move(error),
+                 response = std::move(response)]() mutable {
+                  (*shared_handler)(std::move(error), std::move(response));
+                });
+          };
+
+          try {
+            this->request_async(queued_command, complete);
+          } catch (...) {
+            complete(std::current_exception(), Response{});
+          }
+        },
+        token, command);
+  }
+
   /**
    * @brief Sends a command to the ICL and returns the response
    *
@@ -37,7 +145,50 @@ class Communicator {
    *
    * @return The response from the ICL
    */
-  virtual Response request_with_response(const Command& command) = 0;
+  virtual Response request_with_response(const Command& command) {
+    // waits on the stack instead of a promise, so that the request does not
+    // allocate
+    struct Waiter {
+      std::mutex mutex;
+      std::condition_variable done_condition;
+      bool done{false};
+      std::exception_ptr error;
+      Response response;
+    } waiter;
+
+    this->request_async(
+        command, [&waiter](std::exception_ptr error, Response response) {
+          // notified under the lock: the waiter lives on the stack of the
+          // waiting thread and is gone as soon as it sees done
+          const std::lock_guard<std::mutex> lock(waiter.mutex);
+          waiter.error = std::move(error);
+          waiter.response = std::move(response);
+          waiter.done = true;
+          waiter.done_condition.notify_one();
+        });
+
+    std::unique_lock<std::mutex> lock(waiter.mutex);
+    waiter.done_condition.wait(lock, [&waiter] { return waiter.done; });
+    if (waiter.error) {
+      std::rethrow_exception(waiter.error);
+    }
+    return std::move(waiter.response);
+  }
+
+  /**
+   * @brief Subscribes to the binary messages of a type sent by the ICL.
+   *
+   * Binary messages are only sent once enabled with the icl_binMode command.
+   * Every subscriber of a type receives the same, shared, message. The
+   * subscription ends when the returned queue is destroyed.
+   *
+   * @param type The type of binary messages to receive
+   * @param capacity Maximum amount of queued messages, 0 for no limit
+   *
+   * @return Queue receiving the binary messages of the type
+   */
+  virtual std::shared_ptr<BinaryMessageQueue> subscribe_binary_messages(
+      BinaryMessageType type, std::size_t capacity = 0) = 0;
 };
 
 }  // namespace horiba::communication
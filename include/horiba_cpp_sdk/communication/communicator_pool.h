@@ -0,0 +1,232 @@
+#ifndef COMMUNICATOR_POOL_H
+#define COMMUNICATOR_POOL_H
+
+#include <horiba_cpp_sdk/communication/communicator.h>
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace horiba::communication {
+
+class Command;
+
+/**
+ * @brief Classes of commands, each sent over its own connections of a
+ * CommunicatorPool.
+ */
+enum class CommandClass : std::uint8_t {
+  // small commands controlling the devices, e.g. mono_isBusy
+  CONTROL = 0,
+  // commands whose response carries acquired data, e.g.
+  // ccd_getAcquisitionData
+  BULK_DATA = 1,
+  // commands that have to reach the ICL without delay, e.g.
+  // ccd_acquisitionAbort
+  PRIORITY = 2,
+};
+
+/**
+ * @brief Decides the class of a command.
+ */
+using CommandClassifier = std::function<CommandClass(const Command& command)>;
+
+/**
+ * @brief Default classifier for the commands of the ICL.
+ *
+ * ccd_getAcquisitionData and saq3_getAvailableData are bulk data commands.
+ * ccd_acquisitionAbort, saq3_acqStop and icl_shutdown are priority commands.
+ * All the other commands are control commands.
+ *
+ * @param command The command to classify
+ *
+ * @return The class of the command
+ */
+CommandClass default_command_classifier(const Command& command);
+
+/**
+ * @brief Amount of connections opened by a CommunicatorPool.
+ */
+struct ConnectionPoolConfig {
+  // connections for the control commands, at least one
+  std::size_t control_connections{1};
+  // connections for the bulk data commands, 0 to send them with the control
+  // commands
+  std::size_t bulk_connections{1};
+  // connections reserved for the priority commands, 0 to send them with the
+  // control commands
+  std::size_t priority_connections{1};
+};
+
+/**
+ * @brief Round trip times of requests, from sending the command to receiving
+ * its response.
+ */
+struct LatencyStatistics {
+  std::size_t count{0};
+  std::chrono::microseconds last{0};
+  std::chrono::microseconds max{0};
+  std::chrono::microseconds total{0};
+
+  /**
+   * @brief Average round trip time.
+   *
+   * @return The average, 0 if there was no request
+   */
+  [[nodiscard]] std::chrono::microseconds mean() const;
+};
+
+/**
+ * @brief Communication channel with the ICL spread over several connections.
+ *
+ * Every command is sent over the connections of its class, so that a large
+ * response, e.g. the data of a CCD acquisition, does not hold back the
+ * control commands sent meanwhile. Within a class, all the commands of a
+ * device, identified by the prefix of the command and its "index" parameter,
+ * go over the same connection so that they keep their order. Devices are
+ * assigned to the connections of a class in turn; commands without device
+ * index, e.g. the icl_ commands, use the first connection of their class.
+ *
+ * Priority commands have connections of their own, which are idle the rest of
+ * the time: they reach the ICL even while a long transfer is in progress on
+ * the other connections. Their round trip times are measured.
+ *
+ * Binary messages are received on the first control connection, which is the
+ * one the icl_binMode command is sent over.
+ */
+class CommunicatorPool : public Communicator {
+ public:
+  /**
+   * @brief Builds a pool of websocket connections to the ICL.
+   *
+   * @param host The host to connect to
+   * @param port The port to connect to
+   * @param config The amount of connections of each class
+   *
+   * @throw std::invalid_argument if there is no control connection
+   */
+  CommunicatorPool(const std::string& host, const std::string& port,
+                   ConnectionPoolConfig config = {});
+
+  /**
+   * @brief Builds a pool of existing connections.
+   *
+   * @param control_connections Connections for the control commands
+   * @param bulk_connections Connections for the bulk data commands, may be
+   * empty
+   * @param priority_connections Connections for the priority commands, may be
+   * empty
+   *
+   * @throw std::invalid_argument if there is no control connection
+   */
+  CommunicatorPool(
+      std::vector<std::shared_ptr<Communicator>> control_connections,
+      std::vector<std::shared_ptr<Communicator>> bulk_connections,
+      std::vector<std::shared_ptr<Communicator>> priority_connections = {});
+
+  /**
+   * @brief Opens all the connections of the pool.
+   *
+   * If a connection cannot be opened, the ones opened by this call are closed
+   * again.
+   *
+   * @throw std::runtime_error if all the connections are already open
+   */
+  void open() override;
+
+  /**
+   * @brief Closes all the open connections of the pool.
+   */
+  void close() override;
+
+  /**
+   * @brief Checks if all the connections of the pool are open.
+   *
+   * @return True if all the connections are open, false otherwise
+   */
+  bool is_open() override;
+
+  using Communicator::request_async;
+
+  /**
+   * @brief Sends a command over the connection of its class and device.
+   *
+   * @param command The command for the ICL
+   * @param handler Handler called with the response of the ICL
+   */
+  void request_async(const Command& command, ResponseHandler handler) override;
+
+  std::shared_ptr<BinaryMessageQueue> subscribe_binary_messages(
+      BinaryMessageType type, std::size_t capacity = 0) override;
+
+  /**
+   * @brief Replaces the classifier deciding the class of the commands.
+   *
+   * @param classifier The new classifier
+   */
+  void set_command_classifier(CommandClassifier classifier);
+
+  /**
+   * @brief Connection a command is sent over.
+   *
+   * @param command The command
+   *
+   * @return The connection used for the command
+   */
+  [[nodiscard]] std::shared_ptr<Communicator> connection_for(
+      const Command& command);
+
+  /**
+   * @brief Total amount of connections of the pool.
+   *
+   * @return The amount of connections
+   */
+  [[nodiscard]] std::size_t connections() const;
+
+  /**
+   * @brief Round trip times of the priority commands sent so far.
+   *
+   * @return The latency statistics of the priority commands
+   */
+  [[nodiscard]] LatencyStatistics priority_latency();
+
+ private:
+  static constexpr std::size_t COMMAND_CLASSES = 3;
+
+  struct DeviceConnections {
+    std::string family;
+    long long int index;
+    // connection of the device in each class
+    std::array<std::size_t, COMMAND_CLASSES> connection;
+  };
+
+  // declared before the connections, which may still answer a priority
+  // command while they are destroyed
+  std::mutex latency_mutex;
+  LatencyStatistics priority_statistics;
+
+  // connections of each class
+  std::array<std::vector<std::shared_ptr<Communicator>>, COMMAND_CLASSES>
+      lanes;
+
+  std::mutex routing_mutex;
+  CommandClassifier command_classifier{default_command_classifier};
+  std::vector<DeviceConnections> devices;
+  std::array<std::size_t, COMMAND_CLASSES> next_connection{};
+
+  CommandClass lane_of(const Command& command);
+  std::shared_ptr<Communicator> connection_in_lane(CommandClass lane,
+                                                   const Command& command);
+  void record_priority_latency(std::chrono::microseconds latency);
+  std::vector<std::shared_ptr<Communicator>> all_connections() const;
+};
+
+} /* namespace horiba::communication */
+
+#endif /* ifndef COMMUNICATOR_POOL_H */
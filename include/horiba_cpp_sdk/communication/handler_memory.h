@@ -0,0 +1,138 @@
+#ifndef HANDLER_MEMORY_H
+#define HANDLER_MEMORY_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace horiba::communication {
+
+/**
+ * @brief Memory block reused by an asynchronous operation that is started
+ * again and again, e.g. reading the next message.
+ *
+ * A few allocations at a time are served from the block, as an operation
+ * dispatched through a strand needs one for the handler and one for the
+ * strand. Further or bigger allocations fall back to the heap.
+ */
+class HandlerMemory {
+ public:
+  HandlerMemory() = default;
+  HandlerMemory(const HandlerMemory&) = delete;
+  HandlerMemory& operator=(const HandlerMemory&) = delete;
+  HandlerMemory(HandlerMemory&&) = delete;
+  HandlerMemory& operator=(HandlerMemory&&) = delete;
+  ~HandlerMemory() = default;
+
+  void* allocate(std::size_t size) {
+    if (size <= SLOT_SIZE) {
+      for (std::size_t slot = 0; slot < SLOTS; slot++) {
+        if (!this->in_use[slot].exchange(true)) {
+          return this->storage[slot].data();
+        }
+      }
+    }
+    return ::operator new(size);
+  }
+
+  void deallocate(void* pointer) {
+    for (std::size_t slot = 0; slot < SLOTS; slot++) {
+      if (pointer == this->storage[slot].data()) {
+        this->in_use[slot].store(false);
+        return;
+      }
+    }
+    ::operator delete(pointer);
+  }
+
+ private:
+  static constexpr std::size_t SLOTS = 2;
+  static constexpr std::size_t SLOT_SIZE = 1024;
+  struct alignas(std::max_align_t) Slot
+      : std::array<unsigned char, SLOT_SIZE> {};
+  std::array<Slot, SLOTS> storage{};
+  std::array<std::atomic<bool>, SLOTS> in_use{};
+};
+
+/**
+ * @brief Allocator handing out the memory of a HandlerMemory, used as the
+ * associated allocator of asynchronous handlers.
+ */
+template <typename T>
+class HandlerAllocator {
+ public:
+  using value_type = T;
+
+  explicit HandlerAllocator(HandlerMemory& memory) noexcept
+      : memory{&memory} {}
+
+  // implicit, allocators are rebound by conversion
+  template <typename U>
+  HandlerAllocator(const HandlerAllocator<U>& other) noexcept
+      : memory{other.memory} {}
+
+  T* allocate(std::size_t count) {
+    return static_cast<T*>(this->memory->allocate(sizeof(T) * count));
+  }
+
+  void deallocate(T* pointer, std::size_t /*count*/) {
+    this->memory->deallocate(pointer);
+  }
+
+  template <typename U>
+  bool operator==(const HandlerAllocator<U>& other) const noexcept {
+    return this->memory == other.memory;
+  }
+
+ private:
+  template <typename U>
+  friend class HandlerAllocator;
+
+  HandlerMemory* memory;
+};
+
+/**
+ * @brief Handler whose operations allocate from a HandlerMemory.
+ */
+template <typename Handler>
+class MemoryBoundHandler {
+ public:
+  using allocator_type = HandlerAllocator<Handler>;
+
+  MemoryBoundHandler(HandlerMemory& memory, Handler handler)
+      : memory{&memory}, handler{std::move(handler)} {}
+
+  [[nodiscard]] allocator_type get_allocator() const noexcept {
+    return allocator_type{*this->memory};
+  }
+
+  template <typename... Args>
+  void operator()(Args&&... args) {
+    this->handler(std::forward<Args>(args)...);
+  }
+
+ private:
+  HandlerMemory* memory;
+  Handler handler;
+};
+
+/**
+ * @brief Binds a handler to the memory its operations allocate from.
+ *
+ * @param memory The memory to allocate from
+ * @param handler The handler to bind
+ *
+ * @return The bound handler
+ */
+template <typename Handler>
+MemoryBoundHandler<std::decay_t<Handler>> bind_handler_memory(
+    HandlerMemory& memory, Handler&& handler) {
+  return {memory, std::forward<Handler>(handler)};
+}
+
+} /* namespace horiba::communication */
+
+#endif /* ifndef HANDLER_MEMORY_H */
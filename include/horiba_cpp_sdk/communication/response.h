@@ -1,17 +1,33 @@
 #ifndef RESPONSE_H
 #define RESPONSE_H
 
+#include <horiba_cpp_sdk/communication/buffer_pool.h>
+
 #include <any>
+#include <cstddef>
+#include <memory>
 #include <nlohmann/json.hpp>
+#include <optional>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace horiba::communication {
 /**
  * @brief Represents a response of the ICL
+ *
+ * A response received from the ICL keeps the raw text it was sent as. Only the
+ * id and the errors are decoded when it is received, the results are decoded
+ * when they are accessed. The raw text is given back to the buffer pool of the
+ * communicator when the response is destroyed.
  */
 class Response {
  public:
+  /**
+   * @brief Builds an empty response, without results nor errors.
+   */
+  Response() = default;
+
   /**
    * @brief Builds a response of the ICL.
    *
@@ -23,9 +39,47 @@ class Response {
   Response(unsigned long long int id, std::string command,
            nlohmann::json::object_t results, std::vector<std::string> errors);
 
+  /**
+   * @brief Builds a response from the raw text sent by the ICL.
+   *
+   * @param raw_response The JSON text of the response
+   * @param pool Pool the raw text is given back to on destruction, if any
+   *
+   * @throw std::invalid_argument if the text is not a valid response
+   */
+  explicit Response(std::string raw_response,
+                    std::weak_ptr<BufferPool> pool = {});
+
+  Response(const Response& other) = default;
+  Response& operator=(const Response& other);
+  Response(Response&& other) noexcept = default;
+  Response& operator=(Response&& other) noexcept;
+  ~Response();
+
+  /**
+   * @brief Reads only the id of a raw response, e.g. to fail the request of
+   * a response that cannot be decoded.
+   *
+   * @param raw_response The JSON text of the response
+   *
+   * @return The id, nothing if the text has none before an invalid part
+   */
+  [[nodiscard]] static std::optional<unsigned long long int> scan_id(
+      std::string_view raw_response) noexcept;
+
+  /**
+   * @brief Id of the command this response belongs to.
+   *
+   * @return The id of the command
+   */
+  [[nodiscard]] unsigned long long int id() const;
+
   /**
    * @brief JSON representation of the "results" field of the response.
    *
+   * The results are decoded on every call, callers keep the returned JSON
+   * instead of calling it again.
+   *
    * @return JSON of response["results"]
    */
   [[nodiscard]] nlohmann::json json_results() const;
@@ -35,13 +89,34 @@ class Response {
    *
    * @return Errors happened during the call to the ICL
    */
-  [[nodiscard]] std::vector<std::string> errors() const;
+  [[nodiscard]] const std::vector<std::string>& errors() const;
+
+  /**
+   * @brief Raw JSON text of the response as sent by the ICL.
+   *
+   * @return The raw text, empty if the response was not received from the ICL
+   */
+  [[nodiscard]] std::string_view raw() const;
+
+  /**
+   * @brief Raw JSON text of the "results" field of the response.
+   *
+   * @return The raw text of the results, empty if the response was not
+   * received from the ICL or has no results
+   */
+  [[nodiscard]] std::string_view raw_results() const;
 
  private:
-  unsigned long long int id;
+  unsigned long long int command_id{0};
   std::string command;
   nlohmann::json::object_t results;
   std::vector<std::string> icl_errors;
+  std::string raw_response;
+  std::size_t results_offset{0};
+  std::size_t results_length{0};
+  std::weak_ptr<BufferPool> pool;
+
+  void release_raw_response();
 };
 } /* namespace horiba::communication */
 #endif /* ifndef RESPONSE_H */
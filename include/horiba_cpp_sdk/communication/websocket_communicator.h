@@ -1,13 +1,27 @@
 #ifndef WEBSOCKET_COMMUNICATOR_H
 #define WEBSOCKET_COMMUNICATOR_H
 
+#include <array>
+#include <atomic>
 #include <boost/asio/connect.hpp>
+#include <boost/asio/io_context.hpp>
 #include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/strand.hpp>
 #include <boost/beast/core.hpp>
 #include <boost/beast/websocket.hpp>
+#include <cstdint>
 #include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
 
+#include "horiba_cpp_sdk/communication/binary_message.h"
+#include "horiba_cpp_sdk/communication/buffer_pool.h"
 #include "horiba_cpp_sdk/communication/communicator.h"
+#include "horiba_cpp_sdk/communication/handler_memory.h"
 
 namespace horiba::communication {
 
@@ -16,6 +30,21 @@ class Response;
 
 /**
  * @brief Represents a communication channel with the ICL using a websocket.
+ *
+ * Once opened, a background thread writes the queued commands back-to-back and
+ * reads the incoming frames. Text frames are JSON responses and are dispatched
+ * to the pending requests by their id, so they can arrive in any order. Binary
+ * frames are classified and handed to the subscribers of their type.
+ *
+ * Once warmed up, sending a command and receiving its response does not
+ * allocate: the message buffers are pooled and the asynchronous operations
+ * reuse their memory.
+ *
+ * The communicator is thread-safe: it is shared by all the devices of an ICL
+ * and any number of threads can send commands at the same time. The calling
+ * threads only queue their command, all the operations on the websocket are
+ * serialized on a strand and the responses are routed back by id, so no lock
+ * is held while waiting for the ICL.
  */
 class WebSocketCommunicator : public Communicator {
  public:
@@ -28,7 +57,15 @@ class WebSocketCommunicator : public Communicator {
    */
   WebSocketCommunicator(std::string host, std::string port);
 
-  ~WebSocketCommunicator() override = default;
+  WebSocketCommunicator(const WebSocketCommunicator&) = delete;
+  WebSocketCommunicator& operator=(const WebSocketCommunicator&) = delete;
+  WebSocketCommunicator(WebSocketCommunicator&&) = delete;
+  WebSocketCommunicator& operator=(WebSocketCommunicator&&) = delete;
+
+  /**
+   * @brief Closes the communication channel if it is still open.
+   */
+  ~WebSocketCommunicator() override;
 
   /**
    * @brief Opens the communication channel with the ICL
@@ -37,6 +74,8 @@ class WebSocketCommunicator : public Communicator {
 
   /**
    * @brief Closes the communication channel with the ICL
+   *
+   * Pending requests are failed with an exception.
    */
   void close() override;
   /**
@@ -46,21 +85,96 @@ class WebSocketCommunicator : public Communicator {
    */
   bool is_open() override;
 
+  using Communicator::request_async;
+
   /**
-   * @brief Sends a command to the ICL and returns the response
+   * @brief Queues a command for the ICL without waiting for the response.
    *
    * @param command The command for the ICL
+   * @param handler Handler called with the response of the ICL, from the
+   * communication thread
    *
-   * @return The response from the ICL
+   * @throw std::runtime_error if the websocket is not open
+   * @throw std::invalid_argument if a request with the same command id is
+   * already pending
    */
-  Response request_with_response(const Command& command) override;
+  void request_async(const Command& command, ResponseHandler handler) override;
+
+  /**
+   * @brief Number of requests that have been sent and still wait for their
+   * response.
+   *
+   * @return The number of pending requests
+   */
+  [[nodiscard]] std::size_t pending_requests();
+
+  std::shared_ptr<BinaryMessageQueue> subscribe_binary_messages(
+      BinaryMessageType type, std::size_t capacity = 0) override;
+
+  /**
+   * @brief Replaces the classifier deciding the type of the binary messages.
+   *
+   * @param classifier The new classifier
+   */
+  void set_binary_message_classifier(BinaryMessageClassifier classifier);
 
  private:
   std::string host;
   std::string port;
   boost::asio::io_context context;
+  // serializes every operation on the websocket
+  boost::asio::strand<boost::asio::io_context::executor_type> strand{
+      boost::asio::make_strand(context)};
   boost::beast::websocket::stream<boost::asio::ip::tcp::socket> websocket{
       context};
+  // serializes open() and close()
+  std::mutex lifecycle_mutex;
+  std::thread io_thread;
+  std::atomic<bool> connected{false};
+  // incremented on every open() to recognize work queued for old connections
+  std::uint64_t generation{0};
+
+  using PendingRequests =
+      std::unordered_map<unsigned long long int, ResponseHandler>;
+  std::mutex pending_mutex;
+  PendingRequests pending;
+  // nodes of answered requests, reused for new requests to avoid allocations
+  std::vector<PendingRequests::node_type> free_pending_nodes;
+
+  // buffers of the sent commands and of the received responses
+  std::shared_ptr<BufferPool> buffer_pool{std::make_shared<BufferPool>()};
+
+  std::mutex write_mutex;
+  std::vector<std::string> outgoing_messages;
+  // whether the strand has been told to send the outgoing messages
+  bool write_scheduled{false};
+
+  static constexpr std::size_t BINARY_MESSAGE_TYPES = 4;
+  std::mutex subscribers_mutex;
+  BinaryMessageClassifier binary_message_classifier{
+      default_binary_message_classifier};
+  std::array<std::vector<std::weak_ptr<BinaryMessageQueue>>,
+             BINARY_MESSAGE_TYPES>
+      subscribers;
+
+  // only accessed on the strand
+  std::vector<std::string> writing_messages;
+  std::size_t write_position{0};
+  bool write_in_progress{false};
+  boost::beast::flat_buffer read_buffer;
+
+  HandlerMemory wake_handler_memory;
+  HandlerMemory write_handler_memory;
+  HandlerMemory read_handler_memory;
+
+  void schedule_write(std::string message);
+  void do_write();
+  void reset_writes();
+  void do_read();
+  void on_read(boost::beast::error_code error);
+  void dispatch_response(std::string raw_response);
+  void dispatch_binary_message();
+  void fail_pending_requests(const std::string& reason);
 };
 } /* namespace horiba::communication */
 
@@ -10,6 +10,11 @@ namespace horiba::core::stitching {
 
 class AverageSpectraStitch : public SpectraStitch {
  public:
+  /**
+   * @brief Overlap in pixels two spectra need to have a point to average.
+   */
+  static constexpr double MINIMUM_OVERLAP_PIXELS = 1.0;
+
   explicit AverageSpectraStitch(
       const std::vector<std::vector<std::vector<double>>>& spectra_list);
 
@@ -11,6 +11,11 @@ namespace horiba::core::stitching {
 
 class SimpleSpectraStitch : public SpectraStitch {
  public:
+  /**
+   * @brief Overlap in pixels two spectra need to leave no gap between them.
+   */
+  static constexpr double MINIMUM_OVERLAP_PIXELS = 1.0;
+
   explicit SimpleSpectraStitch(
       const std::vector<std::vector<std::vector<double>>>& spectra_list);
 
@@ -10,6 +10,12 @@ namespace horiba::core::stitching {
 
 class WeightAverageSpectraStitch : public SpectraStitch {
  public:
+  /**
+   * @brief Overlap in pixels two spectra need, the weights run between the
+   * bounds of the overlap.
+   */
+  static constexpr double MINIMUM_OVERLAP_PIXELS = 2.0;
+
   explicit WeightAverageSpectraStitch(
       const std::vector<std::vector<std::vector<double>>>& spectra_list);
 
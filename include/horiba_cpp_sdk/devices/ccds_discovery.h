@@ -39,9 +39,17 @@ class ChargeCoupledDevicesDiscovery : public DeviceDiscovery {
   std::vector<std::shared_ptr<single_devices::ChargeCoupledDevice>>
   charge_coupled_devices() const;
 
+  /**
+   * @brief The "devices" list returned by the ICL during the discovery.
+   *
+   * @return The listed devices
+   */
+  [[nodiscard]] nlohmann::json devices_list() const;
+
  private:
   std::shared_ptr<horiba::communication::Communicator> communicator;
   std::vector<std::shared_ptr<single_devices::ChargeCoupledDevice>> ccds;
+  nlohmann::json listed_devices = nlohmann::json::array();
 
   std::vector<std::shared_ptr<single_devices::ChargeCoupledDevice>> parse_ccds(
       nlohmann::json raw_ccds);
@@ -0,0 +1,74 @@
+#ifndef DISCOVERY_CACHE_H
+#define DISCOVERY_CACHE_H
+
+#include <filesystem>
+#include <map>
+#include <nlohmann/json.hpp>
+#include <optional>
+#include <string>
+
+namespace horiba::devices {
+
+/**
+ * @brief Devices discovered on the ICL and their configuration, kept in a
+ * file so that a restart does not have to discover them again.
+ *
+ * The device lists are the "devices" lists of ccd_list, mono_list and
+ * saq3_list. A cache is only valid as long as the ICL lists the same serial
+ * numbers at the same indices, see same_devices().
+ */
+struct DiscoveryCache {
+  static constexpr int VERSION = 1;
+
+  nlohmann::json charge_coupled_devices = nlohmann::json::array();
+  nlohmann::json monochromators = nlohmann::json::array();
+  nlohmann::json spectracq3s = nlohmann::json::array();
+  // configuration of the devices, by serial number
+  std::map<std::string, nlohmann::json> configurations;
+
+  /**
+   * @brief Reads a cache file.
+   *
+   * @param file The cache file
+   *
+   * @return The cache, nothing if the file does not exist, is not readable or
+   * was written by another version
+   */
+  static std::optional<DiscoveryCache> load(const std::filesystem::path& file);
+
+  /**
+   * @brief Writes the cache file. The file is replaced at once, so that a
+   * crash while writing does not leave a broken cache behind.
+   *
+   * @param file The cache file
+   *
+   * @throw std::runtime_error when the file cannot be written
+   */
+  void save(const std::filesystem::path& file) const noexcept(false);
+
+  /**
+   * @brief Whether both device lists have the same serial numbers at the same
+   * indices.
+   *
+   * @param cached The cached "devices" list
+   * @param listed The "devices" list currently returned by the ICL
+   *
+   * @return True if the lists describe the same devices
+   */
+  static bool same_devices(const nlohmann::json& cached,
+                           const nlohmann::json& listed);
+
+  /**
+   * @brief Serial number of a device of a "devices" list, with the padding
+   * some devices add removed.
+   *
+   * @param device The device of the list
+   *
+   * @return The serial number, empty if the device has none
+   */
+  static std::string serial_number(const nlohmann::json& device);
+};
+
+} /* namespace horiba::devices */
+
+#endif /* ifndef DISCOVERY_CACHE_H */
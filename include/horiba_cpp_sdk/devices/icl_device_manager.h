@@ -2,9 +2,19 @@
 #define ICL_DEVICE_MANAGER_H
 
 #include <horiba_cpp_sdk/communication/communicator.h>
+#include <horiba_cpp_sdk/communication/communicator_pool.h>
 #include <horiba_cpp_sdk/devices/device_manager.h>
+#include <horiba_cpp_sdk/devices/discovery_cache.h>
 #include <horiba_cpp_sdk/os/process.h>
 
+#include <chrono>
+#include <cstddef>
+#include <filesystem>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <nlohmann/json.hpp>
 #include <string>
 
 #include "horiba_cpp_sdk/devices/single_devices/spectracq3.h"
@@ -15,6 +25,44 @@ class Communicator;
 
 namespace horiba::devices {
 
+/**
+ * @brief How long and how often the ICL is probed until it answers, when
+ * starting the device manager.
+ */
+struct ReadinessConfig {
+  // wait before the first retry, doubled after every failed attempt
+  std::chrono::milliseconds initial_backoff{20};
+  std::chrono::milliseconds max_backoff{1000};
+  // time the ICL has to answer, starting its process included
+  std::chrono::milliseconds deadline{30000};
+};
+
+/**
+ * @brief Where the time went while starting the device manager.
+ */
+struct StartupTiming {
+  std::chrono::microseconds process_start{0};
+  // connecting to the ICL, failed attempts and their backoff included
+  std::chrono::microseconds connect{0};
+  // until the ICL answered icl_info
+  std::chrono::microseconds probe{0};
+  std::chrono::microseconds binary_mode{0};
+  std::chrono::microseconds discovery{0};
+  std::chrono::microseconds total{0};
+  std::size_t attempts{0};
+};
+
+/**
+ * @brief Time the discovery of each device family took.
+ */
+struct DiscoveryTiming {
+  std::chrono::microseconds charge_coupled_devices{0};
+  std::chrono::microseconds monochromators{0};
+  std::chrono::microseconds spectracq3s{0};
+  // the families are discovered concurrently, so about the slowest of them
+  std::chrono::microseconds total{0};
+};
+
 /**
  * @brief Device Manager using the ICL to communicate with connected Horiba
  * devices
@@ -31,18 +79,61 @@ class ICLDeviceManager final : public DeviceManager {
    * @param manage_icl_lifetime Whether to start and stop the icl.exe
    * @param enable_binary_messages Whether to enable or not binary messages
    * comming from the ICL
+   * @param connection_pool The connections opened to the ICL. By default the
+   * bulk data of the devices is transferred over its own connection, so that
+   * it does not delay the control commands, and the abort and stop commands
+   * have a connection of their own.
+   * @param readiness How the ICL is probed until it answers on start()
+   * @param discovery_cache_file File keeping the discovered devices between
+   * restarts, see DiscoveryCache. No cache is kept if empty.
+   */
+  explicit ICLDeviceManager(
+      std::shared_ptr<horiba::os::Process> icl_process,
+      std::string websocket_ip = "127.0.0.1",
+      std::string websocket_port = "25010", bool manage_icl_lifetime = true,
+      bool enable_binary_messages = false,
+      horiba::communication::ConnectionPoolConfig connection_pool = {},
+      ReadinessConfig readiness = {},
+      std::filesystem::path discovery_cache_file = {});
+
+  /**
+   * @brief Creates a device manager that talks to the ICL over the given
+   * connections, e.g. connections answering without an ICL in tests.
+   *
+   * @param icl_process The process representing the icl.exe
+   * @param communicator The connections to the ICL
+   * @param manage_icl_lifetime Whether to start and stop the icl.exe
+   * @param enable_binary_messages Whether to enable or not binary messages
+   * comming from the ICL
+   * @param readiness How the ICL is probed until it answers on start()
+   * @param discovery_cache_file File keeping the discovered devices between
+   * restarts, see DiscoveryCache. No cache is kept if empty.
+   *
+   * @throw std::invalid_argument if the communicator is null
    */
-  explicit ICLDeviceManager(std::shared_ptr<horiba::os::Process> icl_process,
-                            std::string websocket_ip = "127.0.0.1",
-                            std::string websocket_port = "25010",
-                            bool manage_icl_lifetime = true,
-                            bool enable_binary_messages = false);
+  ICLDeviceManager(
+      std::shared_ptr<horiba::os::Process> icl_process,
+      std::shared_ptr<horiba::communication::CommunicatorPool> communicator,
+      bool manage_icl_lifetime = true, bool enable_binary_messages = false,
+      ReadinessConfig readiness = {},
+      std::filesystem::path discovery_cache_file = {});
 
   /**
    * @brief Starts the ICL device manager. Also starts the icl.exe if managing
    * its lifecycle.
+   *
+   * Instead of waiting a fixed time for the ICL, it connects and sends
+   * icl_info until the ICL answers, backing off exponentially between the
+   * attempts. An ICL that is already running is ready within milliseconds.
+   *
+   * With a discovery cache, the devices of the cache are used right away and
+   * checked against the ICL in the background, see wait_for_cache_check().
+   * They are kept even if the check fails, the devices are only replaced by
+   * discover_devices().
+   *
+   * @throw std::runtime_error when the ICL did not answer before the deadline
    */
-  void start() override;
+  void start() noexcept(false) override;
 
   /**
    * @brief Stops the ICL device manager. Also stops the icl.exe if managing its
@@ -53,6 +144,9 @@ class ICLDeviceManager final : public DeviceManager {
   /**
    * @brief Discovers connected Horiba devices to the ICL
    *
+   * The CCDs, monochromators and SpectrAcq3s are discovered concurrently,
+   * their requests are in flight at the same time.
+   *
    * @param error_on_no_device Whether to throw an exception if no devices have
    * been found.
    */
@@ -85,13 +179,80 @@ class ICLDeviceManager final : public DeviceManager {
       std::shared_ptr<horiba::devices::single_devices::SpectrAcq3>>
   spectracq3_devices() const override;
 
+  /**
+   * @brief Subscribes to the binary messages of a type sent by the ICL. They
+   * are only sent if binary messages have been enabled.
+   *
+   * @param type The type of binary messages to receive
+   * @param capacity Maximum amount of queued messages, 0 for no limit
+   *
+   * @return Queue receiving the binary messages of the type
+   */
+  [[nodiscard]] std::shared_ptr<horiba::communication::BinaryMessageQueue>
+  subscribe_binary_messages(horiba::communication::BinaryMessageType type,
+                            std::size_t capacity = 0);
+
+  /**
+   * @brief Round trip times of the priority commands, e.g. aborting a CCD
+   * acquisition, sent to the ICL so far.
+   *
+   * @return The latency statistics of the priority commands
+   */
+  [[nodiscard]] horiba::communication::LatencyStatistics priority_latency();
+
+  /**
+   * @brief Time spent in each step of the last start().
+   *
+   * @return The timing of the last start
+   */
+  [[nodiscard]] StartupTiming startup_timing() const;
+
+  /**
+   * @brief Time spent discovering each device family in the last
+   * discover_devices().
+   *
+   * @return The timing of the last discovery
+   */
+  [[nodiscard]] DiscoveryTiming discovery_timing() const;
+
+  /**
+   * @brief Waits until the devices taken from the discovery cache by start()
+   * have been checked against the ICL.
+   *
+   * The devices are never replaced by the check. If the ICL lists other
+   * devices, call discover_devices() to use them.
+   *
+   * @return True if the ICL lists the cached devices, false if it lists other
+   * devices or the devices were not taken from the cache
+   *
+   * @throw std::runtime_error when the ICL could not be asked for its devices
+   */
+  bool wait_for_cache_check() noexcept(false);
+
+  /**
+   * @brief Writes the discovered devices, and the configurations the devices
+   * fetched or were preloaded with, to the discovery cache file. The
+   * configurations already in the file are kept, so that devices opened on an
+   * earlier run need no round trip either. Done after every discovery and
+   * when stopping.
+   *
+   * @throw std::runtime_error when the file cannot be written
+   */
+  void save_discovery_cache() noexcept(false);
+
  private:
   std::shared_ptr<horiba::os::Process> icl_process;
   std::string websocket_ip;
   std::string websocket_port;
   bool manage_icl_lifetime;
   bool enable_binary_messages;
-  std::shared_ptr<horiba::communication::Communicator> communicator;
+  ReadinessConfig readiness;
+  StartupTiming last_startup;
+  DiscoveryTiming last_discovery;
+  std::filesystem::path discovery_cache_file;
+  std::shared_ptr<horiba::communication::CommunicatorPool> communicator;
+  // the devices are read while discover_devices() may replace them
+  mutable std::mutex devices_mutex;
   std::vector<std::shared_ptr<horiba::devices::single_devices::Monochromator>>
       monos;
   std::vector<
@@ -99,8 +260,24 @@ class ICLDeviceManager final : public DeviceManager {
       ccds;
   std::vector<std::shared_ptr<horiba::devices::single_devices::SpectrAcq3>>
       spectracq3s;
+  DiscoveryCache discovered;
+  // configurations fetched by the devices since they were created, shared
+  // with them as they may outlive the manager
+  struct FetchedConfigurations {
+    std::mutex mutex;
+    std::map<std::string, nlohmann::json> by_serial_number;
+  };
+  std::shared_ptr<FetchedConfigurations> fetched_configurations{
+      std::make_shared<FetchedConfigurations>()};
+  // last member, its destructor waits for the check that uses the others
+  std::shared_future<bool> cache_check;
 
   void enable_binary_messages_on_icl();
+  void await_icl_ready(std::chrono::steady_clock::time_point deadline,
+                       StartupTiming& timing);
+  bool restore_devices_from_cache();
+  void record_fetched_configurations();
+  bool check_cached_devices(const DiscoveryCache& cache);
 };
 } /* namespace horiba::devices */
 
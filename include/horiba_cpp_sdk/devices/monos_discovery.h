@@ -40,9 +40,17 @@ class MonochromatorsDiscovery : public DeviceDiscovery {
   [[nodiscard]] std::vector<std::shared_ptr<single_devices::Monochromator>>
   monochromators() const;
 
+  /**
+   * @brief The "devices" list returned by the ICL during the discovery.
+   *
+   * @return The listed devices
+   */
+  [[nodiscard]] nlohmann::json devices_list() const;
+
  private:
   std::shared_ptr<horiba::communication::Communicator> communicator;
   std::vector<std::shared_ptr<single_devices::Monochromator>> monos;
+  nlohmann::json listed_devices = nlohmann::json::array();
 
   std::vector<std::shared_ptr<single_devices::Monochromator>> parse_monos(
       const nlohmann::json& raw_monos_list);
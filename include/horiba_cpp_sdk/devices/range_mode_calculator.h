@@ -0,0 +1,141 @@
+#ifndef RANGE_MODE_CALCULATOR_H
+#define RANGE_MODE_CALCULATOR_H
+
+#include <horiba_cpp_sdk/devices/single_devices/ccd.h>
+#include <horiba_cpp_sdk/devices/single_devices/mono.h>
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace horiba::devices {
+
+/**
+ * @brief Optical layout of a spectrograph that is not part of the
+ * configuration of the monochromator.
+ */
+struct SpectrographGeometry {
+  double focal_length_mm{0.0};
+  /**
+   * @brief Angle between the incident and the diffracted beam in degrees.
+   */
+  double included_angle_deg{0.0};
+  double pixel_width_um{0.0};
+  int diffraction_order{1};
+};
+
+/**
+ * @brief Computes the center wavelengths of a range mode scan locally, like
+ * ChargeCoupledDevice::range_mode_center_wavelenghts() does on the ICL,
+ * without a round trip.
+ *
+ * The wavelength of each pixel follows from the grating equation of a
+ * Czerny-Turner spectrograph, pixels are counted from the short wavelength
+ * edge of the chip. The segments are placed as far apart as the overlap
+ * allows, so a range is covered with the smallest number of segments.
+ */
+class RangeModeCalculator {
+ public:
+  /**
+   * @param groove_density Grooves per mm of the grating
+   * @param chip_width Width of the CCD chip in pixels
+   * @param geometry Layout of the spectrograph
+   *
+   * @throw std::invalid_argument if a value is not positive or the included
+   * angle is not below 180 degrees
+   */
+  RangeModeCalculator(double groove_density, int chip_width,
+                      SpectrographGeometry geometry) noexcept(false);
+
+  /**
+   * @brief Takes the groove density of a grating from the capabilities of the
+   * monochromator and the chip width from the capabilities of the CCD.
+   *
+   * @param ccd The opened CCD
+   * @param mono The opened monochromator
+   * @param grating The grating used for the scan
+   * @param geometry Layout of the spectrograph
+   *
+   * @return The calculator
+   *
+   * @throw std::invalid_argument if the grating is not installed
+   */
+  static RangeModeCalculator from_devices(
+      single_devices::ChargeCoupledDevice& ccd,
+      single_devices::Monochromator& mono,
+      single_devices::Monochromator::Grating grating,
+      SpectrographGeometry geometry) noexcept(false);
+
+  /**
+   * @brief Wavelength seen by a pixel.
+   *
+   * @param center_wavelength Center wavelength of the monochromator in nm
+   * @param pixel Pixel, fractions are interpolated
+   *
+   * @return The wavelength in nm
+   *
+   * @throw std::invalid_argument if the grating cannot reach the wavelength
+   */
+  [[nodiscard]] double wavelength_at_pixel(double center_wavelength,
+                                           double pixel) const noexcept(false);
+
+  /**
+   * @brief Wavelengths at the edges of the chip.
+   *
+   * @param center_wavelength Center wavelength of the monochromator in nm
+   *
+   * @return The shortest and the longest wavelength in nm
+   *
+   * @throw std::invalid_argument if the grating cannot reach the wavelength
+   */
+  [[nodiscard]] std::pair<double, double> coverage(
+      double center_wavelength) const noexcept(false);
+
+  /**
+   * @brief Center wavelengths of the fewest segments covering a range, two
+   * consecutive segments sharing at least the given overlap.
+   *
+   * @param start_wavelength Start of the range in nm
+   * @param end_wavelength End of the range in nm
+   * @param minimum_overlap_pixels Overlap of two segments in pixels
+   *
+   * @return The center wavelengths in nm, in increasing order
+   *
+   * @throw std::invalid_argument if the range is empty, the overlap does not
+   * fit on the chip or the grating cannot reach the range
+   */
+  [[nodiscard]] std::vector<double> center_wavelengths(
+      double start_wavelength, double end_wavelength,
+      double minimum_overlap_pixels) const noexcept(false);
+
+  /**
+   * @brief Center wavelengths of the fewest segments covering a range with
+   * the overlap a stitching strategy needs.
+   *
+   * @tparam Stitch The SpectraStitch the segments are stitched with
+   */
+  template <typename Stitch>
+  [[nodiscard]] std::vector<double> center_wavelengths(
+      double start_wavelength, double end_wavelength) const noexcept(false) {
+    return this->center_wavelengths(start_wavelength, end_wavelength,
+                                     Stitch::MINIMUM_OVERLAP_PIXELS);
+  }
+
+ private:
+  // segments placed before giving up on a range
+  static constexpr std::size_t MAX_SEGMENTS = 10000;
+
+  // grating period in nm
+  double groove_spacing;
+  int chip_width;
+  SpectrographGeometry geometry;
+  // half the included angle in radians
+  double half_angle;
+
+  [[nodiscard]] double center_for_pixel(double pixel,
+                                        double wavelength) const;
+};
+
+} /* namespace horiba::devices */
+
+#endif /* ifndef RANGE_MODE_CALCULATOR_H */
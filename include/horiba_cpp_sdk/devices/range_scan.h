@@ -0,0 +1,144 @@
+#ifndef RANGE_SCAN_H
+#define RANGE_SCAN_H
+
+#include <horiba_cpp_sdk/communication/response.h>
+#include <horiba_cpp_sdk/devices/single_devices/ccd.h>
+#include <horiba_cpp_sdk/devices/single_devices/mono.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace horiba::devices {
+
+/**
+ * @brief Acquires a wavelength range larger than the CCD chip in segments,
+ * moving the monochromator to the center wavelength of each segment, and
+ * stitches the segments into one spectrum.
+ *
+ * As soon as the acquisition of a segment is done, the monochromator starts
+ * moving to the next segment while the data of the segment is fetched. The
+ * data is decoded and stitched on a worker thread while the next segments
+ * are acquired, so the scan time approaches the sum of the exposure and move
+ * times.
+ *
+ * The CCD and the monochromator have to be opened and set up before the scan,
+ * like for ChargeCoupledDevice::range_mode_center_wavelenghts().
+ */
+class RangeScan {
+ public:
+  struct Options {
+    double start_wavelength{0.0};
+    double end_wavelength{0.0};
+    /**
+     * @brief Overlap of two consecutive segments in pixels.
+     */
+    double pixel_overlap{0.0};
+    bool open_shutter{true};
+    /**
+     * @brief Maximum time to wait for the monochromator to reach a segment.
+     */
+    std::chrono::seconds move_timeout{std::chrono::seconds(180)};
+    /**
+     * @brief Maximum time to wait for the acquisition of a segment.
+     */
+    std::chrono::milliseconds acquisition_timeout{std::chrono::seconds(60)};
+  };
+
+  /**
+   * @brief Durations of the steps of a segment. The move and the exposure
+   * are on the critical path of the scan, the transfer overlaps the move to
+   * the next segment, the decoding and stitching overlap the next segments.
+   */
+  struct SegmentTiming {
+    double center_wavelength{0.0};
+    /**
+     * @brief From the order to move until the monochromator is ready.
+     */
+    std::chrono::microseconds move{0};
+    /**
+     * @brief From the start of the acquisition until it is done.
+     */
+    std::chrono::microseconds exposure{0};
+    std::chrono::microseconds transfer{0};
+    std::chrono::microseconds decode{0};
+    std::chrono::microseconds stitch{0};
+  };
+
+  struct Result {
+    /**
+     * @brief Stitched spectrum, x data followed by y data.
+     */
+    std::vector<std::vector<double>> spectrum;
+    /**
+     * @brief Spectrum of each segment, x data followed by y data, in the
+     * order of acquisition.
+     */
+    std::vector<std::vector<std::vector<double>>> segments;
+    std::vector<SegmentTiming> timings;
+    std::chrono::microseconds duration{0};
+  };
+
+  /**
+   * @param ccd The opened and set up CCD
+   * @param mono The opened monochromator in front of the CCD
+   * @param options Options of the scan
+   *
+   * @throw std::invalid_argument if a device is null or the range is empty
+   */
+  RangeScan(std::shared_ptr<single_devices::ChargeCoupledDevice> ccd,
+            std::shared_ptr<single_devices::Monochromator> mono,
+            Options options) noexcept(false);
+
+  /**
+   * @brief Scans the range, with center wavelengths found by
+   * ChargeCoupledDevice::range_mode_center_wavelenghts().
+   *
+   * @return The stitched spectrum and the timings of the segments
+   *
+   * @throw std::exception the first error of a device or of the decoding
+   */
+  Result run() noexcept(false);
+
+  /**
+   * @brief Scans the given center wavelengths.
+   *
+   * @param center_wavelengths Center wavelengths of the segments in nm
+   *
+   * @return The stitched spectrum and the timings of the segments
+   *
+   * @throw std::invalid_argument if no center wavelength is given
+   * @throw std::exception the first error of a device or of the decoding
+   */
+  Result run(const std::vector<double>& center_wavelengths) noexcept(false);
+
+ private:
+  struct FetchedSegment {
+    std::size_t index{0};
+    communication::Response response;
+  };
+
+  std::shared_ptr<single_devices::ChargeCoupledDevice> ccd;
+  std::shared_ptr<single_devices::Monochromator> mono;
+  Options options;
+
+  std::mutex mutex;
+  std::condition_variable changed;
+  std::deque<FetchedSegment> fetched;
+  bool acquiring_done{false};
+  bool stopping{false};
+  std::exception_ptr error;
+
+  void acquire(const std::vector<double>& center_wavelengths, Result& result);
+  void process(Result& result);
+  void fail(std::exception_ptr failure);
+};
+
+} /* namespace horiba::devices */
+
+#endif /* ifndef RANGE_SCAN_H */
@@ -0,0 +1,177 @@
+#ifndef RECIPE_EXECUTOR_H
+#define RECIPE_EXECUTOR_H
+
+#include <horiba_cpp_sdk/devices/single_devices/device.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace horiba::devices {
+
+/**
+ * @brief Experiment protocol made of steps on Monochromator,
+ * ChargeCoupledDevice and SpectrAcq3 devices.
+ *
+ * A step declares the devices it uses and the steps whose data or effect it
+ * needs. Steps using the same device are executed in the order they were
+ * added, any other order is left to the RecipeExecutor. Loops are written as
+ * C++ loops adding steps:
+ *
+ * @code
+ * Recipe recipe;
+ * const auto dark = recipe.add({"dark frame", {ccd}, [&] { ... }});
+ * const auto lamp = recipe.add({"calibration lamp", {saq3}, [&] { ... }});
+ * for (const auto wavelength : wavelengths) {
+ *   const auto move = recipe.add({"move", {mono}, [&, wavelength] { ... }});
+ *   recipe.add({"acquire", {ccd}, [&] { ... }, {move, lamp}});
+ * }
+ * @endcode
+ *
+ * Here the dark frame is acquired while the lamp is set up and the
+ * monochromator moves to the first wavelength.
+ */
+class Recipe {
+ public:
+  using StepId = std::size_t;
+
+  struct Step {
+    /**
+     * @brief Creates a step, without dependencies unless given.
+     */
+    Step(std::string step_name,
+         std::vector<std::shared_ptr<single_devices::Device>> used_devices,
+         std::function<void()> step_operation,
+         std::vector<StepId> dependencies = {});
+
+    std::string name;
+    /**
+     * @brief Devices used by the step, none for steps only processing data.
+     */
+    std::vector<std::shared_ptr<single_devices::Device>> devices;
+    std::function<void()> operation;
+    /**
+     * @brief Steps that have to be done before this step starts.
+     */
+    std::vector<StepId> after;
+  };
+
+  /**
+   * @brief Adds a step. A device listed more than once by the step is used
+   * once.
+   *
+   * @param step The step
+   *
+   * @return Id of the step, to be used in the dependencies of later steps
+   *
+   * @throw std::invalid_argument if the step has no operation, uses a null
+   * device or depends on a step not added yet
+   */
+  StepId add(Step step) noexcept(false);
+
+  [[nodiscard]] const std::vector<Step>& steps() const;
+
+  /**
+   * @brief Compiles the steps into a dependency graph: the declared
+   * dependencies of each step plus the previous step on each of its devices.
+   * Steps only depend on steps added before them.
+   *
+   * @return The steps each step waits for, by step id
+   */
+  [[nodiscard]] std::vector<std::vector<StepId>> dependencies() const;
+
+ private:
+  std::vector<Step> recipe_steps;
+};
+
+/**
+ * @brief Executes a Recipe, running steps on different devices concurrently
+ * as soon as the steps they depend on are done.
+ */
+class RecipeExecutor {
+ public:
+  struct StepTiming {
+    std::string name;
+    /**
+     * @brief Times since the start of the recipe.
+     */
+    std::chrono::microseconds start{0};
+    std::chrono::microseconds end{0};
+  };
+
+  struct DeviceUsage {
+    std::shared_ptr<single_devices::Device> device;
+    /**
+     * @brief Time the device spent in steps.
+     */
+    std::chrono::microseconds busy{0};
+    /**
+     * @brief Time of the recipe the device was not used.
+     */
+    std::chrono::microseconds idle{0};
+  };
+
+  struct Report {
+    /**
+     * @brief Timing of each step, by step id.
+     */
+    std::vector<StepTiming> steps;
+    /**
+     * @brief The chain of dependent steps that took the longest, in order of
+     * execution. Shortening any other step does not shorten the recipe.
+     */
+    std::vector<Recipe::StepId> critical_path;
+    std::chrono::microseconds critical_path_duration{0};
+    /**
+     * @brief Usage of each device, in the order of first use in the recipe.
+     */
+    std::vector<DeviceUsage> devices;
+    std::chrono::microseconds duration{0};
+  };
+
+  /**
+   * @param workers Maximum amount of steps running at the same time, 0 to
+   * run as many as the recipe allows
+   */
+  explicit RecipeExecutor(std::size_t workers = 0);
+
+  /**
+   * @brief Executes the steps of a recipe. When a step fails, no other step
+   * is started and the steps still running are awaited.
+   *
+   * @param recipe The recipe
+   *
+   * @return The timings of the execution
+   *
+   * @throw The exception of the first step that failed
+   */
+  Report run(const Recipe& recipe) noexcept(false);
+
+ private:
+  std::size_t max_workers;
+
+  std::mutex mutex;
+  std::condition_variable changed;
+  std::deque<Recipe::StepId> ready;
+  std::vector<std::size_t> waiting_for;
+  std::vector<std::vector<Recipe::StepId>> dependents;
+  std::size_t remaining{0};
+  std::exception_ptr error;
+
+  void work(const Recipe& recipe,
+            std::chrono::steady_clock::time_point started, Report& report);
+  static void analyse(const Recipe& recipe,
+                      const std::vector<std::vector<Recipe::StepId>>& graph,
+                      Report& report);
+};
+
+} /* namespace horiba::devices */
+
+#endif /* ifndef RECIPE_EXECUTOR_H */
@@ -0,0 +1,201 @@
+#ifndef SCAN_PLANNER_H
+#define SCAN_PLANNER_H
+
+#include <horiba_cpp_sdk/devices/single_devices/mono.h>
+#include <horiba_cpp_sdk/devices/single_devices/wait_strategy.h>
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace horiba::devices {
+
+/**
+ * @brief Expected durations of the mechanical moves of a monochromator.
+ *
+ * The duration of a move of an axis is fitted linearly to its travel from the
+ * measured moves of that axis, like PredictiveWait does for the waits of a
+ * device. Until an axis has a measured move, its prior is used. A model can
+ * be shared by threads, e.g. planners running scans on several
+ * monochromators.
+ */
+class MoveCostModel {
+ public:
+  enum class Axis : std::size_t {
+    GRATING,
+    WAVELENGTH,
+    MIRROR,
+    SLIT,
+    FILTER_WHEEL,
+  };
+
+  /**
+   * @brief Duration of a move before any move of the axis is measured.
+   */
+  struct Prior {
+    std::chrono::microseconds fixed{0};
+    /**
+     * @brief Duration per unit of travel: per grating position, nm, mirror
+     * move, mm or filter position.
+     */
+    std::chrono::microseconds per_unit{0};
+    /**
+     * @brief Travel assumed for a move whose start is unknown.
+     */
+    double unknown_start_travel{0.0};
+  };
+
+  /**
+   * @brief Uses rough priors: grating changes take seconds, wavelength moves
+   * depend on their distance and accessories take a fraction of a second.
+   */
+  MoveCostModel();
+
+  void set_prior(Axis axis, Prior prior);
+
+  [[nodiscard]] Prior prior(Axis axis) const;
+
+  /**
+   * @brief Records a measured move.
+   *
+   * @param axis The axis that moved
+   * @param travel How far it moved
+   * @param duration Time until the monochromator was ready
+   */
+  void record(Axis axis, double travel, std::chrono::microseconds duration);
+
+  /**
+   * @brief Expected duration of a move of an axis.
+   *
+   * @param axis The axis
+   * @param travel How far it moves
+   *
+   * @return The expected duration
+   */
+  [[nodiscard]] std::chrono::microseconds predict(Axis axis,
+                                                  double travel) const;
+
+  /**
+   * @brief Expected duration of Monochromator::apply() from one profile to
+   * another. Mirrors, slits and filter wheels move together, the slowest of
+   * them counts.
+   *
+   * @param from Settings before the move, unknown settings are assumed to
+   * change
+   * @param to Wanted settings
+   *
+   * @return The expected duration
+   */
+  [[nodiscard]] std::chrono::microseconds transition(
+      const single_devices::Monochromator::Profile& from,
+      const single_devices::Monochromator::Profile& to) const;
+
+ private:
+  static constexpr std::size_t AXIS_COUNT = 5;
+
+  mutable std::mutex priors_mutex;
+  std::array<Prior, AXIS_COUNT> priors;
+  // keeps the measured moves of each axis apart, as moves of their kind
+  single_devices::PredictiveWait fits;
+};
+
+/**
+ * @brief Orders the measurement points of a monochromator scan to minimise
+ * the expected mechanical time, and runs them.
+ *
+ * Points sharing a grating and filter wheel positions are grouped, the groups
+ * are ordered by the expected time of the moves between them. Within a group
+ * the wavelength is swept in increasing order, which avoids the backlash of
+ * the drive, either in one sweep or in one sweep per slit and mirror setting,
+ * whichever is expected to be faster. The moves made while running a scan
+ * are measured and refine the MoveCostModel.
+ */
+class ScanPlanner {
+ public:
+  using Profile = single_devices::Monochromator::Profile;
+
+  struct Plan {
+    /**
+     * @brief Indices of the points in the order of execution.
+     */
+    std::vector<std::size_t> order;
+    std::chrono::microseconds expected_duration{0};
+  };
+
+  /**
+   * @param model The move cost model, shared to keep what it learned across
+   * scans
+   *
+   * @throw std::invalid_argument if the model is null
+   */
+  explicit ScanPlanner(std::shared_ptr<MoveCostModel> model) noexcept(false);
+
+  /**
+   * @brief Orders the points.
+   *
+   * @param points The measurement points, settings without value are left as
+   * they are
+   * @param start Settings of the monochromator before the scan
+   *
+   * @return The order of execution
+   */
+  [[nodiscard]] Plan plan(const std::vector<Profile>& points,
+                          const Profile& start) const;
+
+  /**
+   * @brief Moves the monochromator to the points in the planned order and
+   * measures at each point.
+   *
+   * @param mono The opened monochromator
+   * @param points The measurement points
+   * @param measure Callable measuring at a point, e.g. acquiring with a CCD
+   * @param timeout Maximum time to wait for the monochromator after a move
+   *
+   * @return The measurements, in the order of the points
+   *
+   * @throw std::runtime_error when an error occurred on the device side or the
+   * timeout is reached
+   */
+  template <typename Measure>
+  auto run(const std::shared_ptr<single_devices::Monochromator>& mono,
+           const std::vector<Profile>& points, Measure&& measure,
+           std::chrono::seconds timeout) noexcept(false)
+      -> std::vector<std::invoke_result_t<Measure&, const Profile&>> {
+    using Measurement = std::invoke_result_t<Measure&, const Profile&>;
+
+    const auto planned = this->plan(points, mono->known_settings());
+    std::vector<std::optional<Measurement>> measured(points.size());
+    for (const auto index : planned.order) {
+      this->move_to(*mono, points[index], timeout);
+      measured[index].emplace(measure(points[index]));
+    }
+
+    std::vector<Measurement> measurements;
+    measurements.reserve(measured.size());
+    for (auto& measurement : measured) {
+      measurements.push_back(std::move(*measurement));
+    }
+    return measurements;
+  }
+
+  [[nodiscard]] std::shared_ptr<MoveCostModel> model() const;
+
+ private:
+  // above, the groups are ordered greedily instead of by trying all orders
+  static constexpr std::size_t MAX_EXHAUSTIVE_GROUPS = 6;
+
+  std::shared_ptr<MoveCostModel> cost_model;
+
+  void move_to(single_devices::Monochromator& mono, const Profile& point,
+               std::chrono::seconds timeout);
+};
+
+} /* namespace horiba::devices */
+
+#endif /* ifndef SCAN_PLANNER_H */
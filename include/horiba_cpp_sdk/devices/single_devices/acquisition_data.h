@@ -0,0 +1,150 @@
+#ifndef ACQUISITION_DATA_H
+#define ACQUISITION_DATA_H
+
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace horiba::devices::single_devices {
+
+/**
+ * @brief Data of the last acquisitions of a CCD, as returned by
+ * ccd_getAcquisitionData.
+ *
+ * The samples of all acquisitions and regions of interest are stored in one
+ * contiguous buffer, the regions of interest give views on their rows. X axes
+ * that are identical across acquisitions are stored only once. The buffers are
+ * shared between copies, so copying is cheap and the views stay valid as long
+ * as one copy is alive.
+ */
+class AcquisitionData {
+ public:
+  /**
+   * @brief Region of interest of an acquisition
+   */
+  class RegionOfInterest {
+   public:
+    /**
+     * @brief Index of the region of interest.
+     */
+    int index{0};
+    int x_origin{0};
+    int y_origin{0};
+    int x_size{0};
+    int y_size{0};
+    int x_binning{1};
+    int y_binning{1};
+
+    /**
+     * @brief X axis of the region of interest, either pixels or wavelengths
+     * depending on the x axis conversion type.
+     *
+     * @return View on the x axis
+     */
+    [[nodiscard]] std::span<const double> x_data() const;
+
+    /**
+     * @brief Number of rows of samples.
+     *
+     * @return The number of rows
+     */
+    [[nodiscard]] std::size_t rows() const;
+
+    /**
+     * @brief Samples of a row.
+     *
+     * @param row The index of the row
+     *
+     * @return View on the samples of the row
+     *
+     * @throw std::out_of_range if the row does not exist
+     */
+    [[nodiscard]] std::span<const double> row(std::size_t row) const;
+
+    /**
+     * @brief All samples of the region of interest, row after row.
+     *
+     * @return View on the samples
+     */
+    [[nodiscard]] std::span<const double> samples() const;
+
+   private:
+    friend class AcquisitionDataParser;
+
+    std::shared_ptr<const std::vector<double>> x_axis;
+    std::shared_ptr<const std::vector<double>> all_samples;
+    std::size_t samples_offset{0};
+    std::size_t row_count{0};
+    std::size_t row_length{0};
+  };
+
+  /**
+   * @brief One of the programmed acquisitions
+   */
+  class Acquisition {
+   public:
+    /**
+     * @brief Index of the acquisition, "acqIndex".
+     */
+    int index{0};
+
+    /**
+     * @brief Regions of interest of the acquisition.
+     */
+    std::vector<RegionOfInterest> regions_of_interest;
+  };
+
+  AcquisitionData() = default;
+
+  /**
+   * @brief Decodes the acquisition data directly from the raw text of the
+   * ccd_getAcquisitionData response, without building a JSON document.
+   *
+   * The x data may be given as a flat array, as an array of arrays or as
+   * "xyData" pairs. The y data may be given as a flat array or as an array of
+   * rows.
+   *
+   * @param raw_response The JSON text of the response
+   *
+   * @return The decoded acquisition data
+   *
+   * @throw std::invalid_argument if the response cannot be decoded
+   */
+  static AcquisitionData parse(std::string_view raw_response);
+
+  /**
+   * @brief The acquisitions.
+   *
+   * @return The acquisitions, in the order sent by the ICL
+   */
+  [[nodiscard]] const std::vector<Acquisition>& acquisitions() const;
+
+  /**
+   * @brief Time when all programmed acquisitions completed.
+   *
+   * @return The timestamp as sent by the ICL
+   */
+  [[nodiscard]] const std::string& timestamp() const;
+
+  /**
+   * @brief Number of distinct x axes stored. Identical x axes of several
+   * acquisitions are only stored once.
+   *
+   * @return The number of stored x axes
+   */
+  [[nodiscard]] std::size_t distinct_x_axes() const;
+
+ private:
+  friend class AcquisitionDataParser;
+
+  std::vector<Acquisition> acquisition_list;
+  std::string acquisition_timestamp;
+  std::size_t x_axes_count{0};
+};
+
+} /* namespace horiba::devices::single_devices */
+
+#endif /* ifndef ACQUISITION_DATA_H */
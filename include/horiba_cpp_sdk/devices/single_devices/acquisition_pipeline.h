@@ -0,0 +1,170 @@
+#ifndef ACQUISITION_PIPELINE_H
+#define ACQUISITION_PIPELINE_H
+
+#include <horiba_cpp_sdk/communication/response.h>
+#include <horiba_cpp_sdk/devices/single_devices/acquisition_data.h>
+#include <horiba_cpp_sdk/devices/single_devices/ccd.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+
+namespace horiba::devices::single_devices {
+
+/**
+ * @brief Acquires frames with a CCD back to back, chaining the start of the
+ * acquisition, the wait until it is done, the fetch and the decoding of its
+ * data.
+ *
+ * The wait uses the wait strategy of the CCD instead of fixed sleeps, and the
+ * decoding of a frame runs on its own thread while the CCD already acquires
+ * the next one, so the throughput is bounded by the exposure and readout of
+ * the CCD. The data of a frame has to be fetched before the next acquisition
+ * starts, as the CCD only keeps the data of its last acquisition.
+ *
+ * The CCD has to be set up before the pipeline starts, e.g. with a
+ * ChargeCoupledDevice::Profile. Decoded frames are either handed to a
+ * handler, called on the decoding thread, or queued until popped. A full
+ * queue holds the acquisitions back.
+ */
+class AcquisitionPipeline {
+ public:
+  struct Options {
+    /**
+     * @brief Amount of frames to acquire, 0 to acquire until stopped.
+     */
+    std::size_t frames{0};
+    bool open_shutter{true};
+    /**
+     * @brief Maximum amount of decoded frames waiting to be popped.
+     */
+    std::size_t capacity{4};
+    /**
+     * @brief Maximum time to wait for one acquisition to be done.
+     */
+    std::chrono::milliseconds frame_timeout{std::chrono::seconds(60)};
+  };
+
+  struct Frame {
+    /**
+     * @brief Number of the frame, starting at 0.
+     */
+    std::size_t sequence{0};
+    AcquisitionData data;
+    std::chrono::steady_clock::time_point started;
+    /**
+     * @brief When the CCD was found done with the acquisition.
+     */
+    std::chrono::steady_clock::time_point acquired;
+    std::chrono::steady_clock::time_point decoded;
+  };
+
+  using FrameHandler = std::function<void(Frame frame)>;
+
+  /**
+   * @param ccd The opened and set up CCD
+   * @param options Options of the pipeline
+   * @param handler Handler of the decoded frames, if empty the frames are
+   * queued until popped
+   *
+   * @throw std::invalid_argument if the CCD is null or the capacity is 0
+   */
+  AcquisitionPipeline(std::shared_ptr<ChargeCoupledDevice> ccd, Options options,
+                      FrameHandler handler = {}) noexcept(false);
+  ~AcquisitionPipeline();
+
+  AcquisitionPipeline(const AcquisitionPipeline&) = delete;
+  AcquisitionPipeline& operator=(const AcquisitionPipeline&) = delete;
+  AcquisitionPipeline(AcquisitionPipeline&&) = delete;
+  AcquisitionPipeline& operator=(AcquisitionPipeline&&) = delete;
+
+  /**
+   * @brief Starts acquiring. A pipeline only runs once.
+   *
+   * @throw std::runtime_error if the pipeline was already started
+   */
+  void start() noexcept(false);
+
+  /**
+   * @brief Stops acquiring once the current acquisition is done and waits
+   * for the threads of the pipeline. The frames already fetched are still
+   * decoded, beyond the capacity if needed, and can be popped afterwards.
+   */
+  void stop();
+
+  /**
+   * @brief Waits for the next decoded frame.
+   *
+   * @param timeout Maximum time to wait
+   *
+   * @return The frame, nothing on timeout or once all frames are popped
+   *
+   * @throw std::exception the error that stopped the pipeline, once the
+   * frames decoded before it are popped
+   */
+  std::optional<Frame> wait_and_pop(std::chrono::milliseconds timeout) noexcept(
+      false);
+
+  /**
+   * @brief Pops the next decoded frame if there is one.
+   *
+   * @return The frame, nothing if none is decoded yet
+   *
+   * @throw std::exception the error that stopped the pipeline, once the
+   * frames decoded before it are popped
+   */
+  std::optional<Frame> try_pop() noexcept(false);
+
+  /**
+   * @brief Whether all frames are acquired and decoded, or the pipeline
+   * stopped.
+   */
+  [[nodiscard]] bool finished();
+
+  /**
+   * @brief Amount of frames acquired so far.
+   */
+  [[nodiscard]] std::size_t acquired_frames();
+
+ private:
+  struct FetchedFrame {
+    std::size_t sequence{0};
+    communication::Response response;
+    std::chrono::steady_clock::time_point started;
+    std::chrono::steady_clock::time_point acquired;
+  };
+
+  std::shared_ptr<ChargeCoupledDevice> ccd;
+  Options options;
+  FrameHandler handler;
+
+  std::mutex mutex;
+  std::condition_variable changed;
+  bool started{false};
+  bool stopping{false};
+  bool acquiring_done{false};
+  bool decoding_done{false};
+  std::exception_ptr error;
+  std::size_t acquired{0};
+  std::optional<FetchedFrame> fetched;
+  std::deque<Frame> frames;
+
+  std::thread acquisition_thread;
+  std::thread decoding_thread;
+
+  void acquire();
+  void decode();
+  void fail(std::exception_ptr failure);
+  std::optional<Frame> pop(std::unique_lock<std::mutex>& lock);
+};
+
+} /* namespace horiba::devices::single_devices */
+
+#endif /* ifndef ACQUISITION_PIPELINE_H */
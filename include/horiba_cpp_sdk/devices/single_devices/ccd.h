@@ -2,11 +2,20 @@
 #define CCD_H
 
 #include <horiba_cpp_sdk/communication/communicator.h>
+#include <horiba_cpp_sdk/devices/single_devices/acquisition_data.h>
 #include <horiba_cpp_sdk/devices/single_devices/device.h>
-
-#include <any>
+#include <horiba_cpp_sdk/devices/single_devices/device_capabilities.h>
+#include <horiba_cpp_sdk/devices/single_devices/known_settings.h>
+
+#include <boost/asio/awaitable.hpp>
+#include <chrono>
+#include <cstddef>
+#include <future>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <nlohmann/json.hpp>
+#include <optional>
 #include <stdexcept>
 #include <string>
 #include <unordered_map>
@@ -55,6 +64,49 @@ class ChargeCoupledDevice final : public Device {
     ONE_MICROSECOND
   };
 
+  /**
+   * @brief Acquisition format as set by set_acquisition_format().
+   */
+  struct AcquisitionFormatSettings {
+    int number_of_rois{1};
+    AcquisitionFormat format{AcquisitionFormat::SPECTRA_IMAGE};
+
+    bool operator==(const AcquisitionFormatSettings& other) const = default;
+  };
+
+  /**
+   * @brief Region of interest as set by set_region_of_interest().
+   */
+  struct RegionOfInterestSettings {
+    int x_origin{0};
+    int y_origin{0};
+    int x_size{0};
+    int y_size{0};
+    int x_binning{0};
+    int y_binning{0};
+
+    bool operator==(const RegionOfInterestSettings& other) const = default;
+  };
+
+  /**
+   * @brief Settings of a CCD. Settings without value are left as they are.
+   *
+   * Used both to describe the wanted settings, see apply(), and the settings
+   * last known to be set, see known_settings().
+   */
+  struct Profile {
+    std::optional<AcquisitionFormatSettings> acquisition_format;
+    // by index of the region of interest
+    std::map<int, RegionOfInterestSettings> regions_of_interest;
+    std::optional<XAxisConversionType> x_axis_conversion_type;
+    std::optional<TimerResolution> timer_resolution;
+    std::optional<int> gain;
+    std::optional<int> speed;
+    std::optional<int> parallel_speed;
+    std::optional<int> exposure_time;
+    std::optional<int> acquisition_count;
+  };
+
   ChargeCoupledDevice(
       int id, std::shared_ptr<communication::Communicator> communicator);
   ~ChargeCoupledDevice() override = default;
@@ -86,7 +138,8 @@ class ChargeCoupledDevice final : public Device {
    * @brief Restarts the CCD.
    *
    * Note that this function only works if the camera has been opened before.
-   * The connection to the camera stays open after the restart.
+   * The connection to the camera stays open after the restart. The cached
+   * capabilities are fetched again on their next use.
    *
    * @throw std::runtime_error when an error occurred on the device side
    */
@@ -95,12 +148,83 @@ class ChargeCoupledDevice final : public Device {
   /**
    * @brief Returns the configuration of the CCD.
    *
+   * The configuration is always queried from the ICL, see capabilities() for
+   * the cached one.
+   *
    * @return Configuration of the CCD
    *
    * @throw std::runtime_error when an error occurred on the device side
    */
   nlohmann::json get_configuration();
 
+  /**
+   * @brief Returns the capabilities of the CCD, compiled from its
+   * configuration.
+   *
+   * They are fetched when the CCD is opened and kept until it is closed or
+   * restarted, so that validating settings needs no round trip to the ICL.
+   *
+   * @return Capabilities of the CCD
+   *
+   * @throw std::runtime_error when an error occurred on the device side
+   */
+  std::shared_ptr<const CcdCapabilities> capabilities() noexcept(false);
+
+  /**
+   * @brief Sets the capabilities from a configuration known beforehand, e.g.
+   * from a discovery cache, so that they are available without a round trip.
+   * Opening the CCD keeps them if they belong to the CCD with the listed
+   * serial number, otherwise it fetches them again.
+   *
+   * @param configuration The configuration of the CCD
+   * @param listed_serial_number Serial number of the CCD, as listed by the ICL
+   */
+  void preload_capabilities(const nlohmann::json& configuration,
+                            const std::string& listed_serial_number);
+
+  /**
+   * @brief Sets the function called with the configuration each time it is
+   * fetched from the ICL, e.g. to keep it in a discovery cache.
+   *
+   * @param listener Called outside of any lock of the CCD
+   */
+  void set_capabilities_listener(CapabilitiesListener listener);
+
+  /**
+   * @brief Capabilities that are already known, without asking the ICL.
+   *
+   * @return The capabilities, nullptr if they have not been fetched yet
+   */
+  [[nodiscard]] std::shared_ptr<const CcdCapabilities> loaded_capabilities();
+
+  /**
+   * @brief Settings last set through this object.
+   *
+   * They are forgotten when the CCD is opened, closed or restarted, and when a
+   * command fails.
+   *
+   * @return The known settings
+   */
+  Profile known_settings();
+
+  /**
+   * @brief Forgets the known settings, e.g. after the CCD was configured by
+   * another program.
+   */
+  void forget_known_settings();
+
+  /**
+   * @brief Sets the settings of a profile, skipping the ones the CCD is known
+   * to have already. The remaining commands are sent in one CommandBatch.
+   *
+   * @param profile The wanted settings
+   *
+   * @return The amount of commands sent
+   *
+   * @throw std::runtime_error when an error occurred on the device side
+   */
+  std::size_t apply(const Profile& profile) noexcept(false);
+
   /**
    * @brief Returns the gain token of the CCD.
    *
@@ -529,11 +653,38 @@ class ChargeCoupledDevice final : public Device {
    * acquisitions are retrieve from the CCD after all acquisitions have
    * completed, therefore the same timestamp is used for all acquisitions.
    *
-   * @return std::any Acquisition data.
+   * The data is decoded directly from the response of the ICL into contiguous
+   * typed buffers, see AcquisitionData.
+   *
+   * @return AcquisitionData Acquisition data.
+   *
+   * @throws std::exception When an error occurs on the device side.
+   */
+  AcquisitionData get_acquisition_data() noexcept(false);
+
+  /**
+   * @brief Fetches the acquisition data of the CCD without decoding it, so
+   * that it can be decoded on another thread while the CCD acquires again,
+   * see AcquisitionPipeline.
+   *
+   * @return The response holding the acquisition data, to be decoded with
+   * decode_acquisition_data()
    *
    * @throws std::exception When an error occurs on the device side.
    */
-  std::any get_acquisition_data() noexcept(false);
+  communication::Response fetch_acquisition_data() noexcept(false);
+
+  /**
+   * @brief Decodes the acquisition data fetched by fetch_acquisition_data().
+   *
+   * @param response The response of ccd_getAcquisitionData
+   *
+   * @return The decoded acquisition data
+   *
+   * @throw std::invalid_argument if the response cannot be decoded
+   */
+  static AcquisitionData decode_acquisition_data(
+      const communication::Response& response) noexcept(false);
 
   /**
    * @brief Returns true if the CCD is busy with the acquisition.
@@ -547,9 +698,16 @@ class ChargeCoupledDevice final : public Device {
   /**
    * @brief Stops the acquisition of the CCD.
    *
+   * The abort command is a priority command, see
+   * communication::CommunicatorPool: it is not held back by a data transfer
+   * in progress.
+   *
+   * @return The time from sending the abort command to its acknowledgment by
+   * the ICL.
+   *
    * @throws std::exception When an error occurs on the device side.
    */
-  void abort_acquisition() noexcept(false);
+  std::chrono::microseconds abort_acquisition() noexcept(false);
 
   /**
    * @brief Sets the center wavelength value to be used in the grating equation.
@@ -587,6 +745,128 @@ class ChargeCoupledDevice final : public Device {
   std::vector<double> range_mode_center_wavelenghts(
       int monochromator_id, double start_wavelength, double end_wavelength,
       double pixel_overlap) noexcept(false);
+
+  /**
+   * @brief Awaitable version of set_exposure_time().
+   *
+   * @param exposure_time_ms Exposure time in ms
+   *
+   * @throws std::exception When an error occurs on the device side.
+   */
+  boost::asio::awaitable<void> set_exposure_time_async(
+      int exposure_time_ms) noexcept(false);
+
+  /**
+   * @brief Awaitable version of set_center_wavelength().
+   *
+   * @param monochromator_id Monochromator ID that is used with this CCD
+   * @param wavelength Center wavelength value in nm
+   *
+   * @throws std::exception When an error occurs on the device side.
+   */
+  boost::asio::awaitable<void> set_center_wavelength_async(
+      int monochromator_id, double wavelength) noexcept(false);
+
+  /**
+   * @brief Awaitable version of get_acquisition_ready().
+   *
+   * @return bool True if the CCD is ready to acquire.
+   *
+   * @throws std::exception When an error occurs on the device side.
+   */
+  boost::asio::awaitable<bool> get_acquisition_ready_async() noexcept(false);
+
+  /**
+   * @brief Awaitable version of set_acquisition_start().
+   *
+   * @param open_shutter Whether the shutter of the camera should be open during
+   * the acquisition.
+   *
+   * @throws std::exception When an error occurs on the device side.
+   */
+  boost::asio::awaitable<void> set_acquisition_start_async(
+      bool open_shutter) noexcept(false);
+
+  /**
+   * @brief Awaitable version of get_acquisition_busy().
+   *
+   * @return bool True if the CCD is busy.
+   *
+   * @throws std::exception When an error occurs on the device side.
+   */
+  boost::asio::awaitable<bool> get_acquisition_busy_async() noexcept(false);
+
+  /**
+   * @brief Awaitable version of get_acquisition_data().
+   *
+   * @return AcquisitionData Acquisition data.
+   *
+   * @throws std::exception When an error occurs on the device side.
+   */
+  boost::asio::awaitable<AcquisitionData> get_acquisition_data_async() noexcept(
+      false);
+
+  /**
+   * @brief Awaitable version of abort_acquisition().
+   *
+   * @throws std::exception When an error occurs on the device side.
+   */
+  boost::asio::awaitable<std::chrono::microseconds>
+  abort_acquisition_async() noexcept(false);
+
+  /**
+   * @brief Awaitable version of wait_until_acquisition_done(). Polls the CCD
+   * on a timer of the executor of the coroutine.
+   *
+   * @param timeout Maximum time to wait for the acquisition to be done
+   * @param poll_interval Fixed time between two checks of the CCD, its wait
+   * strategy decides if not given
+   *
+   * @throws std::runtime_error when the timeout is reached
+   */
+  boost::asio::awaitable<void> wait_until_acquisition_done_async(
+      std::chrono::milliseconds timeout,
+      std::optional<std::chrono::milliseconds> poll_interval =
+          std::nullopt) noexcept(false);
+
+  /**
+   * @brief Blocking waits until the CCD is not busy with the acquisition
+   * anymore.
+   *
+   * The CCD is polled as decided by its wait strategy, see
+   * set_wait_strategy(). The travel of an acquisition is its known exposure
+   * time.
+   *
+   * @param timeout Maximum time to wait for the acquisition to be done
+   *
+   * @throws std::runtime_error when the timeout is reached
+   */
+  void wait_until_acquisition_done(std::chrono::milliseconds timeout) noexcept(
+      false);
+
+  [[nodiscard]] std::future<bool> request_busy() noexcept(false) override;
+
+  /**
+   * @brief Exposure time in ms of the acquisition started since the last
+   * wait, which takes about as long.
+   */
+  [[nodiscard]] Travel take_pending_travel() override;
+
+ private:
+  std::mutex capabilities_mutex;
+  std::shared_ptr<const CcdCapabilities> cached_capabilities;
+  // serial number the preloaded capabilities are checked against on open
+  std::optional<std::string> preloaded_serial_number;
+  CapabilitiesListener capabilities_listener;
+  KnownSettings<Profile> known;
+  // travel of the acquisition started since the last wait
+  std::mutex pending_travel_mutex;
+  std::optional<Travel> pending_travel;
+
+  void invalidate_capabilities();
+  void keep_preloaded_capabilities();
+  void note_acquisition_travel();
+  void remember_profile(const Profile& profile);
 };
 } /* namespace horiba::devices::single_devices */
 #endif /* ifndef CCD_H */
@@ -0,0 +1,180 @@
+#ifndef COMMAND_BATCH_H
+#define COMMAND_BATCH_H
+
+#include <horiba_cpp_sdk/communication/command.h>
+#include <horiba_cpp_sdk/communication/communicator.h>
+#include <horiba_cpp_sdk/communication/response.h>
+
+#include <chrono>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace horiba::devices::single_devices {
+
+class Device;
+
+/**
+ * @brief Result of one command of a CommandBatch.
+ */
+struct CommandOutcome {
+  communication::Command command;
+  // response of the ICL, empty if the command could not be sent
+  communication::Response response;
+  // error of the communication with the ICL, if any
+  std::exception_ptr error;
+
+  /**
+   * @brief Checks if the command was sent and the ICL reported no error.
+   *
+   * @return True if the command succeeded, false otherwise
+   */
+  [[nodiscard]] bool succeeded() const;
+};
+
+/**
+ * @brief Results of all the commands of a CommandBatch, in the order they
+ * were added.
+ */
+struct BatchResult {
+  std::vector<CommandOutcome> outcomes;
+  // time from sending the first command to receiving the last response
+  std::chrono::microseconds duration{0};
+
+  /**
+   * @brief Checks if all the commands succeeded.
+   *
+   * @return True if all the commands succeeded, false otherwise
+   */
+  [[nodiscard]] bool succeeded() const;
+
+  /**
+   * @brief Throws if a command failed.
+   *
+   * @throw std::runtime_error listing the failed commands and their errors
+   */
+  void throw_if_failed() const;
+};
+
+/**
+ * @brief Builder sending several commands of a device in one go.
+ *
+ * The commands are queued, then written back-to-back without waiting for the
+ * responses in between, so that configuring a device takes about one round
+ * trip to the ICL instead of one per command. The ICL executes them in
+ * order; a failing command does not stop the following ones, its errors are
+ * reported in the result.
+ *
+ * Commands are added either directly or by calling a setter of the device,
+ * which then queues its command instead of sending it:
+ *
+ * @code
+ * const auto result =
+ *     ccd.batch()
+ *         .add(&ChargeCoupledDevice::set_exposure_time, 100)
+ *         .add(&ChargeCoupledDevice::set_acquisition_count, 1)
+ *         .execute();
+ * result.throw_if_failed();
+ * @endcode
+ */
+class CommandBatch {
+ public:
+  /**
+   * @brief Queues a command.
+   *
+   * @param command The command for the ICL
+   *
+   * @return This batch
+   */
+  CommandBatch& add(communication::Command command);
+
+  /**
+   * @brief Queues the command a setter of the device would send.
+   *
+   * Only setters are accepted, as the command is not executed yet and there
+   * is no result to return.
+   *
+   * @param setter The setter of the device, e.g.
+   * &ChargeCoupledDevice::set_exposure_time
+   * @param arguments The arguments of the setter
+   *
+   * @return This batch
+   *
+   * @throw std::invalid_argument if the batch is not for a device of the type
+   * of the setter
+   */
+  template <typename DeviceType, typename... Parameters,
+            typename... Arguments>
+  CommandBatch& add(void (DeviceType::*setter)(Parameters...),
+                    Arguments&&... arguments) {
+    auto* typed_device = dynamic_cast<DeviceType*>(this->device);
+    if (typed_device == nullptr) {
+      throw std::invalid_argument("setter does not belong to the device");
+    }
+    const Recording recording{this};
+    (typed_device->*setter)(std::forward<Arguments>(arguments)...);
+    return *this;
+  }
+
+  /**
+   * @brief Amount of queued commands.
+   *
+   * @return The amount of commands
+   */
+  [[nodiscard]] std::size_t size() const;
+
+  /**
+   * @brief Sends all the queued commands and waits for their responses. The
+   * batch is empty afterwards.
+   *
+   * @return The outcome of each command
+   *
+   * @throw std::runtime_error if the communicator is not open
+   */
+  BatchResult execute();
+
+ private:
+  friend class Device;
+
+  /**
+   * @brief Queues the commands of the device on the current thread for the
+   * time of its life. Without a batch, the commands are sent right away
+   * while it lives, e.g. the reads a recorded setter depends on.
+   */
+  class Recording {
+   public:
+    explicit Recording(CommandBatch* batch);
+    Recording(const Recording&) = delete;
+    Recording& operator=(const Recording&) = delete;
+    Recording(Recording&&) = delete;
+    Recording& operator=(Recording&&) = delete;
+    ~Recording();
+
+   private:
+    CommandBatch* previous;
+  };
+
+  Device* device;
+  std::shared_ptr<communication::Communicator> communicator;
+  std::vector<communication::Command> commands;
+
+  CommandBatch(Device& device,
+               std::shared_ptr<communication::Communicator> communicator);
+
+  /**
+   * @brief Batch recording the commands of a device on the current thread.
+   *
+   * @param device The device
+   *
+   * @return The recording batch, nullptr if there is none
+   */
+  static CommandBatch* recording_for(const Device& device);
+};
+
+} /* namespace horiba::devices::single_devices */
+
+#endif /* ifndef COMMAND_BATCH_H */
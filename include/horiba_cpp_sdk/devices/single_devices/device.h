@@ -3,10 +3,23 @@
 
 #include <horiba_cpp_sdk/communication/communicator.h>
 #include <horiba_cpp_sdk/communication/response.h>
+#include <horiba_cpp_sdk/devices/single_devices/command_batch.h>
+#include <horiba_cpp_sdk/devices/single_devices/wait_strategy.h>
+
+#include <boost/asio/awaitable.hpp>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
 
 namespace horiba::devices::single_devices {
 /**
  * @brief Interface for devices connected to the ICL
+ *
+ * Besides the blocking methods, devices offer awaitable methods, suffixed with
+ * _async, to be used in C++20 coroutines running on a boost::asio executor.
+ * While a coroutine waits for the ICL its thread is free, so one thread can
+ * drive many devices. The device must outlive the coroutines using it.
  */
 class Device {
  public:
@@ -25,13 +38,95 @@ class Device {
 
   [[nodiscard]] int device_id() const;
 
+  /**
+   * @brief Starts a batch of commands for this device, sent in one go.
+   *
+   * @return An empty batch
+   */
+  [[nodiscard]] CommandBatch batch();
+
+  /**
+   * @brief Replaces how the device is polled while waiting for it to be
+   * ready. By default it backs off exponentially and predicts the duration of
+   * the waits from the past ones, see PredictiveWait.
+   *
+   * @param strategy The new wait strategy
+   */
+  void set_wait_strategy(std::shared_ptr<WaitStrategy> strategy);
+
+  /**
+   * @brief The strategy used while waiting for the device to be ready.
+   *
+   * @return The wait strategy
+   */
+  [[nodiscard]] std::shared_ptr<WaitStrategy> wait_strategy() const;
+
+  /**
+   * @brief Asks the ICL whether the device is busy without waiting for the
+   * answer, so that many devices can be polled in the same round trip, see
+   * WaitSet.
+   *
+   * @return Future answer of the ICL, true if the device is busy
+   */
+  [[nodiscard]] virtual std::future<bool> request_busy() noexcept(false) = 0;
+
+  /**
+   * @brief How far the device moves until it is ready, e.g. the distance to
+   * the target wavelength of a monochromator, used by the wait strategies.
+   * The travel of a move is only taken once.
+   *
+   * @return The travel, of unknown kind and distance if unknown
+   */
+  [[nodiscard]] virtual Travel take_pending_travel();
+
  protected:
   communication::Response execute_command(
       const communication::Command& command);
 
+  boost::asio::awaitable<communication::Response> execute_command_async(
+      communication::Command command);
+
+  /**
+   * @brief Executes a command reading from the device right away, even
+   * while a setter is recorded by a CommandBatch, e.g. the configuration a
+   * setter validates its arguments against.
+   *
+   * @param command The command
+   *
+   * @return The response to the command
+   *
+   * @throw std::runtime_error when an error occurred on the device side
+   */
+  communication::Response execute_query(const communication::Command& command);
+
+  /**
+   * @brief Checks if a response confirms that its command was executed. It
+   * does not if the command was only queued in a CommandBatch or the ICL
+   * reported errors.
+   *
+   * @param response The response to the command
+   *
+   * @return True if the command was executed, false otherwise
+   */
+  [[nodiscard]] bool executed(const communication::Response& response) const;
+
+  /**
+   * @brief Sends a command answering with a flag, e.g. whether the device is
+   * busy, without waiting for the response.
+   *
+   * @param command The command
+   * @param flag Name of the flag in the results of the response
+   *
+   * @return Future value of the flag
+   */
+  std::future<bool> request_flag(const communication::Command& command,
+                                 std::string flag);
+
  private:
   int id;
   std::shared_ptr<communication::Communicator> communicator;
+  mutable std::mutex wait_strategy_mutex;
+  std::shared_ptr<WaitStrategy> strategy{std::make_shared<PredictiveWait>()};
 
   void handle_errors(const std::vector<std::string>& errors);
 };
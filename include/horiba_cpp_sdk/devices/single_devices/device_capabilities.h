@@ -0,0 +1,165 @@
+#ifndef DEVICE_CAPABILITIES_H
+#define DEVICE_CAPABILITIES_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <nlohmann/json.hpp>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace horiba::devices::single_devices {
+
+/**
+ * @brief Called with the configuration of a device once it has been fetched
+ * from the ICL, e.g. to keep it in a discovery cache.
+ */
+using CapabilitiesListener =
+    std::function<void(const nlohmann::json& configuration)>;
+
+/**
+ * @brief Valid (address, event, signal type) combinations of the triggers or
+ * signals of a CCD, looked up in constant time.
+ */
+class SignalPathTable {
+ public:
+  /**
+   * @brief Builds the table from the "triggers" or "signals" list of a CCD
+   * configuration.
+   *
+   * @param paths The list of addresses with their events and signal types
+   *
+   * @return The table
+   */
+  static SignalPathTable parse(const nlohmann::json& paths);
+
+  [[nodiscard]] bool contains_address(int address) const;
+  [[nodiscard]] bool contains_event(int address, int event) const;
+  [[nodiscard]] bool contains(int address, int event, int signal_type) const;
+
+  /**
+   * @brief Amount of valid (address, event, signal type) combinations.
+   *
+   * @return The amount of combinations
+   */
+  [[nodiscard]] std::size_t size() const;
+
+ private:
+  struct Path {
+    int address;
+    int event;
+    int signal_type;
+
+    bool operator==(const Path& other) const = default;
+  };
+
+  struct PathHash {
+    std::size_t operator()(const Path& path) const noexcept;
+  };
+
+  std::unordered_set<int> addresses;
+  // address in the upper, event in the lower 32 bits
+  std::unordered_set<std::uint64_t> events;
+  std::unordered_set<Path, PathHash> paths;
+};
+
+/**
+ * @brief Token and description of a setting of a CCD, e.g. a gain.
+ */
+struct CcdOption {
+  int token{0};
+  std::string info;
+};
+
+/**
+ * @brief Configuration of a CCD that does not change while it is open, as
+ * returned by ccd_getConfig, compiled into typed values and lookup tables.
+ */
+struct CcdCapabilities {
+  int chip_width{0};
+  int chip_height{0};
+  std::string chip_name;
+  std::string device_type;
+  std::string serial_number;
+  std::vector<CcdOption> gains;
+  std::vector<CcdOption> speeds;
+  std::vector<int> fit_parameters;
+  SignalPathTable triggers;
+  SignalPathTable signals;
+  // the configuration as sent by the ICL
+  nlohmann::json configuration;
+
+  /**
+   * @brief Compiles the configuration of a CCD.
+   *
+   * @param configuration The "configuration" result of ccd_getConfig
+   *
+   * @return The capabilities of the CCD
+   */
+  static CcdCapabilities parse(const nlohmann::json& configuration);
+
+  [[nodiscard]] bool has_gain(int token) const;
+  [[nodiscard]] bool has_speed(int token) const;
+
+  /**
+   * @brief Whether the configuration is the one of the CCD with the serial
+   * number, as listed by ccd_list.
+   */
+  [[nodiscard]] bool belongs_to(const std::string& listed_serial_number) const;
+};
+
+/**
+ * @brief Grating installed in a monochromator.
+ */
+struct MonochromatorGrating {
+  int position_index{0};
+  double groove_density{0.0};
+  double blaze{0.0};
+};
+
+/**
+ * @brief Entrance or exit port of a monochromator.
+ */
+struct MonochromatorPort {
+  int location{0};
+  int slit_type{0};
+};
+
+/**
+ * @brief Configuration of a monochromator that does not change while it is
+ * open, as returned by mono_getConfig, compiled into typed values.
+ */
+struct MonochromatorCapabilities {
+  std::string model;
+  std::string serial_number;
+  std::string product_id;
+  std::vector<MonochromatorGrating> gratings;
+  std::vector<int> mirror_locations;
+  std::vector<MonochromatorPort> ports;
+  std::size_t filter_wheels{0};
+  // the configuration as sent by the ICL
+  nlohmann::json configuration;
+
+  /**
+   * @brief Compiles the configuration of a monochromator.
+   *
+   * @param configuration The "configuration" result of mono_getConfig
+   *
+   * @return The capabilities of the monochromator
+   */
+  static MonochromatorCapabilities parse(const nlohmann::json& configuration);
+
+  [[nodiscard]] bool has_grating(int position_index) const;
+
+  /**
+   * @brief Whether the configuration is the one of the monochromator with the
+   * serial number, as listed by mono_list. Some monochromators have no serial
+   * number in their configuration, it then belongs to any of them.
+   */
+  [[nodiscard]] bool belongs_to(const std::string& listed_serial_number) const;
+};
+
+} /* namespace horiba::devices::single_devices */
+
+#endif /* ifndef DEVICE_CAPABILITIES_H */
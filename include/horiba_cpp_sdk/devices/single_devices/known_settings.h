@@ -0,0 +1,122 @@
+#ifndef KNOWN_SETTINGS_H
+#define KNOWN_SETTINGS_H
+
+#include <map>
+#include <mutex>
+#include <optional>
+
+namespace horiba::devices::single_devices {
+
+/**
+ * @brief Client side shadow of the settings last sent to a device, used to
+ * skip commands that would not change anything.
+ *
+ * A setting is either known or unknown; it becomes unknown when a command may
+ * have changed it without confirming its value.
+ *
+ * @tparam Profile Settings of the device, made of optional values and maps
+ */
+template <typename Profile>
+class KnownSettings {
+ public:
+  /**
+   * @brief Copy of the known settings.
+   *
+   * @return The known settings
+   */
+  [[nodiscard]] Profile get() const {
+    const std::lock_guard<std::mutex> lock(this->mutex);
+    return this->settings;
+  }
+
+  /**
+   * @brief Forgets all settings.
+   */
+  void forget() {
+    const std::lock_guard<std::mutex> lock(this->mutex);
+    this->settings = Profile{};
+  }
+
+  /**
+   * @brief Records the value of a setting, or forgets it if the value is not
+   * confirmed.
+   *
+   * @param confirmed Whether the device confirmed the value
+   * @param setting The setting
+   * @param value The value sent to the device
+   */
+  template <typename Setting, typename Value>
+  void remember(bool confirmed, std::optional<Setting> Profile::*setting,
+                Value value) {
+    const std::lock_guard<std::mutex> lock(this->mutex);
+    if (!confirmed) {
+      (this->settings.*setting).reset();
+      return;
+    }
+    this->settings.*setting = Setting{value};
+  }
+
+  /**
+   * @brief Records the value of a setting at one location, e.g. the position
+   * of one slit, or forgets it if the value is not confirmed.
+   *
+   * @param confirmed Whether the device confirmed the value
+   * @param location_settings The settings of all locations
+   * @param location The location
+   * @param value The value sent to the device
+   */
+  template <typename Location, typename Setting>
+  void remember(bool confirmed,
+                std::map<Location, Setting> Profile::*location_settings,
+                Location location, Setting value) {
+    const std::lock_guard<std::mutex> lock(this->mutex);
+    if (!confirmed) {
+      (this->settings.*location_settings).erase(location);
+      return;
+    }
+    (this->settings.*location_settings)[location] = value;
+  }
+
+  /**
+   * @brief Forgets a setting.
+   *
+   * @param setting The setting
+   */
+  template <typename Setting>
+  void forget(std::optional<Setting> Profile::*setting) {
+    const std::lock_guard<std::mutex> lock(this->mutex);
+    (this->settings.*setting).reset();
+  }
+
+  /**
+   * @brief Forgets a setting at one location.
+   *
+   * @param location_settings The settings of all locations
+   * @param location The location
+   */
+  template <typename Location, typename Setting>
+  void forget(std::map<Location, Setting> Profile::*location_settings,
+              Location location) {
+    const std::lock_guard<std::mutex> lock(this->mutex);
+    (this->settings.*location_settings).erase(location);
+  }
+
+  /**
+   * @brief Forgets a setting at all locations.
+   *
+   * @param location_settings The settings of all locations
+   */
+  template <typename Location, typename Setting>
+  void forget(std::map<Location, Setting> Profile::*location_settings) {
+    const std::lock_guard<std::mutex> lock(this->mutex);
+    (this->settings.*location_settings).clear();
+  }
+
+ private:
+  mutable std::mutex mutex;
+  Profile settings;
+};
+
+} /* namespace horiba::devices::single_devices */
+
+#endif /* ifndef KNOWN_SETTINGS_H */
@@ -0,0 +1,157 @@
+#ifndef LIVE_VIEW_H
+#define LIVE_VIEW_H
+
+#include <horiba_cpp_sdk/devices/single_devices/acquisition_data.h>
+#include <horiba_cpp_sdk/devices/single_devices/ccd.h>
+#include <horiba_cpp_sdk/devices/single_devices/triple_buffer.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+
+namespace horiba::devices::single_devices {
+
+/**
+ * @brief Keeps a CCD acquiring back to back and always hands over the newest
+ * frame, e.g. to align or focus with a live view.
+ *
+ * The acquisitions run on a dedicated thread and their frames go through a
+ * TripleBuffer: neither the acquisitions nor the consumer wait for each
+ * other, and a frame replaced by a newer one before being taken is dropped
+ * and counted. The CCD has to be set up before the live view starts.
+ */
+class LiveView {
+ public:
+  struct Options {
+    bool open_shutter{true};
+    /**
+     * @brief Maximum time to wait for one acquisition to be done.
+     */
+    std::chrono::milliseconds frame_timeout{std::chrono::seconds(60)};
+  };
+
+  struct Frame {
+    /**
+     * @brief Number of the frame, starting at 0.
+     */
+    std::size_t sequence{0};
+    AcquisitionData data;
+    /**
+     * @brief When the data of the frame was decoded.
+     */
+    std::chrono::steady_clock::time_point acquired;
+  };
+
+  struct Statistics {
+    std::size_t acquired_frames{0};
+    std::size_t taken_frames{0};
+    /**
+     * @brief Frames replaced by a newer one before being taken.
+     */
+    std::size_t dropped_frames{0};
+    /**
+     * @brief Sustained frame rate of the acquisitions, smoothed over the last
+     * frames.
+     */
+    double frames_per_second{0.0};
+    /**
+     * @brief Time between the acquisition of the last taken frame and its
+     * handoff.
+     */
+    std::chrono::microseconds last_frame_age{0};
+  };
+
+  /**
+   * @param ccd The opened and set up CCD
+   * @param options Options of the live view
+   *
+   * @throw std::invalid_argument if the CCD is null
+   */
+  LiveView(std::shared_ptr<ChargeCoupledDevice> ccd,
+           Options options) noexcept(false);
+  ~LiveView();
+
+  LiveView(const LiveView&) = delete;
+  LiveView& operator=(const LiveView&) = delete;
+  LiveView(LiveView&&) = delete;
+  LiveView& operator=(LiveView&&) = delete;
+
+  /**
+   * @brief Starts acquiring. A live view only runs once.
+   *
+   * @throw std::runtime_error if the live view was already started
+   */
+  void start() noexcept(false);
+
+  /**
+   * @brief Stops acquiring once the current acquisition is done.
+   */
+  void stop();
+
+  /**
+   * @brief Takes the newest frame, without waiting.
+   *
+   * @return The newest frame, nothing if it was already taken
+   *
+   * @throw std::exception the error that stopped the live view
+   */
+  std::optional<Frame> latest() noexcept(false);
+
+  /**
+   * @brief Waits for a frame newer than the last taken one.
+   *
+   * @param timeout Maximum time to wait
+   *
+   * @return The newest frame, nothing on timeout or once stopped
+   *
+   * @throw std::exception the error that stopped the live view
+   */
+  std::optional<Frame> wait_for_frame(
+      std::chrono::milliseconds timeout) noexcept(false);
+
+  /**
+   * @brief Counters and rates of the live view.
+   */
+  [[nodiscard]] Statistics statistics() const;
+
+ private:
+  // weight of the last frame interval in the smoothed frame rate
+  static constexpr double RATE_SMOOTHING = 0.2;
+
+  std::shared_ptr<ChargeCoupledDevice> ccd;
+  Options options;
+  TripleBuffer<Frame> buffer;
+
+  std::atomic<bool> started{false};
+  std::atomic<bool> stopping{false};
+  std::atomic<std::size_t> acquired{0};
+  std::atomic<std::size_t> taken{0};
+  std::atomic<std::size_t> dropped{0};
+  std::atomic<double> frame_interval_us{0.0};
+  std::atomic<long long> last_frame_age_us{0};
+
+  // wakes up the consumer waiting for a frame, the buffer itself is lock
+  // free
+  std::mutex mutex;
+  std::condition_variable frame_published;
+  bool finished{false};
+  std::exception_ptr error;
+  // serializes the consumers, the buffer has one reader
+  std::mutex reader_mutex;
+
+  std::thread acquisition_thread;
+
+  void acquire();
+  std::optional<Frame> take();
+  void rethrow_error();
+};
+
+} /* namespace horiba::devices::single_devices */
+
+#endif /* ifndef LIVE_VIEW_H */
@@ -3,8 +3,18 @@
 
 #include <horiba_cpp_sdk/communication/communicator.h>
 #include <horiba_cpp_sdk/devices/single_devices/device.h>
-
+#include <horiba_cpp_sdk/devices/single_devices/device_capabilities.h>
+#include <horiba_cpp_sdk/devices/single_devices/known_settings.h>
+
+#include <boost/asio/awaitable.hpp>
+#include <chrono>
+#include <cstddef>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <nlohmann/json.hpp>
+#include <optional>
 #include <string>
 
 namespace horiba::devices::single_devices {
@@ -76,6 +86,21 @@ class Monochromator final : public Device {
    */
   enum class Slit : int { A = 1, B = 2, C = 3, D = 4 };
 
+  /**
+   * @brief Settings of a monochromator. Settings without value are left as
+   * they are.
+   *
+   * Used both to describe the wanted settings, see apply(), and the settings
+   * last known to be set, see known_settings().
+   */
+  struct Profile {
+    std::optional<Grating> turret_grating;
+    std::optional<double> wavelength;
+    std::map<Mirror, MirrorPosition> mirror_positions;
+    std::map<Slit, double> slit_positions_in_mm;
+    std::map<FilterWheel, FilterWheelPosition> filter_wheel_positions;
+  };
+
   /**
    * @brief Opens the device.
    *
@@ -134,12 +159,58 @@ class Monochromator final : public Device {
   /**
    * @brief Returns the configuration of the monochromator.
    *
+   * The configuration is taken from the cached capabilities, see
+   * capabilities().
+   *
    * @return Configuration of the monochromator
    *
    * @throw std::runtime_error when an error occurred on the device side
    */
   nlohmann::json configuration() noexcept(false);
 
+  /**
+   * @brief Returns the capabilities of the monochromator, compiled from its
+   * configuration.
+   *
+   * They are fetched when the monochromator is opened and kept until it is
+   * closed, so that they need no round trip to the ICL.
+   *
+   * @return Capabilities of the monochromator
+   *
+   * @throw std::runtime_error when an error occurred on the device side
+   */
+  std::shared_ptr<const MonochromatorCapabilities> capabilities() noexcept(
+      false);
+
+  /**
+   * @brief Sets the capabilities from a configuration known beforehand, e.g.
+   * from a discovery cache, so that they are available without a round trip.
+   * Opening the monochromator keeps them if they belong to the monochromator
+   * with the listed serial number, otherwise it fetches them again.
+   *
+   * @param configuration The configuration of the monochromator
+   * @param listed_serial_number Serial number of the monochromator, as listed
+   * by the ICL
+   */
+  void preload_capabilities(const nlohmann::json& configuration,
+                            const std::string& listed_serial_number);
+
+  /**
+   * @brief Sets the function called with the configuration each time it is
+   * fetched from the ICL, e.g. to keep it in a discovery cache.
+   *
+   * @param listener Called outside of any lock of the monochromator
+   */
+  void set_capabilities_listener(CapabilitiesListener listener);
+
+  /**
+   * @brief Capabilities that are already known, without asking the ICL.
+   *
+   * @return The capabilities, nullptr if they have not been fetched yet
+   */
+  [[nodiscard]] std::shared_ptr<const MonochromatorCapabilities>
+  loaded_capabilities();
+
   /**
    * @brief Current wavelength of the monochromator's position in nm.
    *
@@ -316,12 +387,136 @@ class Monochromator final : public Device {
   /**
    * @brief Blocking waits until the monochromator is ready.
    *
+   * The monochromator is polled as decided by its wait strategy, see
+   * set_wait_strategy(). The travel of a wavelength move is the distance to
+   * the previous known wavelength.
+   *
    * @param timeout Maximum time, in seconds [s], to wait for the monochromator
    * to be ready.
    *
    * @throw std::runtime_error when the timeout is reached
    */
   void wait_until_ready(std::chrono::seconds timeout) noexcept(false);
+
+  /**
+   * @brief Settings last set through this object.
+   *
+   * They are forgotten when the monochromator is opened, closed or homed,
+   * when a command fails and when waiting for it to be ready fails.
+   *
+   * @return The known settings
+   */
+  Profile known_settings();
+
+  /**
+   * @brief Forgets the known settings, e.g. after the monochromator was moved
+   * by another program.
+   */
+  void forget_known_settings();
+
+  /**
+   * @brief Moves the monochromator to the settings of a profile, skipping the
+   * ones it is known to have already.
+   *
+   * The grating is moved first, then the wavelength, then the mirrors, slits
+   * and filter wheels. Each step waits until the monochromator is ready.
+   *
+   * @param profile The wanted settings
+   * @param timeout Maximum time to wait for the monochromator after each step
+   *
+   * @return The amount of commands sent
+   *
+   * @throw std::runtime_error when an error occurred on the device side or the
+   * timeout is reached
+   */
+  std::size_t apply(const Profile& profile,
+                    std::chrono::seconds timeout) noexcept(false);
+
+  /**
+   * @brief Awaitable version of is_busy().
+   *
+   * @return True if busy, false otherwise
+   *
+   * @throw std::runtime_error when an error occurred on the device side
+   */
+  boost::asio::awaitable<bool> is_busy_async() noexcept(false);
+
+  /**
+   * @brief Awaitable version of home().
+   *
+   * @param force_homing Force starts the initialization process.
+   *
+   * @throw std::runtime_error when an error occurred on the device side
+   */
+  boost::asio::awaitable<void> home_async(bool force_homing = false) noexcept(
+      false);
+
+  /**
+   * @brief Awaitable version of get_current_wavelength().
+   *
+   * @return current wavelength in nm
+   *
+   * @throw std::runtime_error when an error occurred on the device side
+   */
+  boost::asio::awaitable<double> get_current_wavelength_async() noexcept(
+      false);
+
+  /**
+   * @brief Awaitable version of move_to_target_wavelength().
+   *
+   * @param wavelength wavelength in nm
+   *
+   * @throw std::runtime_error when an error occurred on the device side
+   */
+  boost::asio::awaitable<void> move_to_target_wavelength_async(
+      double wavelength) noexcept(false);
+
+  /**
+   * @brief Awaitable version of set_turret_grating().
+   *
+   * @param grating The grating to select
+   *
+   * @throw std::runtime_error when an error occurred on the device side
+   */
+  boost::asio::awaitable<void> set_turret_grating_async(
+      Grating grating) noexcept(false);
+
+  /**
+   * @brief Awaitable version of wait_until_ready(). Waits on a timer of the
+   * executor of the coroutine instead of blocking the thread.
+   *
+   * @param timeout Maximum time, in seconds [s], to wait for the monochromator
+   * to be ready.
+   *
+   * @throw std::runtime_error when the timeout is reached
+   */
+  boost::asio::awaitable<void> wait_until_ready_async(
+      std::chrono::seconds timeout) noexcept(false);
+
+  [[nodiscard]] std::future<bool> request_busy() noexcept(false) override;
+
+  /**
+   * @brief Kind and distance of the moves ordered since the last wait, e.g.
+   * the distance in nm to the target wavelength. Moves of different kinds
+   * add up to a move of unknown distance.
+   */
+  [[nodiscard]] Travel take_pending_travel() override;
+
+ private:
+  std::mutex capabilities_mutex;
+  std::shared_ptr<const MonochromatorCapabilities> cached_capabilities;
+  // serial number the preloaded capabilities are checked against on open
+  std::optional<std::string> preloaded_serial_number;
+  CapabilitiesListener capabilities_listener;
+
+  KnownSettings<Profile> known;
+  // travel of the moves since the last wait, used by the wait strategy
+  std::mutex pending_travel_mutex;
+  std::optional<Travel> pending_travel;
+
+  void invalidate_capabilities();
+  void keep_preloaded_capabilities();
+  void note_travel(MoveKind kind, std::optional<double> distance);
 };
 }  // namespace horiba::devices::single_devices
 #endif /* ifndef MONO_H */
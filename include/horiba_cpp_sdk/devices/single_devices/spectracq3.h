@@ -3,8 +3,11 @@
 
 #include <horiba_cpp_sdk/communication/communicator.h>
 #include <horiba_cpp_sdk/devices/single_devices/device.h>
+#include <horiba_cpp_sdk/devices/single_devices/spectracq3_records.h>
 
+#include <boost/asio/awaitable.hpp>
 #include <chrono>
+#include <future>
 #include <memory>
 #include <nlohmann/json.hpp>
 #include <string>
@@ -255,8 +258,15 @@ class SpectrAcq3 final : public Device {
   /**
    * @brief Stops the current acquisition. The current data point is discarded.
    * The acquisition process must be checked and restarted if needed.
+   *
+   * The stop command is a priority command, see
+   * communication::CommunicatorPool: it is not held back by a data transfer
+   * in progress.
+   *
+   * @return The time from sending the stop command to its acknowledgment by
+   * the ICL.
    */
-  void acquisition_stop() noexcept(false);
+  std::chrono::microseconds acquisition_stop() noexcept(false);
 
   /**
    * @brief Pause active Acquisition. Current point is completed. Can be
@@ -293,6 +303,23 @@ class SpectrAcq3 final : public Device {
       std::unordered_set<Channel, Channel::Hash> channels =
           Channel::all_existing_channels) noexcept(false);
 
+  /**
+   * @brief Retrieve the acquired data that is available so far, decoded by
+   * column straight from the response text.
+   *
+   * Note: Once the acquired data is read, it will be removed from the
+   * device/software's data buffer.
+   *
+   * @param channels Bitmask of the channels to retrieve
+   *
+   * @return acquisition data
+   *
+   * @throw std::invalid_argument if no channel is requested or the data
+   * cannot be decoded
+   */
+  SpectrAcq3Records get_acquisition_records(
+      SpectrAcq3Channels channels = SpectrAcq3Channels::ALL) noexcept(false);
+
   /**
    * @brief Software Trigger, treated the same as Hardware Trigger (IN).
    *
@@ -337,6 +364,88 @@ class SpectrAcq3 final : public Device {
   std::string get_last_error() noexcept(false);
   std::string get_error_log() noexcept(false);
   void clear_error_log() noexcept(false);
+
+  /**
+   * @brief Awaitable version of is_busy().
+   *
+   * @return True if busy, false otherwise
+   */
+  boost::asio::awaitable<bool> is_busy_async() noexcept(false);
+
+  [[nodiscard]] std::future<bool> request_busy() noexcept(false) override;
+
+  /**
+   * @brief Awaitable version of acquisition_start().
+   *
+   * @param trigger
+   */
+  boost::asio::awaitable<void> acquisition_start_async(
+      SpectrAcq3::TriggerMode trigger) noexcept(false);
+
+  /**
+   * @brief Awaitable version of acquisition_stop().
+   */
+  boost::asio::awaitable<std::chrono::microseconds>
+  acquisition_stop_async() noexcept(false);
+
+  /**
+   * @brief Awaitable version of is_data_available().
+   *
+   * @return True if data is available, false otherwise.
+   */
+  boost::asio::awaitable<bool> is_data_available_async() noexcept(false);
+
+  /**
+   * @brief Awaitable version of get_acquisition_data().
+   *
+   * @return acquisition data
+   */
+  boost::asio::awaitable<nlohmann::json> get_acquisition_data_async(
+      std::unordered_set<Channel, Channel::Hash> channels =
+          Channel::all_existing_channels) noexcept(false);
+
+  /**
+   * @brief Awaitable version of get_acquisition_records().
+   *
+   * @return acquisition data
+   */
+  boost::asio::awaitable<SpectrAcq3Records> get_acquisition_records_async(
+      SpectrAcq3Channels channels = SpectrAcq3Channels::ALL) noexcept(false);
+
+  /**
+   * @brief Waits until the SpectrAcq3 is not busy anymore, polling it on a
+   * timer of the executor of the coroutine.
+   *
+   * @param timeout Maximum time to wait for the SpectrAcq3 to be ready
+   * @param poll_interval Time between two checks of the SpectrAcq3
+   *
+   * @throw std::runtime_error when the timeout is reached
+   */
+  boost::asio::awaitable<void> wait_until_ready_async(
+      std::chrono::milliseconds timeout,
+      std::chrono::milliseconds poll_interval) noexcept(false);
+
+  /**
+   * @brief Awaitable version of wait_until_ready().
+   *
+   * @param timeout Maximum time to wait for the SpectrAcq3 to be ready
+   *
+   * @throw std::runtime_error when the timeout is reached
+   */
+  boost::asio::awaitable<void> wait_until_ready_async(
+      std::chrono::milliseconds timeout) noexcept(false);
+
+  /**
+   * @brief Blocking waits until the SpectrAcq3 is not busy anymore.
+   *
+   * The SpectrAcq3 is polled as decided by its wait strategy, see
+   * set_wait_strategy().
+   *
+   * @param timeout Maximum time to wait for the SpectrAcq3 to be ready
+   *
+   * @throw std::runtime_error when the timeout is reached
+   */
+  void wait_until_ready(std::chrono::milliseconds timeout) noexcept(false);
 };
 }  // namespace horiba::devices::single_devices
 #endif /* ifndef SPECTRAC3_H */
@@ -0,0 +1,175 @@
+#ifndef SPECTRACQ3_RECORDS_H
+#define SPECTRACQ3_RECORDS_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace horiba::devices::single_devices {
+
+/**
+ * @brief Channels of a SpectrAcq3 as a bitmask, combined with |, e.g.
+ * SpectrAcq3Channels::CURRENT | SpectrAcq3Channels::VOLTAGE.
+ */
+enum class SpectrAcq3Channels : std::uint8_t {
+  NONE = 0,
+  CURRENT = 1U << 0U,
+  VOLTAGE = 1U << 1U,
+  PHOTON = 1U << 2U,
+  PPD = 1U << 3U,
+  ALL = CURRENT | VOLTAGE | PHOTON | PPD,
+};
+
+constexpr SpectrAcq3Channels operator|(SpectrAcq3Channels left,
+                                       SpectrAcq3Channels right) {
+  using Bits = std::underlying_type_t<SpectrAcq3Channels>;
+  return static_cast<SpectrAcq3Channels>(static_cast<Bits>(left) |
+                                         static_cast<Bits>(right));
+}
+
+constexpr SpectrAcq3Channels operator&(SpectrAcq3Channels left,
+                                       SpectrAcq3Channels right) {
+  using Bits = std::underlying_type_t<SpectrAcq3Channels>;
+  return static_cast<SpectrAcq3Channels>(static_cast<Bits>(left) &
+                                         static_cast<Bits>(right));
+}
+
+/**
+ * @brief Whether a bitmask contains all the given channels.
+ */
+constexpr bool has_channels(SpectrAcq3Channels channels,
+                            SpectrAcq3Channels wanted) {
+  return (channels & wanted) == wanted;
+}
+
+/**
+ * @brief One data point of a SpectrAcq3 acquisition. Signals of channels that
+ * were not requested are empty.
+ */
+struct SpectrAcq3Record {
+  std::int64_t point_number{0};
+  /**
+   * @brief Time since the start of the acquisition in ms.
+   */
+  double elapsed_time{0.0};
+  std::optional<double> current;
+  std::optional<double> voltage;
+  std::optional<double> photon;
+  std::optional<double> ppd;
+  bool event_marker{false};
+  bool overscale_current{false};
+  bool overscale_voltage{false};
+};
+
+/**
+ * @brief Data points of a SpectrAcq3, as returned by saq3_getAvailableData,
+ * stored by column: one contiguous array per requested channel, for the
+ * elapsed times and for the point numbers, and one bitset per flag.
+ *
+ * A point missing the signal of a requested channel holds NaN in its column.
+ * The unit of a channel is stored once, the unit strings are shared by all
+ * records.
+ */
+class SpectrAcq3Records {
+ public:
+  SpectrAcq3Records() = default;
+
+  /**
+   * @brief Decodes the data points directly from the raw text of the
+   * saq3_getAvailableData response, without building a JSON document.
+   *
+   * @param raw_response The JSON text of the response
+   * @param channels The requested channels
+   *
+   * @return The decoded data points
+   *
+   * @throw std::invalid_argument if the response cannot be decoded
+   */
+  static SpectrAcq3Records parse(std::string_view raw_response,
+                                 SpectrAcq3Channels channels) noexcept(false);
+
+  /**
+   * @brief Amount of data points.
+   */
+  [[nodiscard]] std::size_t size() const;
+
+  [[nodiscard]] bool empty() const;
+
+  /**
+   * @brief The requested channels.
+   */
+  [[nodiscard]] SpectrAcq3Channels channels() const;
+
+  [[nodiscard]] std::span<const std::int64_t> point_numbers() const;
+
+  /**
+   * @brief Times since the start of the acquisition in ms.
+   */
+  [[nodiscard]] std::span<const double> elapsed_times() const;
+
+  /**
+   * @brief Values of one channel, one per data point.
+   *
+   * @param channel The channel
+   *
+   * @return View on the values
+   *
+   * @throw std::invalid_argument if the channel is not one requested channel
+   */
+  [[nodiscard]] std::span<const double> values(
+      SpectrAcq3Channels channel) const noexcept(false);
+
+  /**
+   * @brief Unit of the values of one channel, e.g. "uAmps".
+   *
+   * @param channel The channel
+   *
+   * @return The unit, empty if the ICL sent none
+   *
+   * @throw std::invalid_argument if the channel is not one requested channel
+   */
+  [[nodiscard]] std::string_view unit(SpectrAcq3Channels channel) const
+      noexcept(false);
+
+  [[nodiscard]] const std::vector<bool>& event_markers() const;
+  [[nodiscard]] const std::vector<bool>& overscale_current() const;
+  [[nodiscard]] const std::vector<bool>& overscale_voltage() const;
+
+  /**
+   * @brief One data point.
+   *
+   * @param index The index of the data point
+   *
+   * @return The data point
+   *
+   * @throw std::out_of_range if the data point does not exist
+   */
+  [[nodiscard]] SpectrAcq3Record record(std::size_t index) const
+      noexcept(false);
+
+ private:
+  friend class SpectrAcq3RecordsParser;
+
+  static constexpr std::size_t CHANNEL_COUNT = 4;
+
+  SpectrAcq3Channels requested_channels{SpectrAcq3Channels::NONE};
+  std::vector<std::int64_t> points;
+  std::vector<double> elapsed;
+  std::array<std::vector<double>, CHANNEL_COUNT> channel_values;
+  std::array<std::string_view, CHANNEL_COUNT> channel_units;
+  std::vector<bool> event_marker_flags;
+  std::vector<bool> overscale_current_flags;
+  std::vector<bool> overscale_voltage_flags;
+
+  [[nodiscard]] std::size_t column(SpectrAcq3Channels channel) const
+      noexcept(false);
+};
+
+} /* namespace horiba::devices::single_devices */
+
+#endif /* ifndef SPECTRACQ3_RECORDS_H */
@@ -0,0 +1,151 @@
+#ifndef SPECTRACQ3_STREAM_H
+#define SPECTRACQ3_STREAM_H
+
+#include <horiba_cpp_sdk/devices/single_devices/spectracq3.h>
+#include <horiba_cpp_sdk/devices/single_devices/spectracq3_records.h>
+#include <horiba_cpp_sdk/devices/single_devices/spsc_ring.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+
+namespace horiba::devices::single_devices {
+
+/**
+ * @brief Drains the data of a SpectrAcq3 on a background thread, so that no
+ * data is lost when the client reads late: the device removes the data from
+ * its buffer once read.
+ *
+ * The interval between two fetches follows the observed data rate, aiming at
+ * a given amount of points per fetch. The records are pushed into a lock-free
+ * SpscRing: the consumer never blocks the drain, a full ring drops the new
+ * records and counts them as overflowed. Missing point numbers are counted as
+ * gaps. One thread consumes the records at a time.
+ */
+class SpectrAcq3Stream {
+ public:
+  struct Options {
+    /**
+     * @brief Minimum amount of records the ring holds.
+     */
+    std::size_t capacity{4096};
+    /**
+     * @brief Amount of points fetched at once the fetch interval aims at.
+     */
+    std::size_t points_per_fetch{32};
+    std::chrono::milliseconds min_interval{std::chrono::milliseconds(5)};
+    std::chrono::milliseconds max_interval{std::chrono::milliseconds(500)};
+  };
+
+  struct Statistics {
+    std::size_t fetches{0};
+    std::size_t records{0};
+    /**
+     * @brief Records dropped because the ring was full.
+     */
+    std::size_t overflowed_records{0};
+    /**
+     * @brief Point numbers skipped by the data of the device.
+     */
+    std::size_t missing_points{0};
+    /**
+     * @brief Amount of places where point numbers were skipped.
+     */
+    std::size_t gaps{0};
+    /**
+     * @brief Observed data rate in points per second.
+     */
+    double points_per_second{0.0};
+    std::chrono::microseconds fetch_interval{0};
+  };
+
+  /**
+   * @param spectracq3 The opened SpectrAcq3
+   * @param options Options of the stream
+   * @param channels Bitmask of the channels to fetch
+   *
+   * @throw std::invalid_argument if the SpectrAcq3 is null, no channel is
+   * requested or the intervals are not ordered
+   */
+  SpectrAcq3Stream(std::shared_ptr<SpectrAcq3> spectracq3, Options options,
+                   SpectrAcq3Channels channels = SpectrAcq3Channels::ALL)
+      noexcept(false);
+  ~SpectrAcq3Stream();
+
+  SpectrAcq3Stream(const SpectrAcq3Stream&) = delete;
+  SpectrAcq3Stream& operator=(const SpectrAcq3Stream&) = delete;
+  SpectrAcq3Stream(SpectrAcq3Stream&&) = delete;
+  SpectrAcq3Stream& operator=(SpectrAcq3Stream&&) = delete;
+
+  /**
+   * @brief Starts draining. A stream only runs once.
+   *
+   * @throw std::runtime_error if the stream was already started
+   */
+  void start() noexcept(false);
+
+  /**
+   * @brief Fetches the data left on the device one last time and stops
+   * draining.
+   */
+  void stop();
+
+  /**
+   * @brief Pops the oldest record, without waiting.
+   *
+   * @return The record, nothing if none is drained yet
+   *
+   * @throw std::exception the error that stopped the drain, once the records
+   * drained before it are popped
+   */
+  std::optional<SpectrAcq3Record> try_pop() noexcept(false);
+
+  /**
+   * @brief Counters of the stream.
+   */
+  [[nodiscard]] Statistics statistics() const;
+
+ private:
+  // weight of the last fetch in the observed data rate
+  static constexpr double RATE_SMOOTHING = 0.3;
+
+  std::shared_ptr<SpectrAcq3> spectracq3;
+  Options options;
+  SpectrAcq3Channels channels;
+  SpscRing<SpectrAcq3Record> ring;
+
+  std::atomic<bool> started{false};
+  std::atomic<std::size_t> fetches{0};
+  std::atomic<std::size_t> records{0};
+  std::atomic<std::size_t> overflowed{0};
+  std::atomic<std::size_t> missing_points{0};
+  std::atomic<std::size_t> gaps{0};
+  std::atomic<double> points_per_second{0.0};
+  std::atomic<long long> interval_us{0};
+  // only used by the drain thread
+  std::optional<std::int64_t> next_point;
+
+  std::mutex mutex;
+  std::condition_variable stop_requested;
+  bool stopping{false};
+  std::atomic<bool> failed{false};
+  std::exception_ptr error;
+
+  std::thread drain_thread;
+
+  void drain();
+  std::size_t fetch();
+  std::chrono::microseconds next_interval(std::size_t points,
+                                          std::chrono::microseconds elapsed);
+};
+
+} /* namespace horiba::devices::single_devices */
+
+#endif /* ifndef SPECTRACQ3_STREAM_H */
@@ -0,0 +1,96 @@
+#ifndef SPSC_RING_H
+#define SPSC_RING_H
+
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace horiba::devices::single_devices {
+
+/**
+ * @brief Bounded lock-free queue between one producer thread and one consumer
+ * thread. Neither side ever waits: pushing to a full ring fails instead.
+ *
+ * @tparam T The type of the values, default constructible and movable
+ */
+template <typename T>
+class SpscRing {
+ public:
+  /**
+   * @param capacity Minimum amount of values the ring holds, rounded up to a
+   * power of two
+   *
+   * @throw std::invalid_argument if the capacity is 0
+   */
+  explicit SpscRing(std::size_t capacity) {
+    if (capacity == 0) {
+      throw std::invalid_argument("capacity must be at least 1");
+    }
+    this->slots.resize(std::bit_ceil(capacity));
+    this->mask = this->slots.size() - 1;
+  }
+
+  /**
+   * @brief Pushes a value, only called by the producer.
+   *
+   * @param value The value
+   *
+   * @return False if the ring is full, the value is then not pushed
+   */
+  bool try_push(T value) {
+    const auto tail = this->tail.load(std::memory_order_relaxed);
+    if (tail - this->head.load(std::memory_order_acquire) ==
+        this->slots.size()) {
+      return false;
+    }
+    this->slots[tail & this->mask] = std::move(value);
+    this->tail.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * @brief Pops the oldest value, only called by the consumer.
+   *
+   * @return The value, nothing if the ring is empty
+   */
+  std::optional<T> try_pop() {
+    const auto head = this->head.load(std::memory_order_relaxed);
+    if (head == this->tail.load(std::memory_order_acquire)) {
+      return std::nullopt;
+    }
+    auto value = std::move(this->slots[head & this->mask]);
+    this->head.store(head + 1, std::memory_order_release);
+    return value;
+  }
+
+  /**
+   * @brief Amount of values in the ring, only exact when called by the
+   * producer or the consumer while the other is idle.
+   */
+  [[nodiscard]] std::size_t size() const {
+    return this->tail.load(std::memory_order_acquire) -
+           this->head.load(std::memory_order_acquire);
+  }
+
+  [[nodiscard]] std::size_t capacity() const { return this->slots.size(); }
+
+ private:
+  // keeps the indices of the producer and the consumer on their own cache
+  // lines
+  static constexpr std::size_t CACHE_LINE = 64;
+
+  std::vector<T> slots;
+  std::size_t mask{0};
+  // next value to pop, written by the consumer
+  alignas(CACHE_LINE) std::atomic<std::size_t> head{0};
+  // next value to push, written by the producer
+  alignas(CACHE_LINE) std::atomic<std::size_t> tail{0};
+};
+
+} /* namespace horiba::devices::single_devices */
+
+#endif /* ifndef SPSC_RING_H */
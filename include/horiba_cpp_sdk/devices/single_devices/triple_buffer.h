@@ -0,0 +1,79 @@
+#ifndef TRIPLE_BUFFER_H
+#define TRIPLE_BUFFER_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <optional>
+#include <utility>
+
+namespace horiba::devices::single_devices {
+
+/**
+ * @brief Hands the latest value from one writer thread to one reader thread
+ * without locks and without either waiting for the other.
+ *
+ * The writer fills its own slot and swaps it with the shared middle slot, the
+ * reader swaps its own slot with the middle slot when it holds a value not
+ * read yet. A value overwritten in the middle slot before being read is
+ * dropped.
+ *
+ * @tparam T The type of the values, default constructible and movable
+ */
+template <typename T>
+class TripleBuffer {
+ public:
+  /**
+   * @brief Publishes a value, only called by the writer.
+   *
+   * @param value The value
+   *
+   * @return True if the value replaced one that was never read
+   */
+  bool publish(T value) {
+    this->slots[this->back] = std::move(value);
+    const auto previous =
+        this->middle.exchange(static_cast<std::uint8_t>(this->back | FRESH),
+                              std::memory_order_acq_rel);
+    this->back = static_cast<std::uint8_t>(previous & INDEX);
+    return (previous & FRESH) != 0;
+  }
+
+  /**
+   * @brief Takes the latest value, only called by the reader.
+   *
+   * @return The latest value, nothing if it was already read
+   */
+  std::optional<T> take() {
+    if ((this->middle.load(std::memory_order_acquire) & FRESH) == 0) {
+      return std::nullopt;
+    }
+    const auto previous =
+        this->middle.exchange(this->front, std::memory_order_acq_rel);
+    this->front = static_cast<std::uint8_t>(previous & INDEX);
+    return std::move(this->slots[this->front]);
+  }
+
+  /**
+   * @brief Whether a value was published and not read yet.
+   */
+  [[nodiscard]] bool fresh() const {
+    return (this->middle.load(std::memory_order_acquire) & FRESH) != 0;
+  }
+
+ private:
+  static constexpr std::uint8_t INDEX = 0b011;
+  static constexpr std::uint8_t FRESH = 0b100;
+
+  std::array<T, 3> slots{};
+  // index of the middle slot, with the FRESH bit while it is not read
+  std::atomic<std::uint8_t> middle{1};
+  // owned by the writer
+  std::uint8_t back{0};
+  // owned by the reader
+  std::uint8_t front{2};
+};
+
+} /* namespace horiba::devices::single_devices */
+
+#endif /* ifndef TRIPLE_BUFFER_H */
@@ -0,0 +1,95 @@
+#ifndef WAIT_SET_H
+#define WAIT_SET_H
+
+#include <horiba_cpp_sdk/devices/single_devices/device.h>
+#include <horiba_cpp_sdk/devices/single_devices/wait_strategy.h>
+
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace horiba::devices::single_devices {
+
+/**
+ * @brief Waits for many devices to be ready with one poll loop.
+ *
+ * Each round sends the busy query of every device still waited for before
+ * reading any answer, so a round costs about one round trip to the ICL
+ * whatever the amount of devices. Devices can be of any kind, e.g.
+ * monochromators moving while a CCD acquires:
+ *
+ *     WaitSet waits;
+ *     waits.add(mono1).add(mono2).add(ccd);
+ *     waits.wait_all(std::chrono::seconds(10));
+ *
+ * Each device asks its own wait strategy for the delay until its next poll,
+ * from its own travel, and the next round comes after the shortest of them.
+ * The time a device took to be ready is recorded in its own wait strategy.
+ * The devices still busy when wait_any() returns keep their travel and the
+ * start of their wait for the next wait of the set. A wait set is used by one
+ * thread at a time.
+ */
+class WaitSet {
+ public:
+  /**
+   * @brief Adds a device to wait for. Adding a device twice has no effect.
+   *
+   * @param device The device
+   *
+   * @return This wait set
+   *
+   * @throw std::invalid_argument if the device is null
+   */
+  WaitSet& add(std::shared_ptr<Device> device) noexcept(false);
+
+  /**
+   * @brief Amount of devices waited for.
+   */
+  [[nodiscard]] std::size_t size() const;
+
+  /**
+   * @brief Waits until at least one device is ready.
+   *
+   * @param timeout Maximum time to wait
+   *
+   * @return The devices found ready in the same poll round, never empty
+   *
+   * @throw std::runtime_error when the timeout is reached
+   */
+  std::vector<std::shared_ptr<Device>> wait_any(
+      std::chrono::microseconds timeout) noexcept(false);
+
+  /**
+   * @brief Waits until all devices are ready. Devices already ready are not
+   * polled anymore.
+   *
+   * @param timeout Maximum time to wait
+   *
+   * @throw std::runtime_error when the timeout is reached
+   */
+  void wait_all(std::chrono::microseconds timeout) noexcept(false);
+
+ private:
+  struct Waiting {
+    std::shared_ptr<Device> device;
+    std::shared_ptr<WaitStrategy> strategy;
+    Travel travel;
+    std::chrono::steady_clock::time_point started;
+    std::size_t polls{0};
+    // taken over from an earlier wait and not seen busy since, when it got
+    // ready is unknown
+    bool resumed{false};
+  };
+
+  std::vector<std::shared_ptr<Device>> devices;
+  // devices still busy when the last wait returned
+  std::vector<Waiting> unfinished;
+
+  std::vector<std::shared_ptr<Device>> wait(std::chrono::microseconds timeout,
+                                            bool all);
+};
+
+} /* namespace horiba::devices::single_devices */
+
+#endif /* ifndef WAIT_SET_H */
@@ -0,0 +1,253 @@
+#ifndef WAIT_STRATEGY_H
+#define WAIT_STRATEGY_H
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+
+#include <boost/asio/awaitable.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/asio/this_coro.hpp>
+#include <boost/asio/use_awaitable.hpp>
+
+namespace horiba::devices::single_devices {
+
+/**
+ * @brief Kind of move a device makes until it is ready. Moves of different
+ * kinds take different times, e.g. a grating change takes seconds where a
+ * slit moves in a fraction of a second.
+ */
+enum class MoveKind : std::size_t {
+  OTHER,
+  WAVELENGTH,
+  GRATING,
+  MIRROR,
+  SLIT,
+  FILTER_WHEEL,
+  ACQUISITION,
+};
+
+/**
+ * @brief How far a device moves until it is ready.
+ */
+struct Travel {
+  MoveKind kind{MoveKind::OTHER};
+  /**
+   * @brief Distance of the move, e.g. in nm between two wavelengths of a
+   * monochromator, nothing if unknown.
+   */
+  std::optional<double> distance;
+};
+
+/**
+ * @brief Decides how long to wait between two polls of a busy device.
+ */
+class WaitStrategy {
+ public:
+  virtual ~WaitStrategy() = default;
+
+  /**
+   * @brief Time to wait before polling the device.
+   *
+   * @param poll Number of the poll, 0 for the first one
+   * @param travel How far the device moves
+   *
+   * @return The time to wait
+   */
+  [[nodiscard]] virtual std::chrono::microseconds delay(
+      std::size_t poll, const Travel& travel) = 0;
+
+  /**
+   * @brief Records how long a wait took until the device was ready.
+   *
+   * @param travel How far the device moved
+   * @param duration Time until the device was ready
+   */
+  virtual void record(const Travel& /*travel*/,
+                      std::chrono::microseconds /*duration*/) {}
+};
+
+/**
+ * @brief Polls at a fixed interval.
+ */
+class FixedIntervalWait final : public WaitStrategy {
+ public:
+  explicit FixedIntervalWait(std::chrono::microseconds interval);
+
+  [[nodiscard]] std::chrono::microseconds delay(
+      std::size_t poll, const Travel& travel) override;
+
+ private:
+  std::chrono::microseconds interval;
+};
+
+/**
+ * @brief Polls soon after the start, then less and less often.
+ */
+class ExponentialBackoffWait final : public WaitStrategy {
+ public:
+  /**
+   * @param first_delay Time to wait before the first poll
+   * @param factor Factor between two successive delays
+   * @param max_delay Longest time to wait between two polls
+   */
+  explicit ExponentialBackoffWait(
+      std::chrono::microseconds first_delay = std::chrono::milliseconds(5),
+      double factor = 2.0,
+      std::chrono::microseconds max_delay = std::chrono::milliseconds(250));
+
+  [[nodiscard]] std::chrono::microseconds delay(
+      std::size_t poll, const Travel& travel) override;
+
+ private:
+  std::chrono::microseconds first_delay;
+  double factor;
+  std::chrono::microseconds max_delay;
+};
+
+/**
+ * @brief Predicts the duration of a wait from the past waits of the device,
+ * fitting the duration linearly to the travel, and sleeps through most of it
+ * before the first poll. Backs off exponentially afterwards, or from the
+ * start as long as there is no past wait to predict from.
+ *
+ * Each kind of move has its own past waits. Waits whose distance is unknown
+ * are neither predicted nor recorded.
+ */
+class PredictiveWait final : public WaitStrategy {
+ public:
+  /**
+   * @param backoff Delays used after the first poll or without prediction
+   * @param history Amount of past waits the prediction is fitted to
+   */
+  explicit PredictiveWait(
+      ExponentialBackoffWait backoff = ExponentialBackoffWait(),
+      std::size_t history = 32);
+
+  [[nodiscard]] std::chrono::microseconds delay(
+      std::size_t poll, const Travel& travel) override;
+
+  void record(const Travel& travel,
+              std::chrono::microseconds duration) override;
+
+  /**
+   * @brief Predicted duration of a wait.
+   *
+   * @param travel How far the device moves
+   *
+   * @return The predicted duration, nothing if the distance is unknown or
+   * there is no past wait of the same kind
+   */
+  [[nodiscard]] std::optional<std::chrono::microseconds> predict(
+      const Travel& travel) const;
+
+ private:
+  // part of the predicted duration slept through before the first poll
+  static constexpr double PREDICTION_SHARE = 0.9;
+  static constexpr std::size_t MOVE_KINDS =
+      static_cast<std::size_t>(MoveKind::ACQUISITION) + 1;
+
+  struct Sample {
+    double travel;
+    double duration_us;
+  };
+
+  ExponentialBackoffWait backoff;
+  std::size_t history;
+  mutable std::mutex mutex;
+  std::array<std::deque<Sample>, MOVE_KINDS> samples;
+};
+
+/**
+ * @brief Polls a device with the delays of a strategy until it is not busy
+ * anymore, and records the wait in the strategy.
+ *
+ * @param strategy The strategy deciding the delays
+ * @param busy Callable returning whether the device is busy
+ * @param timeout Maximum time to wait
+ * @param travel How far the device moves
+ * @param timeout_message Message of the exception thrown on timeout
+ *
+ * @return Time until the device was ready
+ *
+ * @throw std::runtime_error when the timeout is reached
+ */
+template <typename Busy>
+std::chrono::microseconds wait_until_idle(
+    const std::shared_ptr<WaitStrategy>& strategy, Busy&& busy,
+    std::chrono::microseconds timeout, const Travel& travel,
+    const std::string& timeout_message) {
+  const auto started = std::chrono::steady_clock::now();
+  const auto deadline = started + timeout;
+  for (std::size_t poll = 0;; poll++) {
+    const auto wake_up = std::min(
+        std::chrono::steady_clock::now() + strategy->delay(poll, travel),
+        deadline);
+    std::this_thread::sleep_until(wake_up);
+    if (!busy()) {
+      break;
+    }
+    if (std::chrono::steady_clock::now() >= deadline) {
+      throw std::runtime_error(timeout_message);
+    }
+  }
+
+  const auto duration = std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - started);
+  strategy->record(travel, duration);
+  return duration;
+}
+
+/**
+ * @brief Awaitable version of wait_until_idle(), waiting on a timer of the
+ * executor of the coroutine.
+ *
+ * @param strategy The strategy deciding the delays
+ * @param busy Callable returning an awaitable of whether the device is busy
+ * @param timeout Maximum time to wait
+ * @param travel How far the device moves
+ * @param timeout_message Message of the exception thrown on timeout
+ *
+ * @return Time until the device was ready
+ *
+ * @throw std::runtime_error when the timeout is reached
+ */
+template <typename Busy>
+boost::asio::awaitable<std::chrono::microseconds> wait_until_idle_async(
+    std::shared_ptr<WaitStrategy> strategy, Busy busy,
+    std::chrono::microseconds timeout, Travel travel,
+    std::string timeout_message) {
+  boost::asio::steady_timer timer{co_await boost::asio::this_coro::executor};
+  const auto started = std::chrono::steady_clock::now();
+  const auto deadline = started + timeout;
+  for (std::size_t poll = 0;; poll++) {
+    timer.expires_at(std::min(
+        std::chrono::steady_clock::now() + strategy->delay(poll, travel),
+        deadline));
+    co_await timer.async_wait(boost::asio::use_awaitable);
+    if (!co_await busy()) {
+      break;
+    }
+    if (std::chrono::steady_clock::now() >= deadline) {
+      throw std::runtime_error(timeout_message);
+    }
+  }
+
+  const auto duration = std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - started);
+  strategy->record(travel, duration);
+  co_return duration;
+}
+
+} /* namespace horiba::devices::single_devices */
+
+#endif /* ifndef WAIT_STRATEGY_H */
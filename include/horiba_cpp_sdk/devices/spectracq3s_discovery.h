@@ -40,9 +40,17 @@ class SpectrAcq3sDiscovery : public DeviceDiscovery {
   [[nodiscard]] std::vector<std::shared_ptr<single_devices::SpectrAcq3>>
   spectracq3s() const;
 
+  /**
+   * @brief The "devices" list returned by the ICL during the discovery.
+   *
+   * @return The listed devices
+   */
+  [[nodiscard]] nlohmann::json devices_list() const;
+
  private:
   std::shared_ptr<horiba::communication::Communicator> communicator;
   std::vector<std::shared_ptr<single_devices::SpectrAcq3>> saq3s;
+  nlohmann::json listed_devices = nlohmann::json::array();
 
   std::vector<std::shared_ptr<single_devices::SpectrAcq3>> parse_saq3s(
       nlohmann::json raw_saq3s);
@@ -0,0 +1,136 @@
+#ifndef SWEEP_SCAN_H
+#define SWEEP_SCAN_H
+
+#include <horiba_cpp_sdk/devices/single_devices/mono.h>
+#include <horiba_cpp_sdk/devices/single_devices/spectracq3.h>
+#include <horiba_cpp_sdk/devices/single_devices/spectracq3_records.h>
+
+#include <chrono>
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace horiba::devices {
+
+/**
+ * @brief Scans a wavelength range with a SpectrAcq3 while the monochromator
+ * moves through it without stopping.
+ *
+ * One time based acquisition of the SpectrAcq3 runs during the whole sweep.
+ * Meanwhile the position of the monochromator is sampled with the time it
+ * was read, and each data point is placed at the wavelength the
+ * monochromator passed at its elapsed time. The density of the points is
+ * limited by the time step of the acquisition instead of the commands sent
+ * per point by a point by point scan.
+ *
+ * The wavelengths are as precise as the samples: a point between two samples
+ * is interpolated linearly, the time of a sample is known to half a round
+ * trip to the ICL.
+ */
+class SweepScan {
+ public:
+  struct Options {
+    double start_wavelength{0.0};
+    double end_wavelength{0.0};
+    /**
+     * @brief Maximum amount of data points. The acquisition is stopped when
+     * the monochromator reached the end of the range.
+     */
+    int scan_count{0};
+    /**
+     * @brief Time between two data points in seconds.
+     */
+    double time_step{0.0};
+    /**
+     * @brief Integration time of a data point in seconds, at most the time
+     * step.
+     */
+    double integration_time{0.0};
+    int external_param{0};
+    single_devices::SpectrAcq3Channels channels{
+        single_devices::SpectrAcq3Channels::ALL};
+    /**
+     * @brief Time between two reads of the monochromator position.
+     */
+    std::chrono::milliseconds position_interval{
+        std::chrono::milliseconds(20)};
+    /**
+     * @brief Maximum time of the sweep and of the move to its start.
+     */
+    std::chrono::seconds move_timeout{std::chrono::seconds(180)};
+  };
+
+  /**
+   * @brief Wavelength of the monochromator at a time of the acquisition.
+   */
+  struct PositionSample {
+    /**
+     * @brief Time since the start of the acquisition in ms, like the elapsed
+     * time of the data points.
+     */
+    double elapsed_time{0.0};
+    double wavelength{0.0};
+  };
+
+  struct Result {
+    single_devices::SpectrAcq3Records records;
+    /**
+     * @brief Wavelength of each data point in nm.
+     */
+    std::vector<double> wavelengths;
+    std::vector<PositionSample> positions;
+    std::chrono::microseconds duration{0};
+  };
+
+  /**
+   * @param saq3 The opened SpectrAcq3
+   * @param mono The opened monochromator in front of the detector of the
+   * SpectrAcq3
+   * @param options Options of the scan
+   *
+   * @throw std::invalid_argument if a device is null, the range is empty or
+   * the acquisition set is invalid
+   */
+  SweepScan(std::shared_ptr<single_devices::SpectrAcq3> saq3,
+            std::shared_ptr<single_devices::Monochromator> mono,
+            Options options) noexcept(false);
+
+  /**
+   * @brief Moves the monochromator to the start of the range, then sweeps it
+   * to the end while the SpectrAcq3 acquires.
+   *
+   * @return The data points and their wavelengths
+   *
+   * @throw std::runtime_error when an error occurred on the device side or the
+   * timeout is reached
+   */
+  Result run() noexcept(false);
+
+  /**
+   * @brief Places times on the path of the monochromator. Before the first
+   * sample the monochromator is at the first position, after the last sample
+   * at the last position.
+   *
+   * @param positions Samples of the path, in increasing time
+   * @param elapsed_times Times since the start of the acquisition in ms
+   *
+   * @return The wavelength at each time
+   *
+   * @throw std::invalid_argument if there is no sample
+   */
+  static std::vector<double> wavelengths_at(
+      const std::vector<PositionSample>& positions,
+      std::span<const double> elapsed_times) noexcept(false);
+
+ private:
+  std::shared_ptr<single_devices::SpectrAcq3> saq3;
+  std::shared_ptr<single_devices::Monochromator> mono;
+  Options options;
+
+  std::vector<PositionSample> sweep(
+      std::chrono::steady_clock::time_point acquisition_started);
+};
+
+} /* namespace horiba::devices */
+
+#endif /* ifndef SWEEP_SCAN_H */
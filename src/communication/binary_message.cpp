@@ -0,0 +1,86 @@
+#include "horiba_cpp_sdk/communication/binary_message.h"
+
+#include <utility>
+
+namespace horiba::communication {
+
+BinaryMessageType default_binary_message_classifier(
+    std::span<const std::byte> frame) {
+  if (frame.empty()) {
+    return BinaryMessageType::UNKNOWN;
+  }
+
+  const auto tag = std::to_integer<std::uint8_t>(frame.front());
+  switch (tag) {
+    case static_cast<std::uint8_t>(BinaryMessageType::LOG):
+      return BinaryMessageType::LOG;
+    case static_cast<std::uint8_t>(BinaryMessageType::INFORMATION):
+      return BinaryMessageType::INFORMATION;
+    case static_cast<std::uint8_t>(BinaryMessageType::DATA):
+      return BinaryMessageType::DATA;
+    default:
+      return BinaryMessageType::UNKNOWN;
+  }
+}
+
+BinaryMessage::BinaryMessage(BinaryMessageType type,
+                             boost::beast::flat_buffer buffer)
+    : message_type{type}, buffer{std::move(buffer)} {}
+
+BinaryMessageType BinaryMessage::type() const { return this->message_type; }
+
+std::span<const std::byte> BinaryMessage::data() const {
+  const auto content = this->buffer.data();
+  return {static_cast<const std::byte*>(content.data()), content.size()};
+}
+
+std::size_t BinaryMessage::size() const { return this->buffer.size(); }
+
+BinaryMessageQueue::BinaryMessageQueue(std::size_t capacity)
+    : capacity{capacity} {}
+
+void BinaryMessageQueue::push(std::shared_ptr<const BinaryMessage> message) {
+  {
+    const std::lock_guard<std::mutex> lock(this->mutex);
+    if (this->capacity > 0 && this->messages.size() >= this->capacity) {
+      this->messages.pop_front();
+      this->dropped_messages++;
+    }
+    this->messages.push_back(std::move(message));
+  }
+  this->message_available.notify_one();
+}
+
+std::shared_ptr<const BinaryMessage> BinaryMessageQueue::try_pop() {
+  const std::lock_guard<std::mutex> lock(this->mutex);
+  if (this->messages.empty()) {
+    return nullptr;
+  }
+  auto message = std::move(this->messages.front());
+  this->messages.pop_front();
+  return message;
+}
+
+std::shared_ptr<const BinaryMessage> BinaryMessageQueue::wait_and_pop(
+    std::chrono::milliseconds timeout) {
+  std::unique_lock<std::mutex> lock(this->mutex);
+  if (!this->message_available.wait_for(
+          lock, timeout, [this] { return !this->messages.empty(); })) {
+    return nullptr;
+  }
+  auto message = std::move(this->messages.front());
+  this->messages.pop_front();
+  return message;
+}
+
+std::size_t BinaryMessageQueue::size() {
+  const std::lock_guard<std::mutex> lock(this->mutex);
+  return this->messages.size();
+}
+
+std::size_t BinaryMessageQueue::dropped() {
+  const std::lock_guard<std::mutex> lock(this->mutex);
+  return this->dropped_messages;
+}
+
+} /* namespace horiba::communication */
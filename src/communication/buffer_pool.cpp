@@ -0,0 +1,34 @@
+#include "horiba_cpp_sdk/communication/buffer_pool.h"
+
+#include <utility>
+
+namespace horiba::communication {
+
+BufferPool::BufferPool(std::size_t max_buffers) : max_buffers{max_buffers} {
+  this->buffers.reserve(max_buffers);
+}
+
+std::string BufferPool::acquire() {
+  const std::lock_guard<std::mutex> lock(this->mutex);
+  if (this->buffers.empty()) {
+    return {};
+  }
+  std::string buffer = std::move(this->buffers.back());
+  this->buffers.pop_back();
+  return buffer;
+}
+
+void BufferPool::release(std::string buffer) {
+  buffer.clear();
+  const std::lock_guard<std::mutex> lock(this->mutex);
+  if (this->buffers.size() < this->max_buffers) {
+    this->buffers.push_back(std::move(buffer));
+  }
+}
+
+std::size_t BufferPool::size() {
+  const std::lock_guard<std::mutex> lock(this->mutex);
+  return this->buffers.size();
+}
+
+} /* namespace horiba::communication */
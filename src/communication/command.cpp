@@ -1,16 +1,142 @@
 #include "horiba_cpp_sdk/communication/command.h"
 
+#include <array>
 #include <atomic>
+#include <charconv>
+#include <cmath>
 #include <nlohmann/json.hpp>
 #include <string>
+#include <string_view>
 #include <utility>
 
 namespace horiba::communication {
 
+namespace {
+template <typename Number>
+void append_number(std::string& buffer, Number number) {
+  std::array<char, 32> digits{};
+  const auto [end, _error] =
+      std::to_chars(digits.data(), digits.data() + digits.size(), number);
+  buffer.append(digits.data(), end);
+}
+
+void append_float(std::string& buffer, double number) {
+  // same as nlohmann::json::dump()
+  if (!std::isfinite(number)) {
+    buffer += "null";
+    return;
+  }
+
+  const auto start = buffer.size();
+  append_number(buffer, number);
+  const std::string_view written{buffer.data() + start, buffer.size() - start};
+  if (written.find_first_of(".e") == std::string_view::npos) {
+    buffer += ".0";
+  }
+}
+
+void append_string(std::string& buffer, std::string_view text) {
+  static constexpr std::string_view HEX_DIGITS = "0123456789abcdef";
+
+  buffer += '"';
+  for (const char character : text) {
+    switch (character) {
+      case '"':
+        buffer += "\\\"";
+        break;
+      case '\\':
+        buffer += "\\\\";
+        break;
+      case '\b':
+        buffer += "\\b";
+        break;
+      case '\f':
+        buffer += "\\f";
+        break;
+      case '\n':
+        buffer += "\\n";
+        break;
+      case '\r':
+        buffer += "\\r";
+        break;
+      case '\t':
+        buffer += "\\t";
+        break;
+      default:
+        if (static_cast<unsigned char>(character) < 0x20) {
+          const auto code = static_cast<unsigned char>(character);
+          buffer += "\\u00";
+          buffer += HEX_DIGITS[code >> 4U];
+          buffer += HEX_DIGITS[code & 0x0FU];
+        } else {
+          buffer += character;
+        }
+        break;
+    }
+  }
+  buffer += '"';
+}
+
+void append_json(std::string& buffer, const nlohmann::json& value) {
+  switch (value.type()) {
+    case nlohmann::json::value_t::object: {
+      buffer += '{';
+      bool first = true;
+      for (auto element = value.cbegin(); element != value.cend(); ++element) {
+        if (!first) {
+          buffer += ',';
+        }
+        first = false;
+        append_string(buffer, element.key());
+        buffer += ':';
+        append_json(buffer, element.value());
+      }
+      buffer += '}';
+      break;
+    }
+    case nlohmann::json::value_t::array: {
+      buffer += '[';
+      bool first = true;
+      for (const auto& element : value) {
+        if (!first) {
+          buffer += ',';
+        }
+        first = false;
+        append_json(buffer, element);
+      }
+      buffer += ']';
+      break;
+    }
+    case nlohmann::json::value_t::string:
+      append_string(buffer, value.get_ref<const std::string&>());
+      break;
+    case nlohmann::json::value_t::boolean:
+      buffer += value.get<bool>() ? "true" : "false";
+      break;
+    case nlohmann::json::value_t::number_integer:
+      append_number(buffer, value.get<nlohmann::json::number_integer_t>());
+      break;
+    case nlohmann::json::value_t::number_unsigned:
+      append_number(buffer, value.get<nlohmann::json::number_unsigned_t>());
+      break;
+    case nlohmann::json::value_t::number_float:
+      append_float(buffer, value.get<nlohmann::json::number_float_t>());
+      break;
+    case nlohmann::json::value_t::null:
+    case nlohmann::json::value_t::discarded:
+      buffer += "null";
+      break;
+    case nlohmann::json::value_t::binary:
+      buffer += value.dump();
+      break;
+  }
+}
+}  // namespace
+
 std::atomic<unsigned long long int> Command::next_id{0};
 
 Command::Command(std::string command, nlohmann::json parameters)
-    : id{this->next_id++},
+    : command_id{this->next_id++},
       command{std::move(command)},
       // we cannot use braces {} here, as the library transforms the json into a
       // list. see:
@@ -18,8 +144,27 @@ Command::Command(std::string command, nlohmann::json parameters)
       parameters(std::move(parameters)) {}
 
 nlohmann::json Command::json() const {
-  return {{"id", this->id},
+  return {{"id", this->command_id},
           {"command", this->command},
           {"parameters", this->parameters}};
 }
+
+void Command::serialize(std::string& buffer) const {
+  buffer.clear();
+  buffer += R"({"id":)";
+  append_number(buffer, this->command_id);
+  buffer += R"(,"command":)";
+  append_string(buffer, this->command);
+  buffer += R"(,"parameters":)";
+  append_json(buffer, this->parameters);
+  buffer += '}';
+}
+
+unsigned long long int Command::id() const { return this->command_id; }
+
+const std::string& Command::name() const { return this->command; }
+
+const nlohmann::json& Command::json_parameters() const {
+  return this->parameters;
+}
 } /* namespace horiba::communication */
@@ -0,0 +1,270 @@
+#include "horiba_cpp_sdk/communication/communicator_pool.h"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <chrono>
+#include <exception>
+#include <memory>
+#include <nlohmann/json.hpp>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "horiba_cpp_sdk/communication/command.h"
+#include "horiba_cpp_sdk/communication/websocket_communicator.h"
+
+namespace horiba::communication {
+
+namespace {
+std::vector<std::shared_ptr<Communicator>> make_websocket_connections(
+    const std::string& host, const std::string& port, std::size_t amount) {
+  std::vector<std::shared_ptr<Communicator>> connections;
+  connections.reserve(amount);
+  for (std::size_t i = 0; i < amount; i++) {
+    connections.push_back(
+        std::make_shared<WebSocketCommunicator>(host, port));
+  }
+  return connections;
+}
+
+// device family of a command, e.g. "ccd" for "ccd_getAcquisitionData"
+std::string_view command_family(const Command& command) {
+  const std::string_view name = command.name();
+  return name.substr(0, name.find('_'));
+}
+
+constexpr std::size_t lane_index(CommandClass command_class) {
+  return static_cast<std::size_t>(command_class);
+}
+}  // namespace
+
+CommandClass default_command_classifier(const Command& command) {
+  const auto& name = command.name();
+  if (name == "ccd_getAcquisitionData" || name == "saq3_getAvailableData") {
+    return CommandClass::BULK_DATA;
+  }
+  if (name == "ccd_acquisitionAbort" || name == "saq3_acqStop" ||
+      name == "icl_shutdown") {
+    return CommandClass::PRIORITY;
+  }
+  return CommandClass::CONTROL;
+}
+
+std::chrono::microseconds LatencyStatistics::mean() const {
+  if (this->count == 0) {
+    return std::chrono::microseconds{0};
+  }
+  return this->total / static_cast<long long int>(this->count);
+}
+
+CommunicatorPool::CommunicatorPool(const std::string& host,
+                                   const std::string& port,
+                                   ConnectionPoolConfig config)
+    : CommunicatorPool(
+          make_websocket_connections(host, port, config.control_connections),
+          make_websocket_connections(host, port, config.bulk_connections),
+          make_websocket_connections(host, port,
+                                     config.priority_connections)) {}
+
+CommunicatorPool::CommunicatorPool(
+    std::vector<std::shared_ptr<Communicator>> control_connections,
+    std::vector<std::shared_ptr<Communicator>> bulk_connections,
+    std::vector<std::shared_ptr<Communicator>> priority_connections)
+    : lanes{std::move(control_connections), std::move(bulk_connections),
+            std::move(priority_connections)} {
+  if (this->lanes[lane_index(CommandClass::CONTROL)].empty()) {
+    throw std::invalid_argument(
+        "a communicator pool needs at least one control connection");
+  }
+}
+
+void CommunicatorPool::open() {
+  if (this->is_open()) {
+    spdlog::error(
+        "[CommunicatorPool] Failed to open connections: already opened");
+    throw std::runtime_error("communicator pool is already open");
+  }
+
+  std::vector<std::shared_ptr<Communicator>> opened;
+  try {
+    for (const auto& connection : this->all_connections()) {
+      if (!connection->is_open()) {
+        connection->open();
+        opened.push_back(connection);
+      }
+    }
+  } catch (const std::exception& e) {
+    spdlog::error("[CommunicatorPool] Failed to open connections: {}",
+                  e.what());
+    for (const auto& connection : opened) {
+      try {
+        connection->close();
+      } catch (const std::exception& close_error) {
+        spdlog::debug("[CommunicatorPool] close: {}", close_error.what());
+      }
+    }
+    throw;
+  }
+  spdlog::debug("[CommunicatorPool] {} connections opened", opened.size());
+}
+
+void CommunicatorPool::close() {
+  std::exception_ptr first_error;
+  for (const auto& connection : this->all_connections()) {
+    if (!connection->is_open()) {
+      continue;
+    }
+    try {
+      connection->close();
+    } catch (const std::exception& e) {
+      spdlog::error("[CommunicatorPool] Failed to close connection: {}",
+                    e.what());
+      if (!first_error) {
+        first_error = std::current_exception();
+      }
+    }
+  }
+
+  if (first_error) {
+    std::rethrow_exception(first_error);
+  }
+}
+
+bool CommunicatorPool::is_open() {
+  // called before every command, so the connections are not gathered
+  const auto open = [](const auto& connection) {
+    return connection->is_open();
+  };
+  return std::ranges::all_of(this->lanes, [&](const auto& lane) {
+    return std::ranges::all_of(lane, open);
+  });
+}
+
+void CommunicatorPool::request_async(const Command& command,
+                                     ResponseHandler handler) {
+  const auto lane = this->lane_of(command);
+  const auto connection = this->connection_in_lane(lane, command);
+  if (lane != CommandClass::PRIORITY) {
+    connection->request_async(command, std::move(handler));
+    return;
+  }
+
+  const auto sent = std::chrono::steady_clock::now();
+  connection->request_async(
+      command,
+      [this, sent, name = command.name(), handler = std::move(handler)](
+          std::exception_ptr error, Response response) {
+        const auto latency =
+            std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now() - sent);
+        if (!error) {
+          this->record_priority_latency(latency);
+          spdlog::debug("[CommunicatorPool] {} answered in {} us", name,
+                        latency.count());
+        }
+        handler(error, std::move(response));
+      });
+}
+
+std::shared_ptr<BinaryMessageQueue> CommunicatorPool::subscribe_binary_messages(
+    BinaryMessageType type, std::size_t capacity) {
+  return this->lanes[lane_index(CommandClass::CONTROL)]
+      .front()
+      ->subscribe_binary_messages(type, capacity);
+}
+
+void CommunicatorPool::set_command_classifier(CommandClassifier classifier) {
+  const std::lock_guard<std::mutex> lock(this->routing_mutex);
+  this->command_classifier = std::move(classifier);
+}
+
+std::shared_ptr<Communicator> CommunicatorPool::connection_for(
+    const Command& command) {
+  return this->connection_in_lane(this->lane_of(command), command);
+}
+
+std::size_t CommunicatorPool::connections() const {
+  std::size_t amount = 0;
+  for (const auto& lane : this->lanes) {
+    amount += lane.size();
+  }
+  return amount;
+}
+
+LatencyStatistics CommunicatorPool::priority_latency() {
+  const std::lock_guard<std::mutex> lock(this->latency_mutex);
+  return this->priority_statistics;
+}
+
+CommandClass CommunicatorPool::lane_of(const Command& command) {
+  const std::lock_guard<std::mutex> lock(this->routing_mutex);
+  const auto command_class = this->command_classifier(command);
+  // classes without connections of their own share the control connections
+  if (this->lanes[lane_index(command_class)].empty()) {
+    return CommandClass::CONTROL;
+  }
+  return command_class;
+}
+
+std::shared_ptr<Communicator> CommunicatorPool::connection_in_lane(
+    CommandClass lane, const Command& command) {
+  const auto& connections = this->lanes[lane_index(lane)];
+  if (connections.size() == 1) {
+    return connections.front();
+  }
+
+  const auto& parameters = command.json_parameters();
+  const auto index = parameters.find("index");
+  if (index == parameters.end() || !index->is_number_integer()) {
+    return connections.front();
+  }
+
+  const std::lock_guard<std::mutex> lock(this->routing_mutex);
+  const auto family = command_family(command);
+  const auto device_index = index->get<long long int>();
+  auto device = std::find_if(
+      this->devices.begin(), this->devices.end(), [&](const auto& known) {
+        return known.index == device_index && known.family == family;
+      });
+  if (device == this->devices.end()) {
+    DeviceConnections assigned{std::string{family}, device_index, {}};
+    for (std::size_t i = 0; i < COMMAND_CLASSES; i++) {
+      assigned.connection.at(i) =
+          this->lanes.at(i).empty()
+              ? 0
+              : this->next_connection.at(i)++ % this->lanes.at(i).size();
+    }
+    device = this->devices.insert(this->devices.end(), std::move(assigned));
+    spdlog::debug(
+        "[CommunicatorPool] {} {} uses control connection {}, bulk "
+        "connection {} and priority connection {}",
+        device->family, device->index, device->connection[0],
+        device->connection[1], device->connection[2]);
+  }
+
+  return connections.at(device->connection.at(lane_index(lane)));
+}
+
+void CommunicatorPool::record_priority_latency(
+    std::chrono::microseconds latency) {
+  const std::lock_guard<std::mutex> lock(this->latency_mutex);
+  this->priority_statistics.count++;
+  this->priority_statistics.last = latency;
+  this->priority_statistics.max =
+      std::max(this->priority_statistics.max, latency);
+  this->priority_statistics.total += latency;
+}
+
+std::vector<std::shared_ptr<Communicator>> CommunicatorPool::all_connections()
+    const {
+  std::vector<std::shared_ptr<Communicator>> connections;
+  for (const auto& lane : this->lanes) {
+    connections.insert(connections.end(), lane.begin(), lane.end());
+  }
+  return connections;
+}
+
+} /* namespace horiba::communication */
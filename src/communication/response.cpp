@@ -1,20 +1,325 @@
 #include "horiba_cpp_sdk/communication/response.h"
 
+#include <charconv>
+#include <cstddef>
+#include <memory>
 #include <nlohmann/json.hpp>
+#include <optional>
+#include <stdexcept>
 #include <string>
+#include <string_view>
 #include <utility>
 #include <vector>
 
 namespace horiba::communication {
+
+namespace {
+/**
+ * @brief Scans the envelope of a response: the id and errors are decoded, the
+ * other values are only skipped. Nothing is allocated unless there are errors.
+ */
+class EnvelopeScanner {
+ public:
+  explicit EnvelopeScanner(std::string_view text) : text{text} {}
+
+  bool has_id{false};
+  unsigned long long int id{0};
+  std::size_t results_offset{0};
+  std::size_t results_length{0};
+
+  void scan(std::vector<std::string>& errors) {
+    this->expect('{');
+    if (this->try_consume('}')) {
+      return;
+    }
+
+    do {
+      const auto key = this->string_content();
+      this->expect(':');
+      this->skip_whitespace();
+
+      if (key == "id") {
+        this->id = this->unsigned_number();
+        this->has_id = true;
+      } else if (key == "errors") {
+        this->error_strings(errors);
+      } else if (key == "results") {
+        this->results_offset = this->position;
+        this->skip_value();
+        this->results_length = this->position - this->results_offset;
+      } else {
+        this->skip_value();
+      }
+    } while (this->try_consume(','));
+
+    this->expect('}');
+  }
+
+  /**
+   * @brief Scans the members until the id, the members after it are not
+   * checked.
+   */
+  void scan_id() {
+    this->expect('{');
+    if (this->try_consume('}')) {
+      return;
+    }
+
+    do {
+      const auto key = this->string_content();
+      this->expect(':');
+      this->skip_whitespace();
+
+      if (key == "id") {
+        this->id = this->unsigned_number();
+        this->has_id = true;
+        return;
+      }
+      this->skip_value();
+    } while (this->try_consume(','));
+  }
+
+ private:
+  std::string_view text;
+  std::size_t position{0};
+
+  [[noreturn]] void fail(const char* reason) const {
+    throw std::invalid_argument(std::string{"invalid response: "} + reason +
+                                " at position " +
+                                std::to_string(this->position));
+  }
+
+  void skip_whitespace() {
+    while (this->position < this->text.size()) {
+      const char character = this->text[this->position];
+      if (character != ' ' && character != '\n' && character != '\r' &&
+          character != '\t') {
+        return;
+      }
+      this->position++;
+    }
+  }
+
+  char peek() {
+    this->skip_whitespace();
+    if (this->position >= this->text.size()) {
+      this->fail("unexpected end");
+    }
+    return this->text[this->position];
+  }
+
+  bool try_consume(char expected) {
+    if (this->peek() != expected) {
+      return false;
+    }
+    this->position++;
+    return true;
+  }
+
+  void expect(char expected) {
+    if (!this->try_consume(expected)) {
+      this->fail("unexpected character");
+    }
+  }
+
+  std::string_view string_content() {
+    this->expect('"');
+    const auto start = this->position;
+    while (this->position < this->text.size()) {
+      const char character = this->text[this->position];
+      if (character == '\\') {
+        this->position += 2;
+        continue;
+      }
+      if (character == '"') {
+        const auto content = this->text.substr(start, this->position - start);
+        this->position++;
+        return content;
+      }
+      this->position++;
+    }
+    this->fail("unterminated string");
+  }
+
+  unsigned long long int unsigned_number() {
+    unsigned long long int value = 0;
+    const auto* const begin = this->text.data() + this->position;
+    const auto* const end = this->text.data() + this->text.size();
+    const auto [number_end, error] = std::from_chars(begin, end, value);
+    if (error != std::errc{}) {
+      this->fail("invalid id");
+    }
+    this->position += static_cast<std::size_t>(number_end - begin);
+    return value;
+  }
+
+  void skip_value() {
+    const char first = this->peek();
+    if (first == '"') {
+      this->string_content();
+      return;
+    }
+    if (first != '{' && first != '[') {
+      // number, true, false or null
+      while (this->position < this->text.size()) {
+        const char character = this->text[this->position];
+        if (character == ',' || character == '}' || character == ']' ||
+            character == ' ' || character == '\n' || character == '\r' ||
+            character == '\t') {
+          return;
+        }
+        this->position++;
+      }
+      return;
+    }
+
+    std::size_t depth = 0;
+    while (this->position < this->text.size()) {
+      const char character = this->text[this->position];
+      if (character == '"') {
+        this->string_content();
+        continue;
+      }
+      if (character == '{' || character == '[') {
+        depth++;
+      } else if (character == '}' || character == ']') {
+        depth--;
+        if (depth == 0) {
+          this->position++;
+          return;
+        }
+      }
+      this->position++;
+    }
+    this->fail("unterminated value");
+  }
+
+  void error_strings(std::vector<std::string>& errors) {
+    if (this->peek() != '[') {
+      this->skip_value();
+      return;
+    }
+
+    this->expect('[');
+    if (this->try_consume(']')) {
+      return;
+    }
+    do {
+      if (this->peek() != '"') {
+        this->skip_value();
+        continue;
+      }
+      const auto start = this->position;
+      this->string_content();
+      errors.push_back(nlohmann::json::parse(
+                           this->text.substr(start, this->position - start))
+                           .get<std::string>());
+    } while (this->try_consume(','));
+    this->expect(']');
+  }
+};
+}  // namespace
+
 Response::Response(unsigned long long int id, std::string command,
                    nlohmann::json::object_t results,
                    std::vector<std::string> errors)
-    : id{id},
+    : command_id{id},
       command{std::move(command)},
       results{std::move(results)},
       icl_errors{std::move(errors)} {}
 
-nlohmann::json Response::json_results() const { return this->results; }
+Response::Response(std::string raw_response, std::weak_ptr<BufferPool> pool)
+    : raw_response{std::move(raw_response)}, pool{std::move(pool)} {
+  EnvelopeScanner scanner{this->raw_response};
+  scanner.scan(this->icl_errors);
+  if (!scanner.has_id) {
+    throw std::invalid_argument("invalid response: missing id");
+  }
+
+  this->command_id = scanner.id;
+  this->results_offset = scanner.results_offset;
+  this->results_length = scanner.results_length;
+}
+
+std::optional<unsigned long long int> Response::scan_id(
+    std::string_view raw_response) noexcept {
+  EnvelopeScanner scanner{raw_response};
+  try {
+    scanner.scan_id();
+  } catch (const std::invalid_argument&) {
+    return std::nullopt;
+  }
+  if (!scanner.has_id) {
+    return std::nullopt;
+  }
+  return scanner.id;
+}
+
+Response& Response::operator=(const Response& other) {
+  if (this != &other) {
+    this->release_raw_response();
+    this->command_id = other.command_id;
+    this->command = other.command;
+    this->results = other.results;
+    this->icl_errors = other.icl_errors;
+    this->raw_response = other.raw_response;
+    this->results_offset = other.results_offset;
+    this->results_length = other.results_length;
+    this->pool = other.pool;
+  }
+  return *this;
+}
+
+Response& Response::operator=(Response&& other) noexcept {
+  if (this != &other) {
+    this->release_raw_response();
+    this->command_id = other.command_id;
+    this->command = std::move(other.command);
+    this->results = std::move(other.results);
+    this->icl_errors = std::move(other.icl_errors);
+    this->raw_response = std::move(other.raw_response);
+    this->results_offset = other.results_offset;
+    this->results_length = other.results_length;
+    this->pool = std::move(other.pool);
+  }
+  return *this;
+}
+
+Response::~Response() { this->release_raw_response(); }
+
+unsigned long long int Response::id() const { return this->command_id; }
+
+nlohmann::json Response::json_results() const {
+  if (this->raw_response.empty()) {
+    return this->results;
+  }
+
+  const auto raw_results = this->raw_results();
+  if (raw_results.empty() || raw_results == "null") {
+    return nlohmann::json::object();
+  }
+  return nlohmann::json::parse(raw_results);
+}
+
+const std::vector<std::string>& Response::errors() const {
+  return this->icl_errors;
+}
+
+std::string_view Response::raw() const { return this->raw_response; }
+
+std::string_view Response::raw_results() const {
+  if (this->results_offset + this->results_length >
+      this->raw_response.size()) {
+    return {};
+  }
+  return std::string_view{this->raw_response}.substr(this->results_offset,
+                                                     this->results_length);
+}
 
-std::vector<std::string> Response::errors() const { return this->icl_errors; }
+void Response::release_raw_response() {
+  if (auto buffer_pool = this->pool.lock()) {
+    buffer_pool->release(std::move(this->raw_response));
+  }
+  this->raw_response.clear();
+}
 } /* namespace horiba::communication */
@@ -2,13 +2,17 @@
 
 #include <spdlog/spdlog.h>
 
-#include <boost/beast/core/buffers_to_string.hpp>
+#include <boost/asio/bind_executor.hpp>
+#include <boost/asio/post.hpp>
 #include <boost/beast/core/flat_buffer.hpp>
 #include <boost/beast/core/make_printable.hpp>
 #include <exception>
 #include <memory>
 #include <nlohmann/json.hpp>
+#include <span>
 #include <stdexcept>
+#include <utility>
+#include <vector>
 
 #include "horiba_cpp_sdk/communication/command.h"
 #include "horiba_cpp_sdk/communication/response.h"
@@ -18,19 +22,45 @@ namespace horiba::communication {
 WebSocketCommunicator::WebSocketCommunicator(std::string host, std::string port)
     : host{std::move(host)}, port{std::move(port)} {}
 
+WebSocketCommunicator::~WebSocketCommunicator() {
+  if (this->is_open()) {
+    try {
+      this->close();
+    } catch (const std::exception& e) {
+      spdlog::error("[WebSocketCommunicator] Failed to close WebSocket: {}",
+                    e.what());
+    }
+  }
+
+  if (this->io_thread.joinable()) {
+    this->io_thread.join();
+  }
+}
+
 void WebSocketCommunicator::open() {
+  const std::lock_guard<std::mutex> lifecycle_lock(this->lifecycle_mutex);
   if (this->is_open()) {
     spdlog::error(
         "[WebSocketCommunicator] Failed to open WebSocket: already opened");
     throw std::runtime_error("websocket is already open");
   }
 
+  // the io thread of a previous connection that was closed by the remote
+  if (this->io_thread.joinable()) {
+    this->io_thread.join();
+  }
+  this->context.restart();
+
   spdlog::debug("[WebSocketCommunicator] Opening WebSocket on {}:{}",
                 this->host, this->port);
   boost::asio::ip::tcp::resolver resolver{this->context};
 
   auto const results = resolver.resolve(this->host, this->port);
   auto endpoint = boost::asio::connect(this->websocket.next_layer(), results);
+  // commands are small messages that should not wait for the acknowledgment
+  // of the previous ones
+  this->websocket.next_layer().set_option(
+      boost::asio::ip::tcp::no_delay(true));
 
   this->websocket.set_option(boost::beast::websocket::stream_base::decorator(
       [](boost::beast::websocket::request_type& req) {
@@ -41,23 +71,59 @@ void WebSocketCommunicator::open() {
 
   this->websocket.handshake(host + ':' + std::to_string(endpoint.port()), "/");
 
+  this->generation++;
+  this->reset_writes();
+  this->read_buffer.clear();
+  this->connected.store(true);
+
+  this->do_read();
+  this->io_thread = std::thread([this] {
+    try {
+      this->context.run();
+    } catch (const std::exception& e) {
+      spdlog::error("[WebSocketCommunicator] io thread failed: {}", e.what());
+    }
+  });
+
   spdlog::debug("[WebSocketCommunicator] WebSocket opened");
 }
 
 void WebSocketCommunicator::close() {
+  const std::lock_guard<std::mutex> lifecycle_lock(this->lifecycle_mutex);
   if (!this->is_open()) {
     spdlog::error(
         "[WebSocketCommunicator] Failed to close WebSocket: not opened");
     throw std::runtime_error("websocket is not open");
   }
 
-  this->websocket.close(boost::beast::websocket::close_code::normal);
+  this->connected.store(false);
+  boost::asio::post(this->strand, [this,
+                                   closing_generation = this->generation] {
+    // a close that was queued for a connection that does not exist anymore
+    if (closing_generation != this->generation) {
+      return;
+    }
+    this->websocket.async_close(
+        boost::beast::websocket::close_code::normal,
+        [](boost::beast::error_code error) {
+          if (error) {
+            spdlog::debug("[WebSocketCommunicator] close: {}",
+                          error.message());
+          }
+        });
+  });
+
+  if (this->io_thread.joinable()) {
+    this->io_thread.join();
+  }
+  this->fail_pending_requests("websocket closed");
   spdlog::debug("[WebSocketCommunicator] WebSocket closed");
 }
 
-bool WebSocketCommunicator::is_open() { return this->websocket.is_open(); }
+bool WebSocketCommunicator::is_open() { return this->connected.load(); }
 
-Response WebSocketCommunicator::request_with_response(const Command& command) {
+void WebSocketCommunicator::request_async(const Command& command,
+                                          ResponseHandler handler) {
   if (!this->is_open()) {
     spdlog::error(
         "[WebSocketCommunicator] cannot send request, websocket is closed");
@@ -65,21 +131,273 @@ Response WebSocketCommunicator::request_with_response(const Command& command) {
         "cannot send request if websocket communicator is closed");
   }
 
-  std::string json_command = command.json().dump();
+  const auto command_id = command.id();
+  std::string json_command = this->buffer_pool->acquire();
+  command.serialize(json_command);
   spdlog::debug("[WebSocketCommunicator] Sending request: {}", json_command);
-  this->websocket.write(boost::asio::buffer(json_command));
 
-  boost::beast::flat_buffer buffer;
-  this->websocket.read(buffer);
+  {
+    const std::lock_guard<std::mutex> lock(this->pending_mutex);
+    if (this->pending.contains(command_id)) {
+      spdlog::error(
+          "[WebSocketCommunicator] a request with id {} is already pending",
+          command_id);
+      this->buffer_pool->release(std::move(json_command));
+      throw std::invalid_argument("a request with id " +
+                                  std::to_string(command_id) +
+                                  " is already pending");
+    }
+
+    if (this->free_pending_nodes.empty()) {
+      this->pending.emplace(command_id, std::move(handler));
+    } else {
+      auto node = std::move(this->free_pending_nodes.back());
+      this->free_pending_nodes.pop_back();
+      node.key() = command_id;
+      node.mapped() = std::move(handler);
+      this->pending.insert(std::move(node));
+    }
+  }
+
+  // the connection may have dropped while registering the request. In that
+  // case the request is either still registered and we report the error
+  // here, or it has already been failed by the reader.
+  if (!this->is_open()) {
+    this->buffer_pool->release(std::move(json_command));
+    const std::lock_guard<std::mutex> lock(this->pending_mutex);
+    if (this->pending.erase(command_id) > 0) {
+      throw std::runtime_error(
+          "cannot send request if websocket communicator is closed");
+    }
+    return;
+  }
+
+  this->schedule_write(std::move(json_command));
+}
+
+std::size_t WebSocketCommunicator::pending_requests() {
+  const std::lock_guard<std::mutex> lock(this->pending_mutex);
+  return this->pending.size();
+}
+
+std::shared_ptr<BinaryMessageQueue>
+WebSocketCommunicator::subscribe_binary_messages(BinaryMessageType type,
+                                                 std::size_t capacity) {
+  auto queue = std::make_shared<BinaryMessageQueue>(capacity);
+  const std::lock_guard<std::mutex> lock(this->subscribers_mutex);
+  this->subscribers.at(static_cast<std::size_t>(type)).push_back(queue);
+  return queue;
+}
+
+void WebSocketCommunicator::set_binary_message_classifier(
+    BinaryMessageClassifier classifier) {
+  const std::lock_guard<std::mutex> lock(this->subscribers_mutex);
+  this->binary_message_classifier = std::move(classifier);
+}
+
+void WebSocketCommunicator::schedule_write(std::string message) {
+  bool wake_writer = false;
+  {
+    const std::lock_guard<std::mutex> lock(this->write_mutex);
+    this->outgoing_messages.push_back(std::move(message));
+    wake_writer = !this->write_scheduled;
+    this->write_scheduled = true;
+  }
+
+  if (wake_writer) {
+    boost::asio::post(this->strand,
+                      bind_handler_memory(this->wake_handler_memory, [this] {
+                        if (!this->write_in_progress) {
+                          this->do_write();
+                        }
+                      }));
+  }
+}
+
+void WebSocketCommunicator::do_write() {
+  if (this->write_position == this->writing_messages.size()) {
+    for (auto& message : this->writing_messages) {
+      this->buffer_pool->release(std::move(message));
+    }
+    this->writing_messages.clear();
+    this->write_position = 0;
+
+    const std::lock_guard<std::mutex> lock(this->write_mutex);
+    if (this->outgoing_messages.empty()) {
+      this->write_scheduled = false;
+      this->write_in_progress = false;
+      return;
+    }
+    std::swap(this->outgoing_messages, this->writing_messages);
+  }
+
+  this->write_in_progress = true;
+  this->websocket.text(true);
+  this->websocket.async_write(
+      boost::asio::buffer(this->writing_messages[this->write_position]),
+      boost::asio::bind_executor(
+          this->strand,
+          bind_handler_memory(
+              this->write_handler_memory,
+              [this](boost::beast::error_code error,
+                     std::size_t /*bytes_written*/) {
+                if (error) {
+                  spdlog::error(
+                      "[WebSocketCommunicator] Failed to send request: {}",
+                      error.message());
+                  this->reset_writes();
+                  this->fail_pending_requests("failed to send request: " +
+                                              error.message());
+                  return;
+                }
 
-  std::string raw_response = boost::beast::buffers_to_string(buffer.data());
+                this->write_position++;
+                this->do_write();
+              })));
+}
+
+void WebSocketCommunicator::reset_writes() {
+  for (auto& message : this->writing_messages) {
+    this->buffer_pool->release(std::move(message));
+  }
+  this->writing_messages.clear();
+  this->write_position = 0;
+  this->write_in_progress = false;
+
+  const std::lock_guard<std::mutex> lock(this->write_mutex);
+  for (auto& message : this->outgoing_messages) {
+    this->buffer_pool->release(std::move(message));
+  }
+  this->outgoing_messages.clear();
+  this->write_scheduled = false;
+}
+
+void WebSocketCommunicator::do_read() {
+  this->websocket.async_read(
+      this->read_buffer,
+      boost::asio::bind_executor(
+          this->strand,
+          bind_handler_memory(this->read_handler_memory,
+                              [this](boost::beast::error_code error,
+                                     std::size_t /*bytes_read*/) {
+                                this->on_read(error);
+                              })));
+}
+
+void WebSocketCommunicator::on_read(boost::beast::error_code error) {
+  if (error) {
+    this->connected.store(false);
+    if (error != boost::beast::websocket::error::closed &&
+        error != boost::asio::error::operation_aborted) {
+      spdlog::error("[WebSocketCommunicator] Failed to read: {}",
+                    error.message());
+    }
+    this->fail_pending_requests("connection lost: " + error.message());
+    return;
+  }
+
+  if (this->websocket.got_text()) {
+    const auto content = this->read_buffer.data();
+    std::string raw_response = this->buffer_pool->acquire();
+    raw_response.assign(static_cast<const char*>(content.data()),
+                        content.size());
+    this->read_buffer.consume(this->read_buffer.size());
+    this->dispatch_response(std::move(raw_response));
+  } else {
+    this->dispatch_binary_message();
+  }
+
+  this->do_read();
+}
+
+void WebSocketCommunicator::dispatch_response(std::string raw_response) {
   spdlog::debug("[WebSocketCommunicator] raw response: {}", raw_response);
 
-  nlohmann::json json_response = nlohmann::json::parse(raw_response);
-  spdlog::debug("[WebSocketCommunicator] Received response: {}",
-                json_response.dump());
+  // the id is read first, so that the request of a response that cannot be
+  // decoded fails instead of waiting forever
+  const auto response_id = Response::scan_id(raw_response);
+  if (!response_id) {
+    spdlog::error("[WebSocketCommunicator] Invalid response without id");
+    return;
+  }
 
-  return Response{json_response["id"], json_response["command"],
-                  json_response["results"], json_response["errors"]};
+  ResponseHandler handler;
+  {
+    const std::lock_guard<std::mutex> lock(this->pending_mutex);
+    auto it = this->pending.find(*response_id);
+    if (it == this->pending.end()) {
+      spdlog::warn("[WebSocketCommunicator] No pending request with id {}",
+                   *response_id);
+      return;
+    }
+    auto node = this->pending.extract(it);
+    handler = std::move(node.mapped());
+    this->free_pending_nodes.push_back(std::move(node));
+  }
+
+  std::exception_ptr error;
+  Response response;
+  try {
+    response = Response{std::move(raw_response), this->buffer_pool};
+  } catch (const std::exception& e) {
+    spdlog::error("[WebSocketCommunicator] Invalid response {}: {}",
+                  *response_id, e.what());
+    error = std::current_exception();
+  }
+
+  try {
+    handler(error, std::move(response));
+  } catch (const std::exception& e) {
+    spdlog::error("[WebSocketCommunicator] Failed to handle response {}: {}",
+                  *response_id, e.what());
+  }
+}
+
+void WebSocketCommunicator::dispatch_binary_message() {
+  const auto content = this->read_buffer.data();
+  const std::span<const std::byte> frame{
+      static_cast<const std::byte*>(content.data()), content.size()};
+
+  const std::lock_guard<std::mutex> lock(this->subscribers_mutex);
+  const auto type = this->binary_message_classifier(frame);
+  auto& type_subscribers = this->subscribers.at(static_cast<std::size_t>(type));
+  std::erase_if(type_subscribers,
+                [](const auto& subscriber) { return subscriber.expired(); });
+
+  if (type_subscribers.empty()) {
+    spdlog::trace(
+        "[WebSocketCommunicator] no subscriber for binary message of {} bytes",
+        frame.size());
+    this->read_buffer.consume(this->read_buffer.size());
+    return;
+  }
+
+  // the message takes over the read buffer, the next frame is read into a
+  // new one
+  auto message = std::make_shared<const BinaryMessage>(
+      type, std::exchange(this->read_buffer, boost::beast::flat_buffer{}));
+  for (const auto& subscriber : type_subscribers) {
+    if (auto queue = subscriber.lock()) {
+      queue->push(message);
+    }
+  }
+}
+
+void WebSocketCommunicator::fail_pending_requests(const std::string& reason) {
+  std::unordered_map<unsigned long long int, ResponseHandler> failed;
+  {
+    const std::lock_guard<std::mutex> lock(this->pending_mutex);
+    failed.swap(this->pending);
+  }
+
+  for (auto& [id, handler] : failed) {
+    spdlog::debug("[WebSocketCommunicator] request {} failed: {}", id, reason);
+    try {
+      handler(std::make_exception_ptr(std::runtime_error(reason)), Response{});
+    } catch (const std::exception& e) {
+      spdlog::error("[WebSocketCommunicator] Failed to handle error of {}: {}",
+                    id, e.what());
+    }
+  }
 }
 } /* namespace horiba::communication */
@@ -6,6 +6,7 @@
 #include <memory>
 #include <stdexcept>
 #include <string>
+#include <utility>
 
 #include "spdlog/common.h"
 
@@ -28,15 +29,19 @@ void ChargeCoupledDevicesDiscovery::execute(bool error_on_no_devices) {
   const auto response = this->communicator->request_with_response(
       communication::Command("ccd_list", {}));
 
+  // the raw text is logged, nothing is formatted unless it is printed
   spdlog::debug("[ChargeCoupledDevicesDiscovery] response: {}",
-                response.json_results().dump());
+                response.raw_results());
 
-  if (response.json_results().empty() && error_on_no_devices) {
+  auto raw_cdds = response.json_results();
+  if (raw_cdds.empty() && error_on_no_devices) {
     throw std::runtime_error("No CCDs connected");
   }
 
-  auto raw_cdds = response.json_results();
-  this->ccds = this->parse_ccds(raw_cdds);
+  if (raw_cdds.contains("devices")) {
+    this->listed_devices = raw_cdds["devices"];
+  }
+  this->ccds = this->parse_ccds(std::move(raw_cdds));
 }
 
 std::vector<std::shared_ptr<single_devices::ChargeCoupledDevice>>
@@ -44,6 +49,10 @@ ChargeCoupledDevicesDiscovery::charge_coupled_devices() const {
   return this->ccds;
 }
 
+nlohmann::json ChargeCoupledDevicesDiscovery::devices_list() const {
+  return this->listed_devices;
+}
+
 std::vector<std::shared_ptr<single_devices::ChargeCoupledDevice>>
 ChargeCoupledDevicesDiscovery::parse_ccds(nlohmann::json raw_ccds) {
   spdlog::info("[ChargeCoupledDevicesDiscovery] detected #{} CCDS",
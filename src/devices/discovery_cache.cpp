@@ -0,0 +1,115 @@
+#include "horiba_cpp_sdk/devices/discovery_cache.h"
+
+#include <spdlog/spdlog.h>
+
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <nlohmann/json.hpp>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+
+namespace horiba::devices {
+
+namespace {
+nlohmann::json devices_of(const nlohmann::json& cache, const char* key) {
+  const auto devices = cache.find(key);
+  if (devices == cache.end() || !devices->is_array()) {
+    return nlohmann::json::array();
+  }
+  return *devices;
+}
+}  // namespace
+
+std::optional<DiscoveryCache> DiscoveryCache::load(
+    const std::filesystem::path& file) {
+  std::ifstream input(file);
+  if (!input) {
+    spdlog::debug("[DiscoveryCache] no cache at {}", file.string());
+    return std::nullopt;
+  }
+
+  const auto content = nlohmann::json::parse(input, nullptr, false);
+  if (content.is_discarded() || !content.is_object() ||
+      content.value("version", 0) != VERSION) {
+    spdlog::warn("[DiscoveryCache] ignoring unreadable cache {}",
+                 file.string());
+    return std::nullopt;
+  }
+
+  DiscoveryCache cache;
+  cache.charge_coupled_devices = devices_of(content, "ccds");
+  cache.monochromators = devices_of(content, "monos");
+  cache.spectracq3s = devices_of(content, "spectracq3s");
+  if (const auto configurations = content.find("configurations");
+      configurations != content.end() && configurations->is_object()) {
+    for (const auto& [serial, configuration] : configurations->items()) {
+      cache.configurations.emplace(serial, configuration);
+    }
+  }
+  return cache;
+}
+
+void DiscoveryCache::save(const std::filesystem::path& file) const {
+  nlohmann::json content = {{"version", VERSION},
+                            {"ccds", this->charge_coupled_devices},
+                            {"monos", this->monochromators},
+                            {"spectracq3s", this->spectracq3s},
+                            {"configurations", this->configurations}};
+
+  if (file.has_parent_path()) {
+    std::filesystem::create_directories(file.parent_path());
+  }
+  auto temporary = file;
+  temporary += ".tmp";
+  {
+    std::ofstream output(temporary, std::ios::trunc);
+    output << content.dump(2);
+    if (!output) {
+      spdlog::error("[DiscoveryCache] Failed to write {}", temporary.string());
+      throw std::runtime_error("failed to write discovery cache " +
+                               temporary.string());
+    }
+  }
+
+  std::error_code error;
+  std::filesystem::rename(temporary, file, error);
+  if (error) {
+    spdlog::error("[DiscoveryCache] Failed to replace {}: {}", file.string(),
+                  error.message());
+    throw std::runtime_error("failed to replace discovery cache " +
+                             file.string());
+  }
+  spdlog::debug("[DiscoveryCache] cache written to {}", file.string());
+}
+
+bool DiscoveryCache::same_devices(const nlohmann::json& cached,
+                                  const nlohmann::json& listed) {
+  if (!cached.is_array() || !listed.is_array() ||
+      cached.size() != listed.size()) {
+    return false;
+  }
+  for (std::size_t i = 0; i < cached.size(); i++) {
+    if (cached[i].value("index", -1) != listed[i].value("index", -1) ||
+        serial_number(cached[i]) != serial_number(listed[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+std::string DiscoveryCache::serial_number(const nlohmann::json& device) {
+  const auto serial = device.find("serialNumber");
+  if (serial == device.end() || !serial->is_string()) {
+    return {};
+  }
+  auto text = serial->get<std::string>();
+  // e.g. the monochromators pad their serial number with spaces
+  const auto end = text.find_last_not_of(' ');
+  text.erase(end == std::string::npos ? 0 : end + 1);
+  return text;
+}
+
+} /* namespace horiba::devices */
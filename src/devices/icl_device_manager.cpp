@@ -1,13 +1,22 @@
 #include <horiba_cpp_sdk/communication/command.h>
+#include <horiba_cpp_sdk/communication/communicator_pool.h>
 #include <horiba_cpp_sdk/communication/response.h>
-#include <horiba_cpp_sdk/communication/websocket_communicator.h>
 #include <horiba_cpp_sdk/devices/ccds_discovery.h>
+#include <horiba_cpp_sdk/devices/discovery_cache.h>
 #include <horiba_cpp_sdk/devices/icl_device_manager.h>
 #include <horiba_cpp_sdk/devices/monos_discovery.h>
 #include <horiba_cpp_sdk/devices/single_devices/ccd.h>
 #include <spdlog/spdlog.h>
 
+#include <algorithm>
+#include <chrono>
+#include <exception>
+#include <filesystem>
+#include <future>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <nlohmann/json.hpp>
 #include <stdexcept>
 #include <string>
 #include <thread>
@@ -17,46 +26,154 @@
 #include "horiba_cpp_sdk/devices/spectracq3s_discovery.h"
 
 namespace horiba::devices {
+namespace {
+std::chrono::microseconds elapsed_since(
+    std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - start);
+}
+
+// runs the discovery of a device family on a thread of its own, completes
+// with the devices and the list they were created from
+template <typename Discovery, typename Devices>
+std::future<std::pair<Devices, nlohmann::json>> discover_async(
+    std::shared_ptr<horiba::communication::Communicator> communicator,
+    bool error_on_no_device, Devices (Discovery::*devices)() const,
+    std::chrono::microseconds& duration) {
+  return std::async(
+      std::launch::async,
+      [communicator = std::move(communicator), error_on_no_device, devices,
+       &duration]() {
+        const auto started = std::chrono::steady_clock::now();
+        Discovery discovery(communicator);
+        discovery.execute(error_on_no_device);
+        duration = elapsed_since(started);
+        return std::make_pair((discovery.*devices)(), discovery.devices_list());
+      });
+}
+
+// creates the devices of a "devices" list, e.g. one from a discovery cache
+template <typename Device>
+std::vector<std::shared_ptr<Device>> devices_of_list(
+    const nlohmann::json& list,
+    const std::shared_ptr<horiba::communication::Communicator>& communicator) {
+  std::vector<std::shared_ptr<Device>> devices;
+  devices.reserve(list.size());
+  for (const auto& device : list) {
+    devices.push_back(
+        std::make_shared<Device>(device.at("index").get<int>(), communicator));
+  }
+  return devices;
+}
+
+// serial number of the device with the index in a "devices" list
+std::string serial_number_of(const nlohmann::json& list, int index) {
+  for (const auto& device : list) {
+    if (device.value("index", -1) == index) {
+      return DiscoveryCache::serial_number(device);
+    }
+  }
+  return {};
+}
+
+nlohmann::json listed_devices(horiba::communication::Communicator& communicator,
+                              const std::string& command) {
+  const auto response =
+      communicator.request_with_response(communication::Command(command, {}));
+  const auto results = response.json_results();
+  if (!results.contains("devices")) {
+    return nlohmann::json::array();
+  }
+  return results["devices"];
+}
+}  // namespace
+
 ICLDeviceManager::ICLDeviceManager(
     std::shared_ptr<horiba::os::Process> icl_process, std::string websocket_ip,
     std::string websocket_port, bool manage_icl_lifetime,
-    bool enable_binary_messages)
+    bool enable_binary_messages,
+    horiba::communication::ConnectionPoolConfig connection_pool,
+    ReadinessConfig readiness, std::filesystem::path discovery_cache_file)
     : icl_process{std::move(icl_process)},
       websocket_ip{std::move(websocket_ip)},
       websocket_port{std::move(websocket_port)},
       manage_icl_lifetime{manage_icl_lifetime},
       enable_binary_messages{enable_binary_messages},
-      communicator{
-          std::make_shared<horiba::communication::WebSocketCommunicator>(
-              this->websocket_ip, this->websocket_port)} {}
+      readiness{readiness},
+      discovery_cache_file{std::move(discovery_cache_file)},
+      communicator{std::make_shared<horiba::communication::CommunicatorPool>(
+          this->websocket_ip, this->websocket_port, connection_pool)} {}
+
+ICLDeviceManager::ICLDeviceManager(
+    std::shared_ptr<horiba::os::Process> icl_process,
+    std::shared_ptr<horiba::communication::CommunicatorPool> communicator,
+    bool manage_icl_lifetime, bool enable_binary_messages,
+    ReadinessConfig readiness, std::filesystem::path discovery_cache_file)
+    : icl_process{std::move(icl_process)},
+      manage_icl_lifetime{manage_icl_lifetime},
+      enable_binary_messages{enable_binary_messages},
+      readiness{readiness},
+      discovery_cache_file{std::move(discovery_cache_file)},
+      communicator{std::move(communicator)} {
+  if (!this->communicator) {
+    throw std::invalid_argument("communicator must not be null");
+  }
+}
 
 void ICLDeviceManager::start() {
   spdlog::debug("[ICLDeviceManager] managing ICL lifetime: {}",
                 this->manage_icl_lifetime);
+  const auto started = std::chrono::steady_clock::now();
+  const auto deadline = started + this->readiness.deadline;
+  StartupTiming timing;
+
   if (this->manage_icl_lifetime && !this->icl_process->running()) {
     this->icl_process->start();
-    std::this_thread::sleep_for(std::chrono::seconds(4));
   }
+  timing.process_start = elapsed_since(started);
   spdlog::debug("[ICLDeviceManager] ICL started");
 
-  this->communicator->open();
-
-  const communication::Response response =
-      this->communicator->request_with_response(
-          communication::Command("icl_info", {}));
-  spdlog::debug("[ICLDeviceManager] ICL info: {}",
-                response.json_results().dump());
+  this->await_icl_ready(deadline, timing);
 
   if (this->enable_binary_messages) {
+    const auto binary_mode_started = std::chrono::steady_clock::now();
     this->enable_binary_messages_on_icl();
+    timing.binary_mode = elapsed_since(binary_mode_started);
   }
 
-  std::this_thread::sleep_for(std::chrono::seconds(5));
+  const auto discovery_started = std::chrono::steady_clock::now();
+  if (!this->restore_devices_from_cache()) {
+    this->discover_devices();
+  }
+  timing.discovery = elapsed_since(discovery_started);
 
-  this->discover_devices();
+  timing.total = elapsed_since(started);
+  this->last_startup = timing;
+  spdlog::info(
+      "[ICLDeviceManager] started in {} us: process {} us, connect {} us, "
+      "probe {} us, binary mode {} us, discovery {} us, {} attempts",
+      timing.total.count(), timing.process_start.count(),
+      timing.connect.count(), timing.probe.count(),
+      timing.binary_mode.count(), timing.discovery.count(), timing.attempts);
 }
 
 void ICLDeviceManager::stop() {
+  // the check would fail as soon as the connections are closed
+  try {
+    this->wait_for_cache_check();
+  } catch (const std::exception& e) {
+    spdlog::warn("[ICLDeviceManager] cached devices not checked: {}",
+                 e.what());
+  }
+  if (!this->discovery_cache_file.empty()) {
+    try {
+      this->save_discovery_cache();
+    } catch (const std::exception& e) {
+      spdlog::warn("[ICLDeviceManager] discovery cache not saved: {}",
+                   e.what());
+    }
+  }
+
   if (this->manage_icl_lifetime && !this->communicator->is_open()) {
     this->communicator->open();
   }
@@ -74,41 +191,293 @@ void ICLDeviceManager::stop() {
 }
 
 void ICLDeviceManager::discover_devices(bool error_on_no_device) {
-  ChargeCoupledDevicesDiscovery ccds_discovery =
-      ChargeCoupledDevicesDiscovery(this->communicator);
-
-  ccds_discovery.execute(error_on_no_device);
-  this->ccds = ccds_discovery.charge_coupled_devices();
+  // opened once here, the discoveries would race to open it
+  if (!this->communicator->is_open()) {
+    this->communicator->open();
+  }
 
-  MonochromatorsDiscovery monochromators_discovery =
-      MonochromatorsDiscovery(this->communicator);
+  const auto started = std::chrono::steady_clock::now();
+  DiscoveryTiming timing;
+  auto ccds_discovery = discover_async(
+      this->communicator, error_on_no_device,
+      &ChargeCoupledDevicesDiscovery::charge_coupled_devices,
+      timing.charge_coupled_devices);
+  auto monochromators_discovery =
+      discover_async(this->communicator, error_on_no_device,
+                     &MonochromatorsDiscovery::monochromators,
+                     timing.monochromators);
+  auto spectracq3s_discovery = discover_async(
+      this->communicator, error_on_no_device,
+      &SpectrAcq3sDiscovery::spectracq3s, timing.spectracq3s);
 
-  monochromators_discovery.execute(error_on_no_device);
-  this->monos = monochromators_discovery.monochromators();
+  // all discoveries are done before any of their errors is rethrown
+  ccds_discovery.wait();
+  monochromators_discovery.wait();
+  spectracq3s_discovery.wait();
+  timing.total = elapsed_since(started);
 
-  SpectrAcq3sDiscovery spectracq3s_discovery =
-      SpectrAcq3sDiscovery(this->communicator);
+  auto [discovered_ccds, ccds_list] = ccds_discovery.get();
+  auto [discovered_monos, monos_list] = monochromators_discovery.get();
+  auto [discovered_spectracq3s, spectracq3s_list] =
+      spectracq3s_discovery.get();
+  {
+    const std::lock_guard<std::mutex> lock(this->devices_mutex);
+    this->ccds = std::move(discovered_ccds);
+    this->monos = std::move(discovered_monos);
+    this->spectracq3s = std::move(discovered_spectracq3s);
+    this->discovered.charge_coupled_devices = std::move(ccds_list);
+    this->discovered.monochromators = std::move(monos_list);
+    this->discovered.spectracq3s = std::move(spectracq3s_list);
+    this->last_discovery = timing;
+  }
+  this->record_fetched_configurations();
+  spdlog::info(
+      "[ICLDeviceManager] discovered in {} us: CCDs {} us, monochromators {} "
+      "us, SpectrAcq3s {} us",
+      timing.total.count(), timing.charge_coupled_devices.count(),
+      timing.monochromators.count(), timing.spectracq3s.count());
 
-  spectracq3s_discovery.execute(error_on_no_device);
-  this->spectracq3s = spectracq3s_discovery.spectracq3s();
+  if (!this->discovery_cache_file.empty()) {
+    try {
+      this->save_discovery_cache();
+    } catch (const std::exception& e) {
+      spdlog::warn("[ICLDeviceManager] discovery cache not saved: {}",
+                   e.what());
+    }
+  }
 }
 
 std::vector<std::shared_ptr<horiba::devices::single_devices::Monochromator>>
 ICLDeviceManager::monochromators() const {
+  const std::lock_guard<std::mutex> lock(this->devices_mutex);
   return this->monos;
 }
 
 std::vector<
     std::shared_ptr<horiba::devices::single_devices::ChargeCoupledDevice>>
 ICLDeviceManager::charge_coupled_devices() const {
+  const std::lock_guard<std::mutex> lock(this->devices_mutex);
   return this->ccds;
 }
 
 std::vector<std::shared_ptr<horiba::devices::single_devices::SpectrAcq3>>
 ICLDeviceManager::spectracq3_devices() const {
+  const std::lock_guard<std::mutex> lock(this->devices_mutex);
   return this->spectracq3s;
 }
 
+std::shared_ptr<horiba::communication::BinaryMessageQueue>
+ICLDeviceManager::subscribe_binary_messages(
+    horiba::communication::BinaryMessageType type, std::size_t capacity) {
+  return this->communicator->subscribe_binary_messages(type, capacity);
+}
+
+horiba::communication::LatencyStatistics ICLDeviceManager::priority_latency() {
+  return this->communicator->priority_latency();
+}
+
+StartupTiming ICLDeviceManager::startup_timing() const {
+  return this->last_startup;
+}
+
+DiscoveryTiming ICLDeviceManager::discovery_timing() const {
+  const std::lock_guard<std::mutex> lock(this->devices_mutex);
+  return this->last_discovery;
+}
+
+bool ICLDeviceManager::wait_for_cache_check() {
+  if (!this->cache_check.valid()) {
+    return false;
+  }
+  return this->cache_check.get();
+}
+
+void ICLDeviceManager::save_discovery_cache() {
+  DiscoveryCache cache;
+  {
+    const std::lock_guard<std::mutex> lock(this->devices_mutex);
+    cache = this->discovered;
+  }
+
+  // only configurations already fetched are saved, none is asked for here
+  {
+    const std::lock_guard<std::mutex> lock(
+        this->fetched_configurations->mutex);
+    for (const auto& [serial_number, configuration] :
+         this->fetched_configurations->by_serial_number) {
+      cache.configurations[serial_number] = configuration;
+    }
+  }
+  // the file may hold configurations of devices not fetched on this run
+  if (auto saved = DiscoveryCache::load(this->discovery_cache_file)) {
+    cache.configurations.merge(saved->configurations);
+  }
+
+  cache.save(this->discovery_cache_file);
+  const std::lock_guard<std::mutex> lock(this->devices_mutex);
+  this->discovered.configurations = cache.configurations;
+}
+
+bool ICLDeviceManager::restore_devices_from_cache() {
+  if (this->discovery_cache_file.empty()) {
+    return false;
+  }
+  const auto cache = DiscoveryCache::load(this->discovery_cache_file);
+  if (!cache || (cache->charge_coupled_devices.empty() &&
+                 cache->monochromators.empty() && cache->spectracq3s.empty())) {
+    return false;
+  }
+
+  auto cached_ccds =
+      devices_of_list<horiba::devices::single_devices::ChargeCoupledDevice>(
+          cache->charge_coupled_devices, this->communicator);
+  auto cached_monos =
+      devices_of_list<horiba::devices::single_devices::Monochromator>(
+          cache->monochromators, this->communicator);
+  auto cached_spectracq3s =
+      devices_of_list<horiba::devices::single_devices::SpectrAcq3>(
+          cache->spectracq3s, this->communicator);
+
+  // a configuration that does not parse is fetched again when needed
+  const auto preload = [&cache](auto& device, const nlohmann::json& list) {
+    const auto configuration = cache->configurations.find(
+        serial_number_of(list, device->device_id()));
+    if (configuration == cache->configurations.end()) {
+      return;
+    }
+    try {
+      device->preload_capabilities(configuration->second,
+                                   configuration->first);
+    } catch (const std::exception& e) {
+      spdlog::warn("[ICLDeviceManager] cached configuration ignored: {}",
+                   e.what());
+    }
+  };
+  for (auto& ccd : cached_ccds) {
+    preload(ccd, cache->charge_coupled_devices);
+  }
+  for (auto& mono : cached_monos) {
+    preload(mono, cache->monochromators);
+  }
+
+  spdlog::info(
+      "[ICLDeviceManager] {} CCDs, {} monochromators and {} SpectrAcq3s "
+      "taken from the discovery cache",
+      cached_ccds.size(), cached_monos.size(), cached_spectracq3s.size());
+  {
+    const std::lock_guard<std::mutex> lock(this->devices_mutex);
+    this->ccds = std::move(cached_ccds);
+    this->monos = std::move(cached_monos);
+    this->spectracq3s = std::move(cached_spectracq3s);
+    this->discovered = *cache;
+  }
+  this->record_fetched_configurations();
+
+  this->cache_check =
+      std::async(std::launch::async,
+                 [this, cache = *cache]() {
+                   return this->check_cached_devices(cache);
+                 })
+          .share();
+  return true;
+}
+
+void ICLDeviceManager::record_fetched_configurations() {
+  const std::lock_guard<std::mutex> lock(this->devices_mutex);
+  const auto record = [this](auto& device, const nlohmann::json& list) {
+    auto serial_number = serial_number_of(list, device->device_id());
+    if (serial_number.empty()) {
+      return;
+    }
+    device->set_capabilities_listener(
+        [fetched = this->fetched_configurations,
+         serial_number = std::move(serial_number)](
+            const nlohmann::json& configuration) {
+          const std::lock_guard<std::mutex> fetched_lock(fetched->mutex);
+          fetched->by_serial_number[serial_number] = configuration;
+        });
+  };
+  for (auto& ccd : this->ccds) {
+    record(ccd, this->discovered.charge_coupled_devices);
+  }
+  for (auto& mono : this->monos) {
+    record(mono, this->discovered.monochromators);
+  }
+}
+
+bool ICLDeviceManager::check_cached_devices(const DiscoveryCache& cache) {
+  // an error is rethrown by wait_for_cache_check()
+  if (DiscoveryCache::same_devices(
+          cache.charge_coupled_devices,
+          listed_devices(*this->communicator, "ccd_list")) &&
+      DiscoveryCache::same_devices(
+          cache.monochromators,
+          listed_devices(*this->communicator, "mono_list")) &&
+      DiscoveryCache::same_devices(
+          cache.spectracq3s,
+          listed_devices(*this->communicator, "saq3_list"))) {
+    spdlog::debug("[ICLDeviceManager] cached devices confirmed by the ICL");
+    return true;
+  }
+  spdlog::warn(
+      "[ICLDeviceManager] the ICL lists other devices than the discovery "
+      "cache, discover_devices() replaces them");
+  return false;
+}
+
+void ICLDeviceManager::await_icl_ready(
+    std::chrono::steady_clock::time_point deadline, StartupTiming& timing) {
+  const auto probing_started = std::chrono::steady_clock::now();
+  auto backoff = this->readiness.initial_backoff;
+
+  while (true) {
+    timing.attempts++;
+    std::string failure;
+    try {
+      if (!this->communicator->is_open()) {
+        this->communicator->open();
+      }
+      const auto connected = std::chrono::steady_clock::now();
+
+      auto info = this->communicator->request_async(
+          communication::Command("icl_info", {}));
+      if (info.wait_until(deadline) != std::future_status::ready) {
+        throw std::runtime_error("icl_info was not answered");
+      }
+      const auto response = info.get();
+      if (response.errors().empty()) {
+        timing.connect = std::chrono::duration_cast<std::chrono::microseconds>(
+            connected - probing_started);
+        timing.probe = elapsed_since(connected);
+        spdlog::debug("[ICLDeviceManager] ICL info: {}",
+                      response.raw_results());
+        return;
+      }
+      // the ICL is up but not ready yet
+      failure = response.errors().front();
+    } catch (const std::exception& e) {
+      failure = e.what();
+      if (this->communicator->is_open()) {
+        this->communicator->close();
+      }
+    }
+
+    spdlog::debug("[ICLDeviceManager] ICL not ready after {} attempts: {}",
+                  timing.attempts, failure);
+    if (std::chrono::steady_clock::now() + backoff >= deadline) {
+      if (this->communicator->is_open()) {
+        this->communicator->close();
+      }
+      spdlog::error("[ICLDeviceManager] ICL not ready before the deadline: {}",
+                    failure);
+      throw std::runtime_error("ICL did not answer before the deadline: " +
+                               failure);
+    }
+    std::this_thread::sleep_for(backoff);
+    backoff = std::min(backoff * 2, this->readiness.max_backoff);
+  }
+}
+
 void ICLDeviceManager::enable_binary_messages_on_icl() {
   spdlog::debug("[ICLDeviceManager] enable binary messages on the ICL");
 
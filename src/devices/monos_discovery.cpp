@@ -6,6 +6,7 @@
 #include <memory>
 #include <stdexcept>
 #include <string>
+#include <utility>
 
 #include "spdlog/common.h"
 
@@ -25,11 +26,15 @@ void MonochromatorsDiscovery::execute(bool error_on_no_devices) {
 
   const auto response = this->communicator->request_with_response(
       communication::Command("mono_list", {}));
-  if (response.json_results().empty() && error_on_no_devices) {
+  auto results = response.json_results();
+  if (results.empty() && error_on_no_devices) {
     throw std::runtime_error("No Monochromators connected");
   }
 
-  auto raw_monos_list = response.json_results()["devices"];
+  auto raw_monos_list = std::move(results["devices"]);
+  if (raw_monos_list.is_array()) {
+    this->listed_devices = raw_monos_list;
+  }
   this->monos = this->parse_monos(raw_monos_list);
 }
 
@@ -38,6 +43,10 @@ MonochromatorsDiscovery::monochromators() const {
   return this->monos;
 }
 
+nlohmann::json MonochromatorsDiscovery::devices_list() const {
+  return this->listed_devices;
+}
+
 std::vector<std::shared_ptr<single_devices::Monochromator>>
 MonochromatorsDiscovery::parse_monos(const nlohmann::json& raw_monos_list) {
   spdlog::info("[MonochromatorsDiscovery] detected #{} monos",
@@ -0,0 +1,155 @@
+#include "horiba_cpp_sdk/devices/range_mode_calculator.h"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace horiba::devices {
+
+namespace {
+// halvings of the search interval when solving for a center wavelength
+constexpr int BISECTION_STEPS = 100;
+constexpr double ROUNDING_TOLERANCE = 1e-12;
+
+double to_radians(double degrees) { return degrees * std::numbers::pi / 180.0; }
+}  // namespace
+
+RangeModeCalculator::RangeModeCalculator(double groove_density, int chip_width,
+                                         SpectrographGeometry geometry)
+    : groove_spacing{0.0},
+      chip_width{chip_width},
+      geometry{geometry},
+      half_angle{to_radians(geometry.included_angle_deg) / 2.0} {
+  if (groove_density <= 0.0) {
+    throw std::invalid_argument("groove density must be positive");
+  }
+  if (chip_width <= 1) {
+    throw std::invalid_argument("chip width must be more than one pixel");
+  }
+  if (geometry.focal_length_mm <= 0.0 || geometry.pixel_width_um <= 0.0) {
+    throw std::invalid_argument(
+        "focal length and pixel width must be positive");
+  }
+  if (geometry.included_angle_deg < 0.0 ||
+      geometry.included_angle_deg >= 180.0) {
+    throw std::invalid_argument(
+        "included angle must be between 0 and 180 degrees");
+  }
+  if (geometry.diffraction_order <= 0) {
+    throw std::invalid_argument("diffraction order must be positive");
+  }
+  // grooves per mm to the grating period in nm
+  this->groove_spacing = 1e6 / groove_density;
+}
+
+RangeModeCalculator RangeModeCalculator::from_devices(
+    single_devices::ChargeCoupledDevice& ccd,
+    single_devices::Monochromator& mono,
+    single_devices::Monochromator::Grating grating,
+    SpectrographGeometry geometry) {
+  const auto mono_capabilities = mono.capabilities();
+  const auto position_index = static_cast<int>(grating);
+  const auto installed = std::ranges::find_if(
+      mono_capabilities->gratings,
+      [position_index](const single_devices::MonochromatorGrating& candidate) {
+        return candidate.position_index == position_index;
+      });
+  if (installed == mono_capabilities->gratings.end()) {
+    throw std::invalid_argument("grating is not installed");
+  }
+  return {installed->groove_density, ccd.capabilities()->chip_width,
+          geometry};
+}
+
+double RangeModeCalculator::wavelength_at_pixel(double center_wavelength,
+                                                double pixel) const {
+  const auto order = static_cast<double>(this->geometry.diffraction_order);
+  // grating equation at the center of the chip: m * lambda = d * (sin(alpha)
+  // + sin(beta)) with alpha - beta fixed to the included angle
+  const auto sine = order * center_wavelength /
+                    (2.0 * this->groove_spacing * std::cos(this->half_angle));
+  if (sine < 0.0 || sine > 1.0 + ROUNDING_TOLERANCE) {
+    throw std::invalid_argument("grating cannot reach the wavelength");
+  }
+  const auto rotation = std::asin(std::min(sine, 1.0));
+  const auto incidence = rotation + this->half_angle;
+  const auto center_diffraction = rotation - this->half_angle;
+
+  // a pixel off the center of the chip sees light diffracted at a slightly
+  // different angle
+  const auto offset_mm = (pixel - (this->chip_width - 1) / 2.0) *
+                         this->geometry.pixel_width_um / 1000.0;
+  const auto diffraction =
+      center_diffraction +
+      std::atan(offset_mm / this->geometry.focal_length_mm);
+  return this->groove_spacing *
+         (std::sin(incidence) + std::sin(diffraction)) / order;
+}
+
+std::pair<double, double> RangeModeCalculator::coverage(
+    double center_wavelength) const {
+  return {this->wavelength_at_pixel(center_wavelength, 0.0),
+          this->wavelength_at_pixel(center_wavelength, this->chip_width - 1)};
+}
+
+std::vector<double> RangeModeCalculator::center_wavelengths(
+    double start_wavelength, double end_wavelength,
+    double minimum_overlap_pixels) const {
+  if (start_wavelength >= end_wavelength) {
+    throw std::invalid_argument(
+        "start wavelength must be lower than end wavelength");
+  }
+  const auto last_pixel = static_cast<double>(this->chip_width - 1);
+  if (minimum_overlap_pixels < 0.0 || minimum_overlap_pixels >= last_pixel) {
+    throw std::invalid_argument("overlap must fit on the chip");
+  }
+
+  // each segment starts where the previous one leaves the overlap, so no
+  // segment covers more of the range twice than needed
+  std::vector<double> centers;
+  auto segment_start = start_wavelength;
+  while (true) {
+    const auto center = this->center_for_pixel(0.0, segment_start);
+    centers.push_back(center);
+    if (this->wavelength_at_pixel(center, last_pixel) >= end_wavelength) {
+      break;
+    }
+    if (centers.size() >= MAX_SEGMENTS) {
+      throw std::invalid_argument("range needs too many segments");
+    }
+    segment_start =
+        this->wavelength_at_pixel(center, last_pixel - minimum_overlap_pixels);
+  }
+  spdlog::debug("[RangeModeCalculator] {} segments cover {} nm to {} nm",
+                centers.size(), start_wavelength, end_wavelength);
+  return centers;
+}
+
+double RangeModeCalculator::center_for_pixel(double pixel,
+                                             double wavelength) const {
+  // the wavelength of a pixel increases with the center wavelength, up to
+  // the center wavelength diffracted at the largest angle
+  const auto order = static_cast<double>(this->geometry.diffraction_order);
+  auto low = 0.0;
+  auto high = 2.0 * this->groove_spacing * std::cos(this->half_angle) / order;
+  if (wavelength < this->wavelength_at_pixel(low, pixel) ||
+      wavelength > this->wavelength_at_pixel(high, pixel)) {
+    throw std::invalid_argument("grating cannot reach the wavelength");
+  }
+  for (int step = 0; step < BISECTION_STEPS; step++) {
+    const auto middle = (low + high) / 2.0;
+    if (this->wavelength_at_pixel(middle, pixel) < wavelength) {
+      low = middle;
+    } else {
+      high = middle;
+    }
+  }
+  return (low + high) / 2.0;
+}
+
+} /* namespace horiba::devices */
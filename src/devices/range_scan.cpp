@@ -0,0 +1,200 @@
+#include "horiba_cpp_sdk/devices/range_scan.h"
+
+#include <horiba_cpp_sdk/core/stitching/simple_spectra_stitch.h>
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <chrono>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace horiba::devices {
+
+namespace {
+std::chrono::microseconds elapsed_since(
+    std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - start);
+}
+}  // namespace
+
+RangeScan::RangeScan(std::shared_ptr<single_devices::ChargeCoupledDevice> ccd,
+                     std::shared_ptr<single_devices::Monochromator> mono,
+                     Options options)
+    : ccd{std::move(ccd)}, mono{std::move(mono)}, options{options} {
+  if (!this->ccd || !this->mono) {
+    throw std::invalid_argument("ccd and mono must not be null");
+  }
+  if (this->options.start_wavelength >= this->options.end_wavelength) {
+    throw std::invalid_argument(
+        "start wavelength must be lower than end wavelength");
+  }
+}
+
+RangeScan::Result RangeScan::run() {
+  const auto center_wavelengths = this->ccd->range_mode_center_wavelenghts(
+      this->mono->device_id(), this->options.start_wavelength,
+      this->options.end_wavelength, this->options.pixel_overlap);
+  return this->run(center_wavelengths);
+}
+
+RangeScan::Result RangeScan::run(
+    const std::vector<double>& center_wavelengths) {
+  if (center_wavelengths.empty()) {
+    throw std::invalid_argument("at least one center wavelength is required");
+  }
+  {
+    const std::lock_guard<std::mutex> lock(this->mutex);
+    this->fetched.clear();
+    this->acquiring_done = false;
+    this->stopping = false;
+    this->error = nullptr;
+  }
+
+  // sized up front, the threads fill in different fields of the segments
+  Result result;
+  result.segments.resize(center_wavelengths.size());
+  result.timings.resize(center_wavelengths.size());
+  for (std::size_t i = 0; i < center_wavelengths.size(); i++) {
+    result.timings[i].center_wavelength = center_wavelengths[i];
+  }
+
+  const auto started = std::chrono::steady_clock::now();
+  std::thread processing_thread([this, &result]() { this->process(result); });
+  try {
+    this->acquire(center_wavelengths, result);
+  } catch (...) {
+    spdlog::error("[RangeScan] acquisition failed");
+    this->fail(std::current_exception());
+  }
+  {
+    const std::lock_guard<std::mutex> lock(this->mutex);
+    this->acquiring_done = true;
+  }
+  this->changed.notify_all();
+  processing_thread.join();
+
+  if (this->error) {
+    std::rethrow_exception(this->error);
+  }
+  result.duration = elapsed_since(started);
+  spdlog::debug("[RangeScan] scanned {} segments in {} us",
+                center_wavelengths.size(), result.duration.count());
+  return result;
+}
+
+void RangeScan::acquire(const std::vector<double>& center_wavelengths,
+                        Result& result) {
+  auto move_started = std::chrono::steady_clock::now();
+  this->mono->move_to_target_wavelength(center_wavelengths[0]);
+
+  for (std::size_t i = 0; i < center_wavelengths.size(); i++) {
+    {
+      const std::lock_guard<std::mutex> lock(this->mutex);
+      if (this->stopping) {
+        return;
+      }
+    }
+
+    auto& timing = result.timings[i];
+    this->mono->wait_until_ready(this->options.move_timeout);
+    timing.move = elapsed_since(move_started);
+
+    this->ccd->set_center_wavelength(this->mono->device_id(),
+                                     center_wavelengths[i]);
+    const auto acquisition_started = std::chrono::steady_clock::now();
+    this->ccd->set_acquisition_start(this->options.open_shutter);
+    this->ccd->wait_until_acquisition_done(this->options.acquisition_timeout);
+    timing.exposure = elapsed_since(acquisition_started);
+
+    // the shutter is closed, the monochromator moves on while the data of
+    // this segment is transferred
+    if (i + 1 < center_wavelengths.size()) {
+      move_started = std::chrono::steady_clock::now();
+      this->mono->move_to_target_wavelength(center_wavelengths[i + 1]);
+    }
+
+    const auto transfer_started = std::chrono::steady_clock::now();
+    FetchedSegment segment{i, this->ccd->fetch_acquisition_data()};
+    timing.transfer = elapsed_since(transfer_started);
+    {
+      const std::lock_guard<std::mutex> lock(this->mutex);
+      this->fetched.push_back(std::move(segment));
+    }
+    this->changed.notify_all();
+  }
+}
+
+void RangeScan::process(Result& result) {
+  std::vector<std::vector<double>> stitched;
+  while (true) {
+    FetchedSegment segment;
+    {
+      std::unique_lock<std::mutex> lock(this->mutex);
+      this->changed.wait(lock, [this]() {
+        return this->stopping || this->acquiring_done ||
+               !this->fetched.empty();
+      });
+      if (this->stopping || this->fetched.empty()) {
+        break;
+      }
+      segment = std::move(this->fetched.front());
+      this->fetched.pop_front();
+    }
+
+    try {
+      auto& timing = result.timings[segment.index];
+      const auto decode_started = std::chrono::steady_clock::now();
+      const auto data =
+          single_devices::ChargeCoupledDevice::decode_acquisition_data(
+              segment.response);
+      if (data.acquisitions().empty() ||
+          data.acquisitions()[0].regions_of_interest.empty()) {
+        throw std::runtime_error("segment without acquisition data");
+      }
+      const auto& roi = data.acquisitions()[0].regions_of_interest[0];
+      std::vector<double> x_data(roi.x_data().begin(), roi.x_data().end());
+      std::vector<double> y_data(roi.row(0).begin(), roi.row(0).end());
+      // the x axis of a CCD usually decreases
+      if (!x_data.empty() && x_data.front() > x_data.back()) {
+        std::ranges::reverse(x_data);
+        std::ranges::reverse(y_data);
+      }
+      timing.decode = elapsed_since(decode_started);
+
+      const auto stitch_started = std::chrono::steady_clock::now();
+      auto& spectrum = result.segments[segment.index];
+      spectrum = {std::move(x_data), std::move(y_data)};
+      if (stitched.empty()) {
+        stitched = spectrum;
+      } else {
+        stitched = core::stitching::SimpleSpectraStitch({stitched, spectrum})
+                       .stitched_spectra();
+      }
+      timing.stitch = elapsed_since(stitch_started);
+    } catch (...) {
+      spdlog::error("[RangeScan] processing failed");
+      this->fail(std::current_exception());
+      break;
+    }
+  }
+  result.spectrum = std::move(stitched);
+}
+
+void RangeScan::fail(std::exception_ptr failure) {
+  {
+    const std::lock_guard<std::mutex> lock(this->mutex);
+    if (!this->error) {
+      this->error = std::move(failure);
+    }
+    this->stopping = true;
+  }
+  this->changed.notify_all();
+}
+
+} /* namespace horiba::devices */
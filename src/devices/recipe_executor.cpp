@@ -0,0 +1,258 @@
+#include "horiba_cpp_sdk/devices/recipe_executor.h"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <chrono>
+#include <exception>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace horiba::devices {
+
+namespace {
+std::chrono::microseconds elapsed_since(
+    std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - start);
+}
+}  // namespace
+
+Recipe::Step::Step(
+    std::string step_name,
+    std::vector<std::shared_ptr<single_devices::Device>> used_devices,
+    std::function<void()> step_operation, std::vector<StepId> dependencies)
+    : name{std::move(step_name)},
+      devices{std::move(used_devices)},
+      operation{std::move(step_operation)},
+      after{std::move(dependencies)} {}
+
+Recipe::StepId Recipe::add(Step step) {
+  if (!step.operation) {
+    throw std::invalid_argument("step " + step.name + " has no operation");
+  }
+  if (std::ranges::any_of(step.devices,
+                          [](const auto& device) { return !device; })) {
+    throw std::invalid_argument("step " + step.name + " uses a null device");
+  }
+  if (std::ranges::any_of(step.after, [this](const StepId dependency) {
+        return dependency >= this->recipe_steps.size();
+      })) {
+    throw std::invalid_argument("step " + step.name +
+                                " depends on a step not added yet");
+  }
+  // a step listing a device twice would wait for itself on that device
+  std::set<const single_devices::Device*> listed;
+  std::erase_if(step.devices, [&listed](const auto& device) {
+    return !listed.insert(device.get()).second;
+  });
+  this->recipe_steps.push_back(std::move(step));
+  return this->recipe_steps.size() - 1;
+}
+
+const std::vector<Recipe::Step>& Recipe::steps() const {
+  return this->recipe_steps;
+}
+
+std::vector<std::vector<Recipe::StepId>> Recipe::dependencies() const {
+  std::vector<std::vector<StepId>> graph(this->recipe_steps.size());
+  std::map<const single_devices::Device*, StepId> last_on_device;
+  for (StepId id = 0; id < this->recipe_steps.size(); id++) {
+    const auto& step = this->recipe_steps[id];
+    auto& dependencies = graph[id];
+    dependencies = step.after;
+    // a device executes one step at a time, in the order of the recipe
+    for (const auto& device : step.devices) {
+      const auto [last, first_use] =
+          last_on_device.try_emplace(device.get(), id);
+      if (!first_use) {
+        dependencies.push_back(last->second);
+        last->second = id;
+      }
+    }
+    std::ranges::sort(dependencies);
+    const auto duplicates = std::ranges::unique(dependencies);
+    dependencies.erase(duplicates.begin(), duplicates.end());
+  }
+  return graph;
+}
+
+RecipeExecutor::RecipeExecutor(std::size_t workers) : max_workers{workers} {}
+
+RecipeExecutor::Report RecipeExecutor::run(const Recipe& recipe) {
+  const auto& steps = recipe.steps();
+  const auto graph = recipe.dependencies();
+
+  Report report;
+  report.steps.resize(steps.size());
+  {
+    const std::lock_guard<std::mutex> lock(this->mutex);
+    this->ready.clear();
+    this->waiting_for.assign(steps.size(), 0);
+    this->dependents.assign(steps.size(), {});
+    this->remaining = steps.size();
+    this->error = nullptr;
+    for (Recipe::StepId id = 0; id < steps.size(); id++) {
+      report.steps[id].name = steps[id].name;
+      this->waiting_for[id] = graph[id].size();
+      for (const auto dependency : graph[id]) {
+        this->dependents[dependency].push_back(id);
+      }
+      if (graph[id].empty()) {
+        this->ready.push_back(id);
+      }
+    }
+  }
+
+  // one worker per device is enough for the device steps, the steps without
+  // device may additionally use all cores
+  auto workers = this->max_workers;
+  if (workers == 0) {
+    std::set<const single_devices::Device*> devices;
+    std::size_t processing_steps = 0;
+    for (const auto& step : steps) {
+      for (const auto& device : step.devices) {
+        devices.insert(device.get());
+      }
+      if (step.devices.empty()) {
+        processing_steps++;
+      }
+    }
+    const std::size_t cores =
+        std::max(1U, std::thread::hardware_concurrency());
+    workers = devices.size() + std::min(processing_steps, cores);
+  }
+  workers = std::min(workers, steps.size());
+
+  const auto started = std::chrono::steady_clock::now();
+  std::vector<std::thread> threads;
+  threads.reserve(workers);
+  for (std::size_t i = 0; i < workers; i++) {
+    threads.emplace_back([this, &recipe, started, &report]() {
+      this->work(recipe, started, report);
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  if (this->error) {
+    std::rethrow_exception(this->error);
+  }
+  report.duration = elapsed_since(started);
+  analyse(recipe, graph, report);
+  spdlog::debug(
+      "[RecipeExecutor] executed {} steps in {} us, critical path {} us",
+      steps.size(), report.duration.count(),
+      report.critical_path_duration.count());
+  return report;
+}
+
+void RecipeExecutor::work(const Recipe& recipe,
+                          std::chrono::steady_clock::time_point started,
+                          Report& report) {
+  while (true) {
+    Recipe::StepId id = 0;
+    {
+      std::unique_lock<std::mutex> lock(this->mutex);
+      this->changed.wait(lock, [this]() {
+        return this->error || this->remaining == 0 || !this->ready.empty();
+      });
+      if (this->error || this->ready.empty()) {
+        return;
+      }
+      id = this->ready.front();
+      this->ready.pop_front();
+    }
+
+    const auto& step = recipe.steps()[id];
+    const auto start = elapsed_since(started);
+    try {
+      step.operation();
+    } catch (...) {
+      spdlog::error("[RecipeExecutor] step {} failed", step.name);
+      {
+        const std::lock_guard<std::mutex> lock(this->mutex);
+        if (!this->error) {
+          this->error = std::current_exception();
+        }
+      }
+      this->changed.notify_all();
+      return;
+    }
+    const auto end = elapsed_since(started);
+
+    {
+      const std::lock_guard<std::mutex> lock(this->mutex);
+      report.steps[id].start = start;
+      report.steps[id].end = end;
+      this->remaining--;
+      for (const auto dependent : this->dependents[id]) {
+        if (--this->waiting_for[dependent] == 0) {
+          this->ready.push_back(dependent);
+        }
+      }
+    }
+    this->changed.notify_all();
+  }
+}
+
+void RecipeExecutor::analyse(
+    const Recipe& recipe, const std::vector<std::vector<Recipe::StepId>>& graph,
+    Report& report) {
+  const auto& steps = recipe.steps();
+  if (steps.empty()) {
+    return;
+  }
+
+  // steps only depend on earlier steps, so the ids are a topological order
+  std::vector<std::chrono::microseconds> longest(steps.size());
+  std::vector<std::optional<Recipe::StepId>> previous(steps.size());
+  for (Recipe::StepId id = 0; id < steps.size(); id++) {
+    std::chrono::microseconds before{0};
+    for (const auto dependency : graph[id]) {
+      if (longest[dependency] > before || !previous[id]) {
+        before = longest[dependency];
+        previous[id] = dependency;
+      }
+    }
+    longest[id] = before + (report.steps[id].end - report.steps[id].start);
+  }
+  std::optional<Recipe::StepId> step =
+      static_cast<Recipe::StepId>(std::ranges::max_element(longest) -
+                                  longest.begin());
+  report.critical_path_duration = longest[*step];
+  while (step) {
+    report.critical_path.push_back(*step);
+    step = previous[*step];
+  }
+  std::ranges::reverse(report.critical_path);
+
+  std::map<const single_devices::Device*, std::size_t> usage_of;
+  for (Recipe::StepId id = 0; id < steps.size(); id++) {
+    for (const auto& device : steps[id].devices) {
+      const auto [usage, added] =
+          usage_of.try_emplace(device.get(), report.devices.size());
+      if (added) {
+        report.devices.push_back({device});
+      }
+      report.devices[usage->second].busy +=
+          report.steps[id].end - report.steps[id].start;
+    }
+  }
+  for (auto& usage : report.devices) {
+    usage.idle = std::max(std::chrono::microseconds{0},
+                          report.duration - usage.busy);
+  }
+}
+
+} /* namespace horiba::devices */
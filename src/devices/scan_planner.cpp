@@ -0,0 +1,405 @@
+#include "horiba_cpp_sdk/devices/scan_planner.h"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <optional>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace horiba::devices {
+
+using single_devices::Monochromator;
+using Profile = Monochromator::Profile;
+
+namespace {
+/**
+ * @brief Largest travel of the locations whose wanted position differs from
+ * the current one, nothing if none differs.
+ */
+template <typename Location, typename Position, typename Travel>
+std::optional<double> changed_travel(
+    const std::map<Location, Position>& wanted,
+    const std::map<Location, Position>& current, Travel travel) {
+  std::optional<double> largest;
+  for (const auto& [location, position] : wanted) {
+    const auto found = current.find(location);
+    if (found != current.end() && found->second == position) {
+      continue;
+    }
+    const auto distance = found == current.end()
+                              ? travel(std::nullopt, position)
+                              : travel(found->second, position);
+    largest = std::max(largest.value_or(0.0), distance);
+  }
+  return largest;
+}
+
+/**
+ * @brief Whether the current position of every wanted location is known, so
+ * that the travel of the move to the wanted positions is known.
+ */
+template <typename Location, typename Position>
+bool known_start(const std::map<Location, Position>& wanted,
+                 const std::map<Location, Position>& current) {
+  return std::ranges::all_of(wanted, [&current](const auto& location) {
+    return current.contains(location.first);
+  });
+}
+
+/**
+ * @brief Kind of the moves of an axis, whose durations are fitted apart.
+ */
+single_devices::MoveKind move_kind(MoveCostModel::Axis axis) {
+  using Axis = MoveCostModel::Axis;
+  using single_devices::MoveKind;
+  switch (axis) {
+    case Axis::GRATING:
+      return MoveKind::GRATING;
+    case Axis::WAVELENGTH:
+      return MoveKind::WAVELENGTH;
+    case Axis::MIRROR:
+      return MoveKind::MIRROR;
+    case Axis::SLIT:
+      return MoveKind::SLIT;
+    case Axis::FILTER_WHEEL:
+      return MoveKind::FILTER_WHEEL;
+  }
+  return MoveKind::OTHER;
+}
+
+double mirror_travel(std::optional<Monochromator::MirrorPosition> /*from*/,
+                     Monochromator::MirrorPosition /*to*/) {
+  return 1.0;
+}
+
+double slit_travel(std::optional<double> from, double to) {
+  return from ? std::abs(to - *from) : to;
+}
+
+double filter_wheel_travel(
+    std::optional<Monochromator::FilterWheelPosition> from,
+    Monochromator::FilterWheelPosition to) {
+  return from ? std::abs(static_cast<double>(static_cast<int>(to) -
+                                             static_cast<int>(*from)))
+              : 1.0;
+}
+
+double grating_travel(std::optional<Monochromator::Grating> from,
+                      Monochromator::Grating to) {
+  return from ? std::abs(static_cast<double>(static_cast<int>(to) -
+                                             static_cast<int>(*from)))
+              : 1.0;
+}
+
+/**
+ * @brief Settings after moving from a profile to a point, the wavelength is
+ * forgotten when the grating changes, like in Monochromator::apply().
+ */
+Profile after(Profile state, const Profile& point) {
+  if (point.turret_grating && point.turret_grating != state.turret_grating) {
+    state.turret_grating = point.turret_grating;
+    state.wavelength.reset();
+  }
+  if (point.wavelength) {
+    state.wavelength = point.wavelength;
+  }
+  for (const auto& [mirror, position] : point.mirror_positions) {
+    state.mirror_positions[mirror] = position;
+  }
+  for (const auto& [slit, position] : point.slit_positions_in_mm) {
+    state.slit_positions_in_mm[slit] = position;
+  }
+  for (const auto& [filter_wheel, position] : point.filter_wheel_positions) {
+    state.filter_wheel_positions[filter_wheel] = position;
+  }
+  return state;
+}
+
+struct Walk {
+  std::vector<std::size_t> order;
+  std::chrono::microseconds cost{0};
+  Profile end;
+};
+
+Walk walk(const MoveCostModel& model, const std::vector<Profile>& points,
+          std::vector<std::size_t> order, Profile state) {
+  Walk result;
+  for (const auto index : order) {
+    result.cost += model.transition(state, points[index]);
+    state = after(std::move(state), points[index]);
+  }
+  result.order = std::move(order);
+  result.end = std::move(state);
+  return result;
+}
+
+/**
+ * @brief Cheapest order of a group, sweeping the wavelength upwards either
+ * once or once per slit and mirror setting.
+ */
+Walk walk_group(const MoveCostModel& model, const std::vector<Profile>& points,
+                const std::vector<std::size_t>& group, const Profile& start) {
+  auto sweep = group;
+  std::ranges::stable_sort(sweep, [&points](auto left, auto right) {
+    return points[left].wavelength < points[right].wavelength;
+  });
+  auto per_setting = group;
+  std::ranges::stable_sort(per_setting, [&points](auto left, auto right) {
+    return std::tie(points[left].slit_positions_in_mm,
+                    points[left].mirror_positions, points[left].wavelength) <
+           std::tie(points[right].slit_positions_in_mm,
+                    points[right].mirror_positions, points[right].wavelength);
+  });
+
+  auto single_sweep = walk(model, points, std::move(sweep), start);
+  auto setting_sweeps = walk(model, points, std::move(per_setting), start);
+  return setting_sweeps.cost < single_sweep.cost ? std::move(setting_sweeps)
+                                                 : std::move(single_sweep);
+}
+}  // namespace
+
+MoveCostModel::MoveCostModel() {
+  using std::chrono::milliseconds;
+  this->set_prior(Axis::GRATING, {milliseconds(15000), milliseconds(5000)});
+  // from an unknown wavelength, a move across half of a typical range
+  this->set_prior(Axis::WAVELENGTH,
+                  {milliseconds(100), milliseconds(2), 500.0});
+  this->set_prior(Axis::MIRROR, {milliseconds(500), milliseconds(0)});
+  this->set_prior(Axis::SLIT, {milliseconds(200), milliseconds(500)});
+  this->set_prior(Axis::FILTER_WHEEL, {milliseconds(500), milliseconds(500)});
+}
+
+void MoveCostModel::set_prior(Axis axis, Prior prior) {
+  const std::lock_guard<std::mutex> lock(this->priors_mutex);
+  this->priors.at(static_cast<std::size_t>(axis)) = prior;
+}
+
+MoveCostModel::Prior MoveCostModel::prior(Axis axis) const {
+  const std::lock_guard<std::mutex> lock(this->priors_mutex);
+  return this->priors.at(static_cast<std::size_t>(axis));
+}
+
+void MoveCostModel::record(Axis axis, double travel,
+                           std::chrono::microseconds duration) {
+  this->fits.record({move_kind(axis), travel}, duration);
+}
+
+std::chrono::microseconds MoveCostModel::predict(Axis axis,
+                                                 double travel) const {
+  if (const auto fitted = this->fits.predict({move_kind(axis), travel})) {
+    return *fitted;
+  }
+  const auto prior = this->prior(axis);
+  return prior.fixed +
+         std::chrono::microseconds(static_cast<long long>(
+             static_cast<double>(prior.per_unit.count()) * std::abs(travel)));
+}
+
+std::chrono::microseconds MoveCostModel::transition(const Profile& from,
+                                                    const Profile& to) const {
+  std::chrono::microseconds cost{0};
+
+  const auto grating_changes =
+      to.turret_grating.has_value() && to.turret_grating != from.turret_grating;
+  if (grating_changes) {
+    cost += this->predict(
+        Axis::GRATING, grating_travel(from.turret_grating, *to.turret_grating));
+  }
+
+  // the wavelength is moved again after a grating change, the travel is
+  // estimated from the wavelength before it
+  if (to.wavelength && (grating_changes || to.wavelength != from.wavelength)) {
+    cost += this->predict(
+        Axis::WAVELENGTH,
+        from.wavelength ? std::abs(*to.wavelength - *from.wavelength)
+                        : this->prior(Axis::WAVELENGTH).unknown_start_travel);
+  }
+
+  std::chrono::microseconds slowest{0};
+  if (const auto travel = changed_travel(
+          to.mirror_positions, from.mirror_positions, mirror_travel)) {
+    slowest = std::max(slowest, this->predict(Axis::MIRROR, *travel));
+  }
+  if (const auto travel = changed_travel(
+          to.slit_positions_in_mm, from.slit_positions_in_mm, slit_travel)) {
+    slowest = std::max(slowest, this->predict(Axis::SLIT, *travel));
+  }
+  if (const auto travel =
+          changed_travel(to.filter_wheel_positions,
+                         from.filter_wheel_positions, filter_wheel_travel)) {
+    slowest = std::max(slowest, this->predict(Axis::FILTER_WHEEL, *travel));
+  }
+  return cost + slowest;
+}
+
+ScanPlanner::ScanPlanner(std::shared_ptr<MoveCostModel> model)
+    : cost_model{std::move(model)} {
+  if (!this->cost_model) {
+    throw std::invalid_argument("move cost model must not be null");
+  }
+}
+
+ScanPlanner::Plan ScanPlanner::plan(const std::vector<Profile>& points,
+                                    const Profile& start) const {
+  std::map<std::pair<std::optional<Monochromator::Grating>,
+                     std::map<Monochromator::FilterWheel,
+                              Monochromator::FilterWheelPosition>>,
+           std::vector<std::size_t>>
+      grouped;
+  for (std::size_t index = 0; index < points.size(); index++) {
+    grouped[{points[index].turret_grating,
+             points[index].filter_wheel_positions}]
+        .push_back(index);
+  }
+  std::vector<std::vector<std::size_t>> groups;
+  groups.reserve(grouped.size());
+  for (auto& [key, group] : grouped) {
+    groups.push_back(std::move(group));
+  }
+
+  // walks the groups in the given order, each in its cheapest order
+  const auto walk_groups = [this, &points, &groups,
+                            &start](const std::vector<std::size_t>& order) {
+    Plan plan;
+    Profile state = start;
+    for (const auto group : order) {
+      auto walked = walk_group(*this->cost_model, points, groups[group], state);
+      plan.order.insert(plan.order.end(), walked.order.begin(),
+                        walked.order.end());
+      plan.expected_duration += walked.cost;
+      state = std::move(walked.end);
+    }
+    return plan;
+  };
+
+  std::vector<std::size_t> group_order(groups.size());
+  std::iota(group_order.begin(), group_order.end(), 0);
+
+  Plan best;
+  if (groups.size() <= MAX_EXHAUSTIVE_GROUPS) {
+    best.expected_duration = std::chrono::microseconds::max();
+    do {
+      auto candidate = walk_groups(group_order);
+      if (candidate.expected_duration < best.expected_duration) {
+        best = std::move(candidate);
+      }
+    } while (std::ranges::next_permutation(group_order).found);
+  } else {
+    // nearest group first
+    std::vector<std::size_t> remaining = group_order;
+    group_order.clear();
+    Profile state = start;
+    while (!remaining.empty()) {
+      auto nearest = remaining.begin();
+      auto nearest_cost = std::chrono::microseconds::max();
+      Profile nearest_end;
+      for (auto group = remaining.begin(); group != remaining.end(); group++) {
+        auto walked =
+            walk_group(*this->cost_model, points, groups[*group], state);
+        if (walked.cost < nearest_cost) {
+          nearest = group;
+          nearest_cost = walked.cost;
+          nearest_end = std::move(walked.end);
+        }
+      }
+      group_order.push_back(*nearest);
+      remaining.erase(nearest);
+      state = std::move(nearest_end);
+    }
+    best = walk_groups(group_order);
+  }
+
+  spdlog::debug("[ScanPlanner] {} points in {} groups, expected {} us",
+                points.size(), groups.size(), best.expected_duration.count());
+  return best;
+}
+
+std::shared_ptr<MoveCostModel> ScanPlanner::model() const {
+  return this->cost_model;
+}
+
+void ScanPlanner::move_to(Monochromator& mono, const Profile& point,
+                          std::chrono::seconds timeout) {
+  using Axis = MoveCostModel::Axis;
+  const auto timed_apply = [&mono, timeout](const Profile& profile) {
+    const auto started = std::chrono::steady_clock::now();
+    const auto commands = mono.apply(profile, timeout);
+    return std::make_pair(
+        commands, std::chrono::duration_cast<std::chrono::microseconds>(
+                      std::chrono::steady_clock::now() - started));
+  };
+  const auto before = mono.known_settings();
+
+  // moves from an unknown start are not recorded, their travel is unknown
+  if (point.turret_grating) {
+    Profile grating;
+    grating.turret_grating = point.turret_grating;
+    const auto [commands, duration] = timed_apply(grating);
+    if (commands > 0 && before.turret_grating) {
+      this->cost_model->record(
+          Axis::GRATING,
+          grating_travel(before.turret_grating, *point.turret_grating),
+          duration);
+    }
+  }
+
+  if (point.wavelength) {
+    // read again, as the wavelength is forgotten when the grating moves
+    const auto start = mono.known_settings().wavelength;
+    Profile wavelength;
+    wavelength.wavelength = point.wavelength;
+    const auto [commands, duration] = timed_apply(wavelength);
+    if (commands > 0 && start) {
+      this->cost_model->record(Axis::WAVELENGTH,
+                               std::abs(*point.wavelength - *start), duration);
+    }
+  }
+
+  struct AccessoryMove {
+    Axis axis;
+    std::optional<double> travel;
+    bool known_start;
+  };
+  const std::array<AccessoryMove, 3> accessories{{
+      {Axis::MIRROR,
+       changed_travel(point.mirror_positions, before.mirror_positions,
+                      mirror_travel),
+       known_start(point.mirror_positions, before.mirror_positions)},
+      {Axis::SLIT,
+       changed_travel(point.slit_positions_in_mm, before.slit_positions_in_mm,
+                      slit_travel),
+       known_start(point.slit_positions_in_mm, before.slit_positions_in_mm)},
+      {Axis::FILTER_WHEEL,
+       changed_travel(point.filter_wheel_positions,
+                      before.filter_wheel_positions, filter_wheel_travel),
+       known_start(point.filter_wheel_positions,
+                   before.filter_wheel_positions)},
+  }};
+  Profile accessory;
+  accessory.mirror_positions = point.mirror_positions;
+  accessory.slit_positions_in_mm = point.slit_positions_in_mm;
+  accessory.filter_wheel_positions = point.filter_wheel_positions;
+  const auto [commands, duration] = timed_apply(accessory);
+
+  // accessories moving together cannot be told apart
+  const auto has_moved = [](const AccessoryMove& move) {
+    return move.travel.has_value();
+  };
+  const auto moved = std::ranges::find_if(accessories, has_moved);
+  if (commands > 0 && std::ranges::count_if(accessories, has_moved) == 1 &&
+      moved->known_start) {
+    this->cost_model->record(moved->axis, *moved->travel, duration);
+  }
+}
+
+} /* namespace horiba::devices */
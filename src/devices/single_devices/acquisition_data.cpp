@@ -0,0 +1,417 @@
+#include "horiba_cpp_sdk/devices/single_devices/acquisition_data.h"
+
+#include <algorithm>
+#include <memory>
+#include <nlohmann/json.hpp>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace horiba::devices::single_devices {
+
+/**
+ * @brief SAX handler decoding a ccd_getAcquisitionData response into an
+ * AcquisitionData, without building JSON values.
+ */
+class AcquisitionDataParser {
+ public:
+  using json = nlohmann::json;
+
+  std::string error_message;
+
+  bool null() { return true; }
+
+  bool boolean(bool /*value*/) { return true; }
+
+  bool number_integer(json::number_integer_t value) {
+    return this->number(static_cast<double>(value));
+  }
+
+  bool number_unsigned(json::number_unsigned_t value) {
+    return this->number(static_cast<double>(value));
+  }
+
+  bool number_float(json::number_float_t value, const json::string_t& /*raw*/) {
+    return this->number(value);
+  }
+
+  bool string(json::string_t& value) {
+    if (this->scope() == Scope::RESULTS && this->current_key == Key::TIMESTAMP) {
+      this->data.acquisition_timestamp = std::move(value);
+    }
+    return true;
+  }
+
+  bool binary(json::binary_t& /*value*/) { return true; }
+
+  bool start_object(std::size_t /*elements*/) {
+    if (this->scopes.empty()) {
+      this->scopes.push_back(Scope::TOP);
+      return true;
+    }
+
+    switch (this->scope()) {
+      case Scope::TOP:
+        this->scopes.push_back(this->current_key == Key::RESULTS
+                                   ? Scope::RESULTS
+                                   : Scope::IGNORED);
+        break;
+      case Scope::ACQUISITIONS:
+        this->acquisition = AcquisitionData::Acquisition{};
+        this->scopes.push_back(Scope::ACQUISITION);
+        break;
+      case Scope::REGIONS:
+        this->region = AcquisitionData::RegionOfInterest{};
+        this->region.samples_offset = this->samples.size();
+        this->x_data.clear();
+        this->scopes.push_back(Scope::REGION);
+        break;
+      default:
+        this->scopes.push_back(Scope::IGNORED);
+        break;
+    }
+    return true;
+  }
+
+  bool key(json::string_t& key) {
+    this->current_key = key_of(key);
+    return true;
+  }
+
+  bool end_object() {
+    const auto ended = this->scope();
+    this->scopes.pop_back();
+
+    if (ended == Scope::REGION) {
+      this->add_x_axis();
+      this->acquisition.regions_of_interest.push_back(std::move(this->region));
+    } else if (ended == Scope::ACQUISITION) {
+      this->data.acquisition_list.push_back(std::move(this->acquisition));
+    }
+    return true;
+  }
+
+  bool start_array(std::size_t /*elements*/) {
+    Scope array_scope = Scope::IGNORED;
+    switch (this->scope()) {
+      case Scope::RESULTS:
+        if (this->current_key == Key::ACQUISITION) {
+          array_scope = Scope::ACQUISITIONS;
+        }
+        break;
+      case Scope::ACQUISITION:
+        if (this->current_key == Key::ROI) {
+          array_scope = Scope::REGIONS;
+        }
+        break;
+      case Scope::REGION:
+        if (this->current_key == Key::X_DATA) {
+          array_scope = Scope::X_DATA;
+        } else if (this->current_key == Key::Y_DATA) {
+          this->row_length = 0;
+          array_scope = Scope::Y_DATA;
+        } else if (this->current_key == Key::XY_DATA) {
+          array_scope = Scope::XY_DATA;
+        }
+        break;
+      case Scope::X_DATA:
+        array_scope = Scope::X_DATA;
+        break;
+      case Scope::Y_DATA:
+        this->row_length = 0;
+        array_scope = Scope::Y_ROW;
+        break;
+      case Scope::XY_DATA:
+        this->pair_position = 0;
+        array_scope = Scope::XY_PAIR;
+        break;
+      default:
+        break;
+    }
+    this->scopes.push_back(array_scope);
+    return true;
+  }
+
+  bool end_array() {
+    const auto ended = this->scope();
+    this->scopes.pop_back();
+
+    switch (ended) {
+      case Scope::Y_ROW:
+        return this->end_row(this->row_length);
+      case Scope::Y_DATA:
+        // a flat array of samples is a single row
+        if (this->row_length > 0) {
+          return this->end_row(this->row_length);
+        }
+        return true;
+      case Scope::XY_DATA:
+        return this->end_row(this->samples.size() -
+                             this->region.samples_offset);
+      default:
+        return true;
+    }
+  }
+
+  bool parse_error(std::size_t /*position*/, const std::string& /*last_token*/,
+                   const nlohmann::detail::exception& exception) {
+    this->error_message = exception.what();
+    return false;
+  }
+
+  AcquisitionData result() {
+    const auto shared_samples =
+        std::make_shared<const std::vector<double>>(std::move(this->samples));
+    for (auto& acquisition : this->data.acquisition_list) {
+      for (auto& region : acquisition.regions_of_interest) {
+        region.all_samples = shared_samples;
+      }
+    }
+    this->data.x_axes_count = this->x_axes.size();
+    return std::move(this->data);
+  }
+
+ private:
+  enum class Scope {
+    TOP,
+    RESULTS,
+    ACQUISITIONS,
+    ACQUISITION,
+    REGIONS,
+    REGION,
+    X_DATA,
+    Y_DATA,
+    Y_ROW,
+    XY_DATA,
+    XY_PAIR,
+    IGNORED,
+  };
+
+  enum class Key {
+    OTHER,
+    RESULTS,
+    TIMESTAMP,
+    ACQUISITION,
+    ACQ_INDEX,
+    ROI,
+    ROI_INDEX,
+    X_ORIGIN,
+    Y_ORIGIN,
+    X_SIZE,
+    Y_SIZE,
+    X_BINNING,
+    Y_BINNING,
+    X_DATA,
+    Y_DATA,
+    XY_DATA,
+  };
+
+  std::vector<Scope> scopes;
+  Key current_key{Key::OTHER};
+
+  AcquisitionData data;
+  AcquisitionData::Acquisition acquisition;
+  AcquisitionData::RegionOfInterest region;
+
+  std::vector<double> samples;
+  std::vector<double> x_data;
+  std::vector<std::shared_ptr<const std::vector<double>>> x_axes;
+  std::size_t row_length{0};
+  std::size_t pair_position{0};
+
+  [[nodiscard]] Scope scope() const {
+    return this->scopes.empty() ? Scope::IGNORED : this->scopes.back();
+  }
+
+  static Key key_of(const std::string& key) {
+    if (key == "results") {
+      return Key::RESULTS;
+    }
+    if (key == "timestamp") {
+      return Key::TIMESTAMP;
+    }
+    if (key == "acquisition") {
+      return Key::ACQUISITION;
+    }
+    if (key == "acqIndex") {
+      return Key::ACQ_INDEX;
+    }
+    if (key == "roi") {
+      return Key::ROI;
+    }
+    if (key == "roiIndex") {
+      return Key::ROI_INDEX;
+    }
+    if (key == "xOrigin") {
+      return Key::X_ORIGIN;
+    }
+    if (key == "yOrigin") {
+      return Key::Y_ORIGIN;
+    }
+    if (key == "xSize") {
+      return Key::X_SIZE;
+    }
+    if (key == "ySize") {
+      return Key::Y_SIZE;
+    }
+    if (key == "xBinning") {
+      return Key::X_BINNING;
+    }
+    if (key == "yBinning") {
+      return Key::Y_BINNING;
+    }
+    if (key == "xData") {
+      return Key::X_DATA;
+    }
+    if (key == "yData") {
+      return Key::Y_DATA;
+    }
+    if (key == "xyData") {
+      return Key::XY_DATA;
+    }
+    return Key::OTHER;
+  }
+
+  bool number(double value) {
+    switch (this->scope()) {
+      case Scope::X_DATA:
+        this->x_data.push_back(value);
+        break;
+      case Scope::Y_DATA:
+      case Scope::Y_ROW:
+        this->samples.push_back(value);
+        this->row_length++;
+        break;
+      case Scope::XY_PAIR:
+        if (this->pair_position == 0) {
+          this->x_data.push_back(value);
+        } else if (this->pair_position == 1) {
+          this->samples.push_back(value);
+        }
+        this->pair_position++;
+        break;
+      case Scope::ACQUISITION:
+        if (this->current_key == Key::ACQ_INDEX) {
+          this->acquisition.index = static_cast<int>(value);
+        }
+        break;
+      case Scope::REGION:
+        this->region_field(static_cast<int>(value));
+        break;
+      default:
+        break;
+    }
+    return true;
+  }
+
+  void region_field(int value) {
+    switch (this->current_key) {
+      case Key::ROI_INDEX:
+        this->region.index = value;
+        break;
+      case Key::X_ORIGIN:
+        this->region.x_origin = value;
+        break;
+      case Key::Y_ORIGIN:
+        this->region.y_origin = value;
+        break;
+      case Key::X_SIZE:
+        this->region.x_size = value;
+        break;
+      case Key::Y_SIZE:
+        this->region.y_size = value;
+        break;
+      case Key::X_BINNING:
+        this->region.x_binning = value;
+        break;
+      case Key::Y_BINNING:
+        this->region.y_binning = value;
+        break;
+      default:
+        break;
+    }
+  }
+
+  bool end_row(std::size_t length) {
+    if (this->region.row_count == 0) {
+      this->region.row_length = length;
+    } else if (this->region.row_length != length) {
+      this->error_message = "rows of region of interest " +
+                            std::to_string(this->region.index) +
+                            " have different lengths";
+      return false;
+    }
+    this->region.row_count++;
+    this->row_length = 0;
+    return true;
+  }
+
+  void add_x_axis() {
+    const auto existing =
+        std::ranges::find_if(this->x_axes, [this](const auto& x_axis) {
+          return std::ranges::equal(*x_axis, this->x_data);
+        });
+    if (existing != this->x_axes.end()) {
+      this->region.x_axis = *existing;
+      return;
+    }
+
+    auto x_axis = std::make_shared<const std::vector<double>>(this->x_data);
+    this->x_axes.push_back(x_axis);
+    this->region.x_axis = std::move(x_axis);
+  }
+};
+
+AcquisitionData AcquisitionData::parse(std::string_view raw_response) {
+  AcquisitionDataParser parser;
+  if (!nlohmann::json::sax_parse(raw_response, &parser)) {
+    throw std::invalid_argument("invalid acquisition data: " +
+                                parser.error_message);
+  }
+  return parser.result();
+}
+
+const std::vector<AcquisitionData::Acquisition>&
+AcquisitionData::acquisitions() const {
+  return this->acquisition_list;
+}
+
+const std::string& AcquisitionData::timestamp() const {
+  return this->acquisition_timestamp;
+}
+
+std::size_t AcquisitionData::distinct_x_axes() const {
+  return this->x_axes_count;
+}
+
+std::span<const double> AcquisitionData::RegionOfInterest::x_data() const {
+  if (!this->x_axis) {
+    return {};
+  }
+  return *this->x_axis;
+}
+
+std::size_t AcquisitionData::RegionOfInterest::rows() const {
+  return this->row_count;
+}
+
+std::span<const double> AcquisitionData::RegionOfInterest::row(
+    std::size_t row) const {
+  if (row >= this->row_count) {
+    throw std::out_of_range("row " + std::to_string(row) +
+                            " does not exist in region of interest " +
+                            std::to_string(this->index));
+  }
+  return this->samples().subspan(row * this->row_length, this->row_length);
+}
+
+std::span<const double> AcquisitionData::RegionOfInterest::samples() const {
+  if (!this->all_samples) {
+    return {};
+  }
+  return std::span<const double>{*this->all_samples}.subspan(
+      this->samples_offset, this->row_count * this->row_length);
+}
+
+} /* namespace horiba::devices::single_devices */
@@ -0,0 +1,201 @@
+#include "horiba_cpp_sdk/devices/single_devices/acquisition_pipeline.h"
+
+#include <spdlog/spdlog.h>
+
+#include <chrono>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+namespace horiba::devices::single_devices {
+
+AcquisitionPipeline::AcquisitionPipeline(
+    std::shared_ptr<ChargeCoupledDevice> ccd, Options options,
+    FrameHandler handler)
+    : ccd{std::move(ccd)}, options{options}, handler{std::move(handler)} {
+  if (!this->ccd) {
+    throw std::invalid_argument("ccd must not be null");
+  }
+  if (this->options.capacity == 0) {
+    throw std::invalid_argument("capacity must be at least 1");
+  }
+}
+
+AcquisitionPipeline::~AcquisitionPipeline() { this->stop(); }
+
+void AcquisitionPipeline::start() {
+  const std::lock_guard<std::mutex> lock(this->mutex);
+  if (this->started) {
+    throw std::runtime_error("acquisition pipeline already started");
+  }
+  this->started = true;
+  this->acquisition_thread = std::thread([this]() { this->acquire(); });
+  this->decoding_thread = std::thread([this]() { this->decode(); });
+}
+
+void AcquisitionPipeline::stop() {
+  {
+    const std::lock_guard<std::mutex> lock(this->mutex);
+    this->stopping = true;
+  }
+  this->changed.notify_all();
+  if (this->acquisition_thread.joinable()) {
+    this->acquisition_thread.join();
+  }
+  if (this->decoding_thread.joinable()) {
+    this->decoding_thread.join();
+  }
+}
+
+std::optional<AcquisitionPipeline::Frame> AcquisitionPipeline::wait_and_pop(
+    std::chrono::milliseconds timeout) {
+  std::unique_lock<std::mutex> lock(this->mutex);
+  this->changed.wait_for(lock, timeout, [this]() {
+    return !this->frames.empty() || this->decoding_done;
+  });
+  return this->pop(lock);
+}
+
+std::optional<AcquisitionPipeline::Frame> AcquisitionPipeline::try_pop() {
+  std::unique_lock<std::mutex> lock(this->mutex);
+  return this->pop(lock);
+}
+
+bool AcquisitionPipeline::finished() {
+  const std::lock_guard<std::mutex> lock(this->mutex);
+  return this->decoding_done && this->frames.empty();
+}
+
+std::size_t AcquisitionPipeline::acquired_frames() {
+  const std::lock_guard<std::mutex> lock(this->mutex);
+  return this->acquired;
+}
+
+void AcquisitionPipeline::acquire() {
+  try {
+    for (std::size_t sequence = 0;
+         this->options.frames == 0 || sequence < this->options.frames;
+         sequence++) {
+      {
+        const std::lock_guard<std::mutex> lock(this->mutex);
+        if (this->stopping) {
+          break;
+        }
+      }
+
+      FetchedFrame frame;
+      frame.sequence = sequence;
+      frame.started = std::chrono::steady_clock::now();
+      this->ccd->set_acquisition_start(this->options.open_shutter);
+      this->ccd->wait_until_acquisition_done(this->options.frame_timeout);
+      frame.acquired = std::chrono::steady_clock::now();
+      frame.response = this->ccd->fetch_acquisition_data();
+
+      // handing the frame over lets the next acquisition start while this
+      // one is decoded, a fetched frame is handed over even when stopping
+      std::unique_lock<std::mutex> lock(this->mutex);
+      this->changed.wait(lock, [this]() {
+        return this->decoding_done || !this->fetched.has_value();
+      });
+      if (this->decoding_done) {
+        break;
+      }
+      this->fetched = std::move(frame);
+      this->acquired++;
+      lock.unlock();
+      this->changed.notify_all();
+    }
+  } catch (...) {
+    spdlog::error("[AcquisitionPipeline] acquisition failed");
+    this->fail(std::current_exception());
+  }
+
+  {
+    const std::lock_guard<std::mutex> lock(this->mutex);
+    this->acquiring_done = true;
+  }
+  this->changed.notify_all();
+}
+
+void AcquisitionPipeline::decode() {
+  while (true) {
+    FetchedFrame fetched_frame;
+    {
+      std::unique_lock<std::mutex> lock(this->mutex);
+      // the frames fetched before stopping or failing are decoded too
+      this->changed.wait(lock, [this]() {
+        return this->acquiring_done || this->fetched.has_value();
+      });
+      if (!this->fetched.has_value()) {
+        break;
+      }
+      fetched_frame = std::move(*this->fetched);
+      this->fetched.reset();
+    }
+    this->changed.notify_all();
+
+    try {
+      Frame frame{fetched_frame.sequence,
+                  ChargeCoupledDevice::decode_acquisition_data(
+                      fetched_frame.response),
+                  fetched_frame.started, fetched_frame.acquired,
+                  std::chrono::steady_clock::now()};
+      if (this->handler) {
+        this->handler(std::move(frame));
+        continue;
+      }
+
+      // once stopping, nobody may pop the frames anymore and the capacity
+      // is exceeded rather than losing a fetched frame
+      std::unique_lock<std::mutex> lock(this->mutex);
+      this->changed.wait(lock, [this]() {
+        return this->stopping || this->frames.size() < this->options.capacity;
+      });
+      this->frames.push_back(std::move(frame));
+      lock.unlock();
+      this->changed.notify_all();
+    } catch (...) {
+      spdlog::error("[AcquisitionPipeline] decoding failed");
+      this->fail(std::current_exception());
+      break;
+    }
+  }
+
+  {
+    const std::lock_guard<std::mutex> lock(this->mutex);
+    this->decoding_done = true;
+  }
+  this->changed.notify_all();
+}
+
+void AcquisitionPipeline::fail(std::exception_ptr failure) {
+  {
+    const std::lock_guard<std::mutex> lock(this->mutex);
+    if (!this->error) {
+      this->error = std::move(failure);
+    }
+    this->stopping = true;
+  }
+  this->changed.notify_all();
+}
+
+std::optional<AcquisitionPipeline::Frame> AcquisitionPipeline::pop(
+    std::unique_lock<std::mutex>& lock) {
+  if (!this->frames.empty()) {
+    auto frame = std::move(this->frames.front());
+    this->frames.pop_front();
+    lock.unlock();
+    this->changed.notify_all();
+    return frame;
+  }
+  if (this->decoding_done && this->error) {
+    std::rethrow_exception(this->error);
+  }
+  return std::nullopt;
+}
+
+} /* namespace horiba::devices::single_devices */
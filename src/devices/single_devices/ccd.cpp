@@ -2,6 +2,11 @@
 #include <horiba_cpp_sdk/devices/single_devices/ccd.h>
 #include <spdlog/spdlog.h>
 
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <utility>
+
 namespace horiba::devices::single_devices {
 
 using namespace nlohmann;
@@ -14,9 +19,14 @@ void ChargeCoupledDevice::open() {
   Device::open();
   auto _ignored_response = Device::execute_command(
       communication::Command("ccd_open", {{"index", Device::device_id()}}));
+  this->known.forget();
+  this->keep_preloaded_capabilities();
+  auto _ignored_capabilities = this->capabilities();
 }
 
 void ChargeCoupledDevice::close() {
+  this->known.forget();
+  this->invalidate_capabilities();
   auto _ignored_response = Device::execute_command(
       communication::Command("ccd_close", {{"index", Device::device_id()}}));
 }
@@ -29,17 +39,62 @@ bool ChargeCoupledDevice::is_open() {
 }
 
 void ChargeCoupledDevice::restart() {
+  this->known.forget();
+  this->invalidate_capabilities();
   auto _ignored_response = Device::execute_command(
       communication::Command("ccd_restart", {{"index", Device::device_id()}}));
 }
 
 nlohmann::json ChargeCoupledDevice::get_configuration() {
-  auto response = Device::execute_command(communication::Command(
+  auto response = Device::execute_query(communication::Command(
       "ccd_getConfig", {{"index", Device::device_id()}}));
   auto results = response.json_results();
   return results["configuration"];
 }
 
+std::shared_ptr<const CcdCapabilities> ChargeCoupledDevice::capabilities() {
+  std::shared_ptr<const CcdCapabilities> fetched;
+  CapabilitiesListener listener;
+  {
+    const std::lock_guard<std::mutex> lock(this->capabilities_mutex);
+    if (this->cached_capabilities) {
+      return this->cached_capabilities;
+    }
+    spdlog::debug("[ChargeCoupledDevice] fetching the capabilities of CCD {}",
+                  Device::device_id());
+    fetched = std::make_shared<const CcdCapabilities>(
+        CcdCapabilities::parse(this->get_configuration()));
+    this->cached_capabilities = fetched;
+    listener = this->capabilities_listener;
+  }
+  if (listener) {
+    listener(fetched->configuration);
+  }
+  return fetched;
+}
+
+void ChargeCoupledDevice::preload_capabilities(
+    const nlohmann::json& configuration,
+    const std::string& listed_serial_number) {
+  auto capabilities = std::make_shared<const CcdCapabilities>(
+      CcdCapabilities::parse(configuration));
+  const std::lock_guard<std::mutex> lock(this->capabilities_mutex);
+  this->cached_capabilities = std::move(capabilities);
+  this->preloaded_serial_number = listed_serial_number;
+}
+
+void ChargeCoupledDevice::set_capabilities_listener(
+    CapabilitiesListener listener) {
+  const std::lock_guard<std::mutex> lock(this->capabilities_mutex);
+  this->capabilities_listener = std::move(listener);
+}
+
+std::shared_ptr<const CcdCapabilities>
+ChargeCoupledDevice::loaded_capabilities() {
+  const std::lock_guard<std::mutex> lock(this->capabilities_mutex);
+  return this->cached_capabilities;
+}
+
 int ChargeCoupledDevice::get_gain_token() {
   auto response = Device::execute_command(
       communication::Command("ccd_getGain", {{"index", Device::device_id()}}));
@@ -49,8 +104,10 @@ int ChargeCoupledDevice::get_gain_token() {
 }
 
 void ChargeCoupledDevice::set_gain(int gain_token) {
-  auto _ignored_response = Device::execute_command(communication::Command(
+  auto response = Device::execute_command(communication::Command(
       "ccd_setGain", {{"index", Device::device_id()}, {"token", gain_token}}));
+  this->known.remember(Device::executed(response), &Profile::gain,
+                       gain_token);
 }
 
 int ChargeCoupledDevice::get_speed_token() {
@@ -62,9 +119,11 @@ int ChargeCoupledDevice::get_speed_token() {
 }
 
 void ChargeCoupledDevice::set_speed(int speed_token) {
-  auto _ignored_response = Device::execute_command(communication::Command(
+  auto response = Device::execute_command(communication::Command(
       "ccd_setSpeed",
       {{"index", Device::device_id()}, {"token", speed_token}}));
+  this->known.remember(Device::executed(response), &Profile::speed,
+                       speed_token);
 }
 
 int ChargeCoupledDevice::get_parallel_speed_token() {
@@ -76,9 +135,11 @@ int ChargeCoupledDevice::get_parallel_speed_token() {
 }
 
 void ChargeCoupledDevice::set_parallel_speed(int parallel_speed_token) {
-  auto _ignored_response = Device::execute_command(communication::Command(
+  auto response = Device::execute_command(communication::Command(
       "ccd_setParallelSpeed",
       {{"index", Device::device_id()}, {"token", parallel_speed_token}}));
+  this->known.remember(Device::executed(response), &Profile::parallel_speed,
+                       parallel_speed_token);
 }
 
 std::vector<int> ChargeCoupledDevice::get_fit_parameters() {
@@ -100,19 +161,26 @@ ChargeCoupledDevice::get_timer_resolution() {
 
 void ChargeCoupledDevice::set_timer_resolution(
     ChargeCoupledDevice::TimerResolution timer_resolution) {
-  auto _ignored_response = Device::execute_command(communication::Command(
+  auto response = Device::execute_command(communication::Command(
       "ccd_setTimerResolution",
       {{"index", Device::device_id()}, {"resolutionToken", timer_resolution}
 
       }));
+  this->known.remember(Device::executed(response), &Profile::timer_resolution,
+                       timer_resolution);
 }
 
 void ChargeCoupledDevice::set_acquisition_format(
     int number_of_rois, AcquisitionFormat acquisition_format) {
-  auto _ignored_response = Device::execute_command(communication::Command(
+  auto response = Device::execute_command(communication::Command(
       "ccd_setAcqFormat", {{"index", Device::device_id()},
                            {"format", static_cast<int>(acquisition_format)},
                            {"numberOfRois", number_of_rois}}));
+  this->known.remember(Device::executed(response), &Profile::acquisition_format,
+                       AcquisitionFormatSettings{number_of_rois,
+                                                 acquisition_format});
+  // the regions of interest have to be defined again for the new format
+  this->known.forget(&Profile::regions_of_interest);
 }
 
 ChargeCoupledDevice::XAxisConversionType
@@ -128,10 +196,12 @@ ChargeCoupledDevice::get_x_axis_conversion_type() {
 
 void ChargeCoupledDevice::set_x_axis_conversion_type(
     ChargeCoupledDevice::XAxisConversionType conversion_type) {
-  auto _ignored_response = Device::execute_command(
+  auto response = Device::execute_command(
       communication::Command("ccd_setXAxisConversionType",
                              {{"index", Device::device_id()},
                               {"type", static_cast<int>(conversion_type)}}));
+  this->known.remember(Device::executed(response),
+                       &Profile::x_axis_conversion_type, conversion_type);
 }
 
 int ChargeCoupledDevice::get_acquisition_count() {
@@ -144,8 +214,10 @@ int ChargeCoupledDevice::get_acquisition_count() {
 }
 
 void ChargeCoupledDevice::set_acquisition_count(int count) {
-  auto _ignored_response = Device::execute_command(communication::Command(
+  auto response = Device::execute_command(communication::Command(
       "ccd_setAcqCount", {{"index", Device::device_id()}, {"count", count}}));
+  this->known.remember(Device::executed(response), &Profile::acquisition_count,
+                       count);
 }
 
 std::pair<int, ChargeCoupledDevice::CleanCountMode>
@@ -205,9 +277,11 @@ int ChargeCoupledDevice::get_exposure_time() {
 }
 
 void ChargeCoupledDevice::set_exposure_time(int exposure_time_ms) {
-  auto _ignored_response = Device::execute_command(communication::Command(
+  auto response = Device::execute_command(communication::Command(
       "ccd_setExposureTime",
       {{"index", Device::device_id()}, {"time", exposure_time_ms}}));
+  this->known.remember(Device::executed(response), &Profile::exposure_time,
+                       exposure_time_ms);
 }
 
 int ChargeCoupledDevice::get_em_gain() {
@@ -251,41 +325,17 @@ void ChargeCoupledDevice::set_trigger_input(bool enabled, int address,
     return;
   }
 
-  auto config = get_configuration();
-  auto it_triggers = config.find("triggers");
-  if (it_triggers == config.end()) {
-    throw std::runtime_error("Triggers not found in the configuration");
-  }
-
-  const auto& triggers = it_triggers;
-  auto found_triggers = std::find_if(triggers->begin(), triggers->end(),
-                                     [&address](const nlohmann::json& trigger) {
-                                       return trigger["token"] == address;
-                                     });
-
-  if (found_triggers == triggers->end()) {
+  const auto ccd_capabilities = this->capabilities();
+  const auto& triggers = ccd_capabilities->triggers;
+  if (!triggers.contains_address(address)) {
     throw std::runtime_error("Trigger address " + std::to_string(address) +
                              " not found in the configuration");
   }
-
-  auto found_events = std::find_if(
-      (*found_triggers)["events"].begin(), (*found_triggers)["events"].end(),
-      [&event](const nlohmann::json& trigger_event) {
-        return trigger_event["token"] == event;
-      });
-
-  if (found_events == (*found_triggers)["events"].end()) {
+  if (!triggers.contains_event(address, event)) {
     throw std::runtime_error("Trigger event " + std::to_string(event) +
                              " not found in the configuration");
   }
-
-  auto found_signal_types = std::find_if(
-      (*found_events)["types"].begin(), (*found_events)["types"].end(),
-      [&signal_type](const nlohmann::json& signal) {
-        return signal["token"] == signal_type;
-      });
-
-  if (found_signal_types == (*found_events)["types"].end()) {
+  if (!triggers.contains(address, event, signal_type)) {
     throw std::runtime_error("Trigger type " + std::to_string(signal_type) +
                              " not found in the configuration");
   }
@@ -325,41 +375,17 @@ void ChargeCoupledDevice::set_signal_output(bool enabled, int address,
     return;
   }
 
-  auto config = get_configuration();
-  auto it_signals = config.find("signals");
-  if (it_signals == config.end()) {
-    throw std::runtime_error("Signals not found in the configuration");
-  }
-
-  const auto& signals = it_signals;
-  auto found_triggers = std::find_if(signals->begin(), signals->end(),
-                                     [&address](const nlohmann::json& trigger) {
-                                       return trigger["token"] == address;
-                                     });
-
-  if (found_triggers == signals->end()) {
+  const auto ccd_capabilities = this->capabilities();
+  const auto& signals = ccd_capabilities->signals;
+  if (!signals.contains_address(address)) {
     throw std::runtime_error("Signal address " + std::to_string(address) +
                              " not found in the configuration");
   }
-
-  auto found_events = std::find_if(
-      (*found_triggers)["events"].begin(), (*found_triggers)["events"].end(),
-      [&event](const nlohmann::json& trigger_event) {
-        return trigger_event["token"] == event;
-      });
-
-  if (found_events == (*found_triggers)["events"].end()) {
+  if (!signals.contains_event(address, event)) {
     throw std::runtime_error("Signal event " + std::to_string(event) +
                              " not found in the configuration");
   }
-
-  auto found_signal_types = std::find_if(
-      (*found_events)["types"].begin(), (*found_events)["types"].end(),
-      [&signal_type](const nlohmann::json& signal) {
-        return signal["token"] == signal_type;
-      });
-
-  if (found_signal_types == (*found_events)["types"].end()) {
+  if (!signals.contains(address, event, signal_type)) {
     throw std::runtime_error("Signal type " + std::to_string(signal_type) +
                              " not found in the configuration");
   }
@@ -382,6 +408,7 @@ bool ChargeCoupledDevice::get_acquisition_ready() {
 }
 
 void ChargeCoupledDevice::set_acquisition_start(bool open_shutter) {
+  this->note_acquisition_travel();
   auto _ignored_response = Device::execute_command(communication::Command(
       "ccd_acquisitionStart",
       {{"index", Device::device_id()}, {"openShutter", open_shutter}}));
@@ -391,7 +418,7 @@ void ChargeCoupledDevice::set_region_of_interest(int roi_index, int x_origin,
                                                  int y_origin, int x_size,
                                                  int y_size, int x_bin,
                                                  int y_bin) {
-  auto _ignored_response = Device::execute_command(
+  auto response = Device::execute_command(
       communication::Command("ccd_setRoi", {{"index", Device::device_id()},
                                             {"roiIndex", roi_index},
                                             {"xOrigin", x_origin},
@@ -400,13 +427,28 @@ void ChargeCoupledDevice::set_region_of_interest(int roi_index, int x_origin,
                                             {"ySize", y_size},
                                             {"xBin", x_bin},
                                             {"yBin", y_bin}}));
+  this->known.remember(
+      Device::executed(response), &Profile::regions_of_interest, roi_index,
+      RegionOfInterestSettings{x_origin, y_origin, x_size, y_size, x_bin,
+                               y_bin});
 }
 
-std::any ChargeCoupledDevice::get_acquisition_data() {
-  auto response = Device::execute_command(communication::Command(
+AcquisitionData ChargeCoupledDevice::get_acquisition_data() {
+  return decode_acquisition_data(this->fetch_acquisition_data());
+}
+
+communication::Response ChargeCoupledDevice::fetch_acquisition_data() {
+  return Device::execute_command(communication::Command(
       "ccd_getAcquisitionData", {{"index", Device::device_id()}}));
-  auto json_results = response.json_results();
-  return json_results.at("acquisition");
+}
+
+AcquisitionData ChargeCoupledDevice::decode_acquisition_data(
+    const communication::Response& response) {
+  if (response.raw().empty()) {
+    const nlohmann::json json_response = {{"results", response.json_results()}};
+    return AcquisitionData::parse(json_response.dump());
+  }
+  return AcquisitionData::parse(response.raw());
 }
 
 bool ChargeCoupledDevice::get_acquisition_busy() {
@@ -418,9 +460,15 @@ bool ChargeCoupledDevice::get_acquisition_busy() {
   return ready;
 }
 
-void ChargeCoupledDevice::abort_acquisition() {
+std::chrono::microseconds ChargeCoupledDevice::abort_acquisition() {
+  const auto start = std::chrono::steady_clock::now();
   auto _ignored_response = Device::execute_command(communication::Command(
       "ccd_acquisitionAbort", {{"index", Device::device_id()}}));
+  const auto latency = std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - start);
+  spdlog::info("[ChargeCoupledDevice] acquisition aborted in {} us",
+               latency.count());
+  return latency;
 }
 
 void ChargeCoupledDevice::set_center_wavelength(int monochromator_id,
@@ -446,4 +494,229 @@ std::vector<double> ChargeCoupledDevice::range_mode_center_wavelenghts(
 
   return wavelengths;
 }
+
+boost::asio::awaitable<void> ChargeCoupledDevice::set_exposure_time_async(
+    int exposure_time_ms) {
+  const communication::Command command(
+      "ccd_setExposureTime",
+      {{"index", Device::device_id()}, {"time", exposure_time_ms}});
+  auto response = co_await Device::execute_command_async(command);
+  this->known.remember(Device::executed(response), &Profile::exposure_time,
+                       exposure_time_ms);
+}
+
+boost::asio::awaitable<void> ChargeCoupledDevice::set_center_wavelength_async(
+    int monochromator_id, double wavelength) {
+  const communication::Command command(
+      "ccd_setCenterWavelength",
+      {{"index", Device::device_id()},
+       {"monoIndex", monochromator_id},
+       {"wavelength", wavelength}});
+  co_await Device::execute_command_async(command);
+}
+
+boost::asio::awaitable<bool>
+ChargeCoupledDevice::get_acquisition_ready_async() {
+  const communication::Command command(
+      "ccd_getAcquisitionReady", {{"index", Device::device_id()}});
+  auto response = co_await Device::execute_command_async(command);
+  auto json_results = response.json_results();
+  co_return json_results.at("ready").get<bool>();
+}
+
+boost::asio::awaitable<void> ChargeCoupledDevice::set_acquisition_start_async(
+    bool open_shutter) {
+  this->note_acquisition_travel();
+  const communication::Command command(
+      "ccd_acquisitionStart",
+      {{"index", Device::device_id()}, {"openShutter", open_shutter}});
+  co_await Device::execute_command_async(command);
+}
+
+boost::asio::awaitable<bool> ChargeCoupledDevice::get_acquisition_busy_async() {
+  const communication::Command command(
+      "ccd_getAcquisitionBusy", {{"index", Device::device_id()}});
+  auto response = co_await Device::execute_command_async(command);
+  auto json_results = response.json_results();
+  co_return json_results.at("isBusy").get<bool>();
+}
+
+boost::asio::awaitable<AcquisitionData>
+ChargeCoupledDevice::get_acquisition_data_async() {
+  const communication::Command command(
+      "ccd_getAcquisitionData", {{"index", Device::device_id()}});
+  auto response = co_await Device::execute_command_async(command);
+  co_return decode_acquisition_data(response);
+}
+
+boost::asio::awaitable<std::chrono::microseconds>
+ChargeCoupledDevice::abort_acquisition_async() {
+  const communication::Command command(
+      "ccd_acquisitionAbort", {{"index", Device::device_id()}});
+  const auto start = std::chrono::steady_clock::now();
+  co_await Device::execute_command_async(command);
+  const auto latency = std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - start);
+  spdlog::info("[ChargeCoupledDevice] acquisition aborted in {} us",
+               latency.count());
+  co_return latency;
+}
+
+boost::asio::awaitable<void>
+ChargeCoupledDevice::wait_until_acquisition_done_async(
+    std::chrono::milliseconds timeout,
+    std::optional<std::chrono::milliseconds> poll_interval) {
+  auto busy = [this]() { return this->get_acquisition_busy_async(); };
+  const std::shared_ptr<WaitStrategy> strategy =
+      poll_interval ? std::make_shared<FixedIntervalWait>(*poll_interval)
+                    : Device::wait_strategy();
+  const auto waited = co_await wait_until_idle_async(
+      strategy, busy, timeout, this->take_pending_travel(),
+      "timeout reached while waiting for the acquisition to be done");
+  spdlog::debug("[ChargeCoupledDevice] acquisition done after {} us",
+                waited.count());
+}
+
+void ChargeCoupledDevice::wait_until_acquisition_done(
+    std::chrono::milliseconds timeout) {
+  const auto waited = wait_until_idle(
+      Device::wait_strategy(),
+      [this]() { return this->get_acquisition_busy(); }, timeout,
+      this->take_pending_travel(),
+      "timeout reached while waiting for the acquisition to be done");
+  spdlog::debug("[ChargeCoupledDevice] acquisition done after {} us",
+                waited.count());
+}
+
+ChargeCoupledDevice::Profile ChargeCoupledDevice::known_settings() {
+  return this->known.get();
+}
+
+void ChargeCoupledDevice::forget_known_settings() { this->known.forget(); }
+
+std::size_t ChargeCoupledDevice::apply(const Profile& profile) {
+  const auto known_settings = this->known_settings();
+  auto batch = this->batch();
+  const auto differs = [](const auto& wanted, const auto& current) {
+    return wanted.has_value() && wanted != current;
+  };
+
+  const bool format_changed =
+      differs(profile.acquisition_format, known_settings.acquisition_format);
+  if (format_changed) {
+    batch.add(&ChargeCoupledDevice::set_acquisition_format,
+              profile.acquisition_format->number_of_rois,
+              profile.acquisition_format->format);
+  }
+  for (const auto& [index, roi] : profile.regions_of_interest) {
+    const auto current = known_settings.regions_of_interest.find(index);
+    if (format_changed || current == known_settings.regions_of_interest.end() ||
+        current->second != roi) {
+      batch.add(&ChargeCoupledDevice::set_region_of_interest, index,
+                roi.x_origin, roi.y_origin, roi.x_size, roi.y_size,
+                roi.x_binning, roi.y_binning);
+    }
+  }
+  if (differs(profile.x_axis_conversion_type,
+              known_settings.x_axis_conversion_type)) {
+    batch.add(&ChargeCoupledDevice::set_x_axis_conversion_type,
+              profile.x_axis_conversion_type.value());
+  }
+  if (differs(profile.timer_resolution, known_settings.timer_resolution)) {
+    batch.add(&ChargeCoupledDevice::set_timer_resolution,
+              profile.timer_resolution.value());
+  }
+  if (differs(profile.gain, known_settings.gain)) {
+    batch.add(&ChargeCoupledDevice::set_gain, profile.gain.value());
+  }
+  if (differs(profile.speed, known_settings.speed)) {
+    batch.add(&ChargeCoupledDevice::set_speed, profile.speed.value());
+  }
+  if (differs(profile.parallel_speed, known_settings.parallel_speed)) {
+    batch.add(&ChargeCoupledDevice::set_parallel_speed,
+              profile.parallel_speed.value());
+  }
+  if (differs(profile.exposure_time, known_settings.exposure_time)) {
+    batch.add(&ChargeCoupledDevice::set_exposure_time,
+              profile.exposure_time.value());
+  }
+  if (differs(profile.acquisition_count, known_settings.acquisition_count)) {
+    batch.add(&ChargeCoupledDevice::set_acquisition_count,
+              profile.acquisition_count.value());
+  }
+
+  const auto commands = batch.size();
+  if (commands == 0) {
+    return 0;
+  }
+
+  // the settings of the batch are not known until the batch succeeded
+  const auto result = batch.execute();
+  result.throw_if_failed();
+  this->remember_profile(profile);
+  spdlog::debug("[ChargeCoupledDevice] profile applied with {} commands",
+                commands);
+  return commands;
+}
+
+void ChargeCoupledDevice::remember_profile(const Profile& profile) {
+  const auto remember = [this](const auto& value, auto setting) {
+    if (value.has_value()) {
+      this->known.remember(true, setting, value.value());
+    }
+  };
+  remember(profile.acquisition_format, &Profile::acquisition_format);
+  remember(profile.x_axis_conversion_type, &Profile::x_axis_conversion_type);
+  remember(profile.timer_resolution, &Profile::timer_resolution);
+  remember(profile.gain, &Profile::gain);
+  remember(profile.speed, &Profile::speed);
+  remember(profile.parallel_speed, &Profile::parallel_speed);
+  remember(profile.exposure_time, &Profile::exposure_time);
+  remember(profile.acquisition_count, &Profile::acquisition_count);
+  for (const auto& [index, roi] : profile.regions_of_interest) {
+    this->known.remember(true, &Profile::regions_of_interest, index, roi);
+  }
+}
+
+std::future<bool> ChargeCoupledDevice::request_busy() {
+  return Device::request_flag(
+      communication::Command("ccd_getAcquisitionBusy",
+                             {{"index", Device::device_id()}}),
+      "isBusy");
+}
+
+Travel ChargeCoupledDevice::take_pending_travel() {
+  const std::lock_guard<std::mutex> lock(this->pending_travel_mutex);
+  return std::exchange(this->pending_travel, std::nullopt).value_or(Travel{});
+}
+
+void ChargeCoupledDevice::note_acquisition_travel() {
+  const auto exposure_time = this->known.get().exposure_time;
+  const std::lock_guard<std::mutex> lock(this->pending_travel_mutex);
+  this->pending_travel = Travel{MoveKind::ACQUISITION, std::nullopt};
+  if (exposure_time) {
+    this->pending_travel->distance = static_cast<double>(*exposure_time);
+  }
+}
+
+void ChargeCoupledDevice::invalidate_capabilities() {
+  const std::lock_guard<std::mutex> lock(this->capabilities_mutex);
+  this->cached_capabilities.reset();
+  this->preloaded_serial_number.reset();
+}
+
+void ChargeCoupledDevice::keep_preloaded_capabilities() {
+  const std::lock_guard<std::mutex> lock(this->capabilities_mutex);
+  const auto serial_number =
+      std::exchange(this->preloaded_serial_number, std::nullopt);
+  if (!serial_number || !this->cached_capabilities ||
+      !this->cached_capabilities->belongs_to(*serial_number)) {
+    this->cached_capabilities.reset();
+    return;
+  }
+  spdlog::debug("[ChargeCoupledDevice] keeping the preloaded capabilities of "
+                "CCD {}",
+                Device::device_id());
+}
+
 } /* namespace horiba::devices::single_devices */
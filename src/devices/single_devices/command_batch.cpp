@@ -0,0 +1,127 @@
+#include "horiba_cpp_sdk/devices/single_devices/command_batch.h"
+
+#include <spdlog/spdlog.h>
+
+#include <chrono>
+#include <exception>
+#include <future>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "horiba_cpp_sdk/devices/single_devices/device.h"
+
+namespace horiba::devices::single_devices {
+
+namespace {
+// batch whose device queues its commands instead of sending them, set while
+// a setter is called by CommandBatch::add
+thread_local CommandBatch* recording_batch = nullptr;
+}  // namespace
+
+bool CommandOutcome::succeeded() const {
+  return !this->error && this->response.errors().empty();
+}
+
+bool BatchResult::succeeded() const {
+  for (const auto& outcome : this->outcomes) {
+    if (!outcome.succeeded()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void BatchResult::throw_if_failed() const {
+  std::string message;
+  for (const auto& outcome : this->outcomes) {
+    if (outcome.succeeded()) {
+      continue;
+    }
+
+    message += "\n" + outcome.command.name() + ":";
+    if (outcome.error) {
+      try {
+        std::rethrow_exception(outcome.error);
+      } catch (const std::exception& e) {
+        message += std::string{" "} + e.what();
+      }
+    }
+    for (const auto& error : outcome.response.errors()) {
+      message += " " + error;
+    }
+  }
+
+  if (!message.empty()) {
+    throw std::runtime_error("commands of the batch failed:" + message);
+  }
+}
+
+CommandBatch::Recording::Recording(CommandBatch* batch)
+    : previous{recording_batch} {
+  recording_batch = batch;
+}
+
+CommandBatch::Recording::~Recording() { recording_batch = this->previous; }
+
+CommandBatch::CommandBatch(
+    Device& device, std::shared_ptr<communication::Communicator> communicator)
+    : device{&device}, communicator{std::move(communicator)} {}
+
+CommandBatch& CommandBatch::add(communication::Command command) {
+  this->commands.push_back(std::move(command));
+  return *this;
+}
+
+std::size_t CommandBatch::size() const { return this->commands.size(); }
+
+BatchResult CommandBatch::execute() {
+  if (!this->communicator->is_open()) {
+    throw std::runtime_error("communicator is not open");
+  }
+
+  auto commands = std::move(this->commands);
+  this->commands.clear();
+  spdlog::debug("[CommandBatch] sending {} commands", commands.size());
+
+  const auto start = std::chrono::steady_clock::now();
+  std::vector<std::future<communication::Response>> pending_responses;
+  pending_responses.reserve(commands.size());
+  for (const auto& command : commands) {
+    pending_responses.push_back(this->communicator->request_async(command));
+  }
+
+  BatchResult result;
+  result.outcomes.reserve(commands.size());
+  for (std::size_t i = 0; i < commands.size(); i++) {
+    CommandOutcome outcome{std::move(commands[i]), {}, nullptr};
+    try {
+      outcome.response = pending_responses[i].get();
+    } catch (const std::exception& e) {
+      spdlog::error("[CommandBatch] {} failed: {}", outcome.command.name(),
+                    e.what());
+      outcome.error = std::current_exception();
+    }
+    for (const auto& error : outcome.response.errors()) {
+      spdlog::error(error);
+    }
+    result.outcomes.push_back(std::move(outcome));
+  }
+  result.duration = std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - start);
+
+  spdlog::debug("[CommandBatch] {} commands done in {} us",
+                result.outcomes.size(), result.duration.count());
+  return result;
+}
+
+CommandBatch* CommandBatch::recording_for(const Device& device) {
+  if (recording_batch != nullptr && recording_batch->device == &device) {
+    return recording_batch;
+  }
+  return nullptr;
+}
+
+} /* namespace horiba::devices::single_devices */
@@ -2,7 +2,13 @@
 #include <horiba_cpp_sdk/devices/single_devices/device.h>
 #include <spdlog/spdlog.h>
 
+#include <boost/asio/use_awaitable.hpp>
+#include <future>
+#include <memory>
+#include <mutex>
 #include <stdexcept>
+#include <string>
+#include <utility>
 
 namespace horiba::devices::single_devices {
 
@@ -13,13 +19,27 @@ Device::Device(int id,
 void Device::open() {
   if (!this->communicator->is_open()) {
     spdlog::debug("[Device] communicator is closed, opening it.");
-    this->communicator->open();
+    try {
+      this->communicator->open();
+    } catch (const std::runtime_error&) {
+      // the communicator is shared, another device may have opened it in the
+      // meantime
+      if (!this->communicator->is_open()) {
+        throw;
+      }
+    }
     spdlog::debug("[Device] done");
   }
 }
 
 communication::Response Device::execute_command(
     const communication::Command& command) {
+  if (auto* batch = CommandBatch::recording_for(*this)) {
+    // the command is sent later with the whole batch
+    batch->add(command);
+    return communication::Response(command.id(), command.name(), {}, {});
+  }
+
   if (!this->communicator->is_open()) {
     throw std::runtime_error("communicator is not open");
   }
@@ -32,8 +52,71 @@ communication::Response Device::execute_command(
   return response;
 }
 
+communication::Response Device::execute_query(
+    const communication::Command& command) {
+  const CommandBatch::Recording not_recorded{nullptr};
+  return this->execute_command(command);
+}
+
+boost::asio::awaitable<communication::Response> Device::execute_command_async(
+    communication::Command command) {
+  if (!this->communicator->is_open()) {
+    throw std::runtime_error("communicator is not open");
+  }
+
+  auto response = co_await this->communicator->async_request(
+      command, boost::asio::use_awaitable);
+
+  if (!response.errors().empty()) {
+    this->handle_errors(response.errors());
+  }
+  co_return response;
+}
+
 int Device::device_id() const { return this->id; }
 
+CommandBatch Device::batch() { return {*this, this->communicator}; }
+
+void Device::set_wait_strategy(std::shared_ptr<WaitStrategy> strategy) {
+  if (!strategy) {
+    throw std::invalid_argument("wait strategy must not be null");
+  }
+  const std::lock_guard<std::mutex> lock(this->wait_strategy_mutex);
+  this->strategy = std::move(strategy);
+}
+
+std::shared_ptr<WaitStrategy> Device::wait_strategy() const {
+  const std::lock_guard<std::mutex> lock(this->wait_strategy_mutex);
+  return this->strategy;
+}
+
+Travel Device::take_pending_travel() { return Travel{}; }
+
+bool Device::executed(const communication::Response& response) const {
+  return CommandBatch::recording_for(*this) == nullptr &&
+         response.errors().empty();
+}
+
+std::future<bool> Device::request_flag(const communication::Command& command,
+                                       std::string flag) {
+  if (!this->communicator->is_open()) {
+    throw std::runtime_error("communicator is not open");
+  }
+
+  // the response is parsed by the one getting the flag, not on the thread
+  // handling the communication
+  return std::async(
+      std::launch::deferred,
+      [this, pending = this->communicator->request_async(command),
+       flag = std::move(flag)]() mutable {
+        auto response = pending.get();
+        if (!response.errors().empty()) {
+          this->handle_errors(response.errors());
+        }
+        return response.json_results().at(flag).get<bool>();
+      });
+}
+
 void Device::handle_errors(const std::vector<std::string>& errors) {
   for (const auto& error : errors) {
     spdlog::error(error);
@@ -0,0 +1,197 @@
+#include "horiba_cpp_sdk/devices/single_devices/device_capabilities.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <nlohmann/json.hpp>
+#include <string>
+#include <vector>
+
+namespace horiba::devices::single_devices {
+
+namespace {
+std::uint64_t event_key(int address, int event) {
+  return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(address))
+          << 32U) |
+         static_cast<std::uint32_t>(event);
+}
+
+std::vector<CcdOption> parse_options(const nlohmann::json& configuration,
+                                     const char* key) {
+  std::vector<CcdOption> options;
+  const auto list = configuration.find(key);
+  if (list == configuration.end() || !list->is_array()) {
+    return options;
+  }
+  options.reserve(list->size());
+  for (const auto& option : *list) {
+    options.push_back(CcdOption{option.at("token").get<int>(),
+                                option.value("info", std::string{})});
+  }
+  return options;
+}
+
+// text of a value that is a string on some devices and a number on others
+std::string text_value(const nlohmann::json& configuration, const char* key) {
+  const auto value = configuration.find(key);
+  if (value == configuration.end() || value->is_null()) {
+    return {};
+  }
+  return value->is_string() ? value->get<std::string>() : value->dump();
+}
+
+// serial numbers without the padding some devices add
+bool same_serial_number(std::string configured, std::string listed) {
+  for (auto* text : {&configured, &listed}) {
+    const auto end = text->find_last_not_of(' ');
+    text->erase(end == std::string::npos ? 0 : end + 1);
+  }
+  return configured == listed;
+}
+
+bool has_option(const std::vector<CcdOption>& options, int token) {
+  return std::ranges::any_of(
+      options, [token](const auto& option) { return option.token == token; });
+}
+}  // namespace
+
+std::size_t SignalPathTable::PathHash::operator()(
+    const Path& path) const noexcept {
+  const std::hash<std::uint64_t> hash;
+  return hash(event_key(path.address, path.event)) ^
+         (hash(static_cast<std::uint64_t>(path.signal_type)) << 1U);
+}
+
+SignalPathTable SignalPathTable::parse(const nlohmann::json& paths) {
+  SignalPathTable table;
+  if (!paths.is_array()) {
+    return table;
+  }
+
+  for (const auto& address : paths) {
+    const auto address_token = address.at("token").get<int>();
+    table.addresses.insert(address_token);
+    const auto events = address.find("events");
+    if (events == address.end()) {
+      continue;
+    }
+    for (const auto& event : *events) {
+      const auto event_token = event.at("token").get<int>();
+      table.events.insert(event_key(address_token, event_token));
+      const auto types = event.find("types");
+      if (types == event.end()) {
+        continue;
+      }
+      for (const auto& type : *types) {
+        table.paths.insert(
+            Path{address_token, event_token, type.at("token").get<int>()});
+      }
+    }
+  }
+  return table;
+}
+
+bool SignalPathTable::contains_address(int address) const {
+  return this->addresses.contains(address);
+}
+
+bool SignalPathTable::contains_event(int address, int event) const {
+  return this->events.contains(event_key(address, event));
+}
+
+bool SignalPathTable::contains(int address, int event, int signal_type) const {
+  return this->paths.contains(Path{address, event, signal_type});
+}
+
+std::size_t SignalPathTable::size() const { return this->paths.size(); }
+
+CcdCapabilities CcdCapabilities::parse(const nlohmann::json& configuration) {
+  CcdCapabilities capabilities;
+  capabilities.chip_width = configuration.value("chipWidth", 0);
+  capabilities.chip_height = configuration.value("chipHeight", 0);
+  capabilities.chip_name = text_value(configuration, "chipName");
+  capabilities.device_type = text_value(configuration, "deviceType");
+  capabilities.serial_number = text_value(configuration, "serialNumber");
+  capabilities.gains = parse_options(configuration, "gains");
+  capabilities.speeds = parse_options(configuration, "speeds");
+  capabilities.fit_parameters =
+      configuration.value("fitParameters", std::vector<int>{});
+  if (const auto triggers = configuration.find("triggers");
+      triggers != configuration.end()) {
+    capabilities.triggers = SignalPathTable::parse(*triggers);
+  }
+  if (const auto signals = configuration.find("signals");
+      signals != configuration.end()) {
+    capabilities.signals = SignalPathTable::parse(*signals);
+  }
+  capabilities.configuration = configuration;
+  return capabilities;
+}
+
+bool CcdCapabilities::has_gain(int token) const {
+  return has_option(this->gains, token);
+}
+
+bool CcdCapabilities::has_speed(int token) const {
+  return has_option(this->speeds, token);
+}
+
+bool CcdCapabilities::belongs_to(
+    const std::string& listed_serial_number) const {
+  return same_serial_number(this->serial_number, listed_serial_number);
+}
+
+MonochromatorCapabilities MonochromatorCapabilities::parse(
+    const nlohmann::json& configuration) {
+  MonochromatorCapabilities capabilities;
+  capabilities.model = text_value(configuration, "monoModel");
+  capabilities.serial_number = text_value(configuration, "serialNumber");
+  // the ICL misspells the key
+  capabilities.product_id = configuration.contains("productId")
+                                ? text_value(configuration, "productId")
+                                : text_value(configuration, "procuctId");
+
+  if (const auto gratings = configuration.find("gratings");
+      gratings != configuration.end()) {
+    for (const auto& grating : *gratings) {
+      capabilities.gratings.push_back(MonochromatorGrating{
+          grating.value("positionIndex", 0),
+          grating.value("grooveDensity", 0.0), grating.value("blaze", 0.0)});
+    }
+  }
+  if (const auto mirrors = configuration.find("mirrors");
+      mirrors != configuration.end()) {
+    for (const auto& mirror : *mirrors) {
+      capabilities.mirror_locations.push_back(mirror.value("location", 0));
+    }
+  }
+  if (const auto ports = configuration.find("ports");
+      ports != configuration.end()) {
+    for (const auto& port : *ports) {
+      capabilities.ports.push_back(MonochromatorPort{
+          port.value("monoPortLocation", 0), port.value("slitType", 0)});
+    }
+  }
+  if (const auto filter_wheels = configuration.find("filterWheels");
+      filter_wheels != configuration.end() && filter_wheels->is_array()) {
+    capabilities.filter_wheels = filter_wheels->size();
+  }
+  capabilities.configuration = configuration;
+  return capabilities;
+}
+
+bool MonochromatorCapabilities::has_grating(int position_index) const {
+  return std::ranges::any_of(
+      this->gratings, [position_index](const auto& grating) {
+        return grating.position_index == position_index;
+      });
+}
+
+bool MonochromatorCapabilities::belongs_to(
+    const std::string& listed_serial_number) const {
+  return this->serial_number.empty() ||
+         same_serial_number(this->serial_number, listed_serial_number);
+}
+
+} /* namespace horiba::devices::single_devices */
@@ -0,0 +1,134 @@
+#include "horiba_cpp_sdk/devices/single_devices/live_view.h"
+
+#include <spdlog/spdlog.h>
+
+#include <chrono>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+namespace horiba::devices::single_devices {
+
+LiveView::LiveView(std::shared_ptr<ChargeCoupledDevice> ccd, Options options)
+    : ccd{std::move(ccd)}, options{options} {
+  if (!this->ccd) {
+    throw std::invalid_argument("ccd must not be null");
+  }
+}
+
+LiveView::~LiveView() { this->stop(); }
+
+void LiveView::start() {
+  if (this->started.exchange(true)) {
+    throw std::runtime_error("live view already started");
+  }
+  this->acquisition_thread = std::thread([this]() { this->acquire(); });
+}
+
+void LiveView::stop() {
+  this->stopping = true;
+  if (this->acquisition_thread.joinable()) {
+    this->acquisition_thread.join();
+  }
+}
+
+std::optional<LiveView::Frame> LiveView::latest() {
+  auto frame = this->take();
+  if (!frame) {
+    this->rethrow_error();
+  }
+  return frame;
+}
+
+std::optional<LiveView::Frame> LiveView::wait_for_frame(
+    std::chrono::milliseconds timeout) {
+  {
+    std::unique_lock<std::mutex> lock(this->mutex);
+    this->frame_published.wait_for(lock, timeout, [this]() {
+      return this->buffer.fresh() || this->finished;
+    });
+  }
+  return this->latest();
+}
+
+LiveView::Statistics LiveView::statistics() const {
+  Statistics statistics;
+  statistics.acquired_frames = this->acquired.load();
+  statistics.taken_frames = this->taken.load();
+  statistics.dropped_frames = this->dropped.load();
+  const auto interval = this->frame_interval_us.load();
+  statistics.frames_per_second = interval > 0.0 ? 1e6 / interval : 0.0;
+  statistics.last_frame_age =
+      std::chrono::microseconds(this->last_frame_age_us.load());
+  return statistics;
+}
+
+void LiveView::acquire() {
+  std::optional<std::chrono::steady_clock::time_point> previous_frame;
+  try {
+    for (std::size_t sequence = 0; !this->stopping; sequence++) {
+      this->ccd->set_acquisition_start(this->options.open_shutter);
+      this->ccd->wait_until_acquisition_done(this->options.frame_timeout);
+      Frame frame{sequence, this->ccd->get_acquisition_data(),
+                  std::chrono::steady_clock::now()};
+
+      if (previous_frame) {
+        const auto interval =
+            std::chrono::duration<double, std::micro>(frame.acquired -
+                                                      *previous_frame)
+                .count();
+        const auto smoothed = this->frame_interval_us.load();
+        this->frame_interval_us =
+            smoothed == 0.0 ? interval
+                            : smoothed + RATE_SMOOTHING * (interval - smoothed);
+      }
+      previous_frame = frame.acquired;
+
+      if (this->buffer.publish(std::move(frame))) {
+        this->dropped++;
+      }
+      this->acquired++;
+      {
+        // taken so that a waiting consumer cannot miss the notification
+        const std::lock_guard<std::mutex> lock(this->mutex);
+      }
+      this->frame_published.notify_all();
+    }
+  } catch (...) {
+    spdlog::error("[LiveView] acquisition failed");
+    const std::lock_guard<std::mutex> lock(this->mutex);
+    this->error = std::current_exception();
+  }
+
+  {
+    const std::lock_guard<std::mutex> lock(this->mutex);
+    this->finished = true;
+  }
+  this->frame_published.notify_all();
+}
+
+std::optional<LiveView::Frame> LiveView::take() {
+  const std::lock_guard<std::mutex> lock(this->reader_mutex);
+  auto frame = this->buffer.take();
+  if (frame) {
+    this->taken++;
+    this->last_frame_age_us =
+        std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - frame->acquired)
+            .count();
+  }
+  return frame;
+}
+
+void LiveView::rethrow_error() {
+  const std::lock_guard<std::mutex> lock(this->mutex);
+  if (this->error) {
+    std::rethrow_exception(this->error);
+  }
+}
+
+} /* namespace horiba::devices::single_devices */
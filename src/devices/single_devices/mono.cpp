@@ -1,10 +1,50 @@
 #include <horiba_cpp_sdk/communication/command.h>
 #include <horiba_cpp_sdk/devices/single_devices/mono.h>
-
-#include <thread>
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <exception>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <type_traits>
+#include <utility>
 
 namespace horiba::devices::single_devices {
 using namespace nlohmann;
+
+namespace {
+template <typename Position>
+double position_value(Position position) {
+  if constexpr (std::is_enum_v<Position>) {
+    return static_cast<double>(position);
+  } else {
+    return position;
+  }
+}
+
+// distance between a known setting and its target, nothing if unknown
+template <typename Position>
+std::optional<double> distance_to(const std::optional<Position>& current,
+                                  Position target) {
+  if (!current) {
+    return std::nullopt;
+  }
+  return std::abs(position_value(target) - position_value(*current));
+}
+
+template <typename Location, typename Position>
+std::optional<double> distance_to(const std::map<Location, Position>& current,
+                                  Location location, Position target) {
+  const auto found = current.find(location);
+  if (found == current.end()) {
+    return std::nullopt;
+  }
+  return distance_to(std::optional<Position>(found->second), target);
+}
+}  // namespace
 Monochromator::Monochromator(
     int id, std::shared_ptr<communication::Communicator> communicator)
     : Device(id, std::move(communicator)) {}
@@ -13,9 +53,14 @@ void Monochromator::open() {
   Device::open();
   auto _ignored_response = Device::execute_command(
       communication::Command("mono_open", {{"index", Device::device_id()}}));
+  this->forget_known_settings();
+  this->keep_preloaded_capabilities();
+  auto _ignored_capabilities = this->capabilities();
 }
 
 void Monochromator::close() {
+  this->forget_known_settings();
+  this->invalidate_capabilities();
   auto _ignored_response = Device::execute_command(
       communication::Command("mono_close", {{"index", Device::device_id()}}));
 }
@@ -35,6 +80,8 @@ bool Monochromator::is_busy() {
 }
 
 void Monochromator::home(bool force_homing) {
+  this->note_travel(MoveKind::OTHER, std::nullopt);
+  this->forget_known_settings();
   auto _ignored_response = Device::execute_command(communication::Command(
       "mono_init", {{"index", Device::device_id()}, {"force", force_homing}}));
 }
@@ -47,10 +94,53 @@ bool Monochromator::initialized() {
 }
 
 nlohmann::json Monochromator::configuration() {
-  auto response = Device::execute_command(communication::Command(
-      "mono_getConfig", {{"index", Device::device_id()}}));
-  auto json_results = response.json_results();
-  return json_results["configuration"];
+  return this->capabilities()->configuration;
+}
+
+std::shared_ptr<const MonochromatorCapabilities>
+Monochromator::capabilities() {
+  std::shared_ptr<const MonochromatorCapabilities> fetched;
+  CapabilitiesListener listener;
+  {
+    const std::lock_guard<std::mutex> lock(this->capabilities_mutex);
+    if (this->cached_capabilities) {
+      return this->cached_capabilities;
+    }
+    spdlog::debug("[Monochromator] fetching the capabilities of mono {}",
+                  Device::device_id());
+    auto response = Device::execute_query(communication::Command(
+        "mono_getConfig", {{"index", Device::device_id()}}));
+    auto json_results = response.json_results();
+    fetched = std::make_shared<const MonochromatorCapabilities>(
+        MonochromatorCapabilities::parse(json_results["configuration"]));
+    this->cached_capabilities = fetched;
+    listener = this->capabilities_listener;
+  }
+  if (listener) {
+    listener(fetched->configuration);
+  }
+  return fetched;
+}
+
+void Monochromator::preload_capabilities(
+    const nlohmann::json& configuration,
+    const std::string& listed_serial_number) {
+  auto capabilities = std::make_shared<const MonochromatorCapabilities>(
+      MonochromatorCapabilities::parse(configuration));
+  const std::lock_guard<std::mutex> lock(this->capabilities_mutex);
+  this->cached_capabilities = std::move(capabilities);
+  this->preloaded_serial_number = listed_serial_number;
+}
+
+void Monochromator::set_capabilities_listener(CapabilitiesListener listener) {
+  const std::lock_guard<std::mutex> lock(this->capabilities_mutex);
+  this->capabilities_listener = std::move(listener);
+}
+
+std::shared_ptr<const MonochromatorCapabilities>
+Monochromator::loaded_capabilities() {
+  const std::lock_guard<std::mutex> lock(this->capabilities_mutex);
+  return this->cached_capabilities;
 }
 
 double Monochromator::get_current_wavelength() {
@@ -61,15 +151,21 @@ double Monochromator::get_current_wavelength() {
 }
 
 void Monochromator::calibrate_wavelength(double wavelength) {
-  auto _ignored_response = Device::execute_command(communication::Command(
+  auto response = Device::execute_command(communication::Command(
       "mono_setPosition",
       {{"index", Device::device_id()}, {"wavelength", wavelength}}));
+  this->known.remember(Device::executed(response), &Profile::wavelength,
+                       wavelength);
 }
 
 void Monochromator::move_to_target_wavelength(double wavelength) {
-  auto _ignored_response = Device::execute_command(communication::Command(
+  this->note_travel(MoveKind::WAVELENGTH,
+                    distance_to(this->known.get().wavelength, wavelength));
+  auto response = Device::execute_command(communication::Command(
       "mono_moveToPosition",
       {{"index", Device::device_id()}, {"wavelength", wavelength}}));
+  this->known.remember(Device::executed(response), &Profile::wavelength,
+                       wavelength);
 }
 
 Monochromator::Grating Monochromator::get_turret_grating() {
@@ -82,9 +178,15 @@ Monochromator::Grating Monochromator::get_turret_grating() {
 }
 
 void Monochromator::set_turret_grating(Grating grating) {
-  auto _ignored_response = Device::execute_command(communication::Command(
+  this->note_travel(MoveKind::GRATING,
+                    distance_to(this->known.get().turret_grating, grating));
+  auto response = Device::execute_command(communication::Command(
       "mono_moveGrating", {{"index", Device::device_id()},
                            {"position", static_cast<int>(grating)}}));
+  this->known.remember(Device::executed(response), &Profile::turret_grating,
+                       grating);
+  // the position is not kept when changing the grating
+  this->known.forget(&Profile::wavelength);
 }
 
 Monochromator::FilterWheelPosition Monochromator::get_filter_wheel_position(
@@ -101,10 +203,16 @@ Monochromator::FilterWheelPosition Monochromator::get_filter_wheel_position(
 
 void Monochromator::set_filter_wheel_position(FilterWheel filter_wheel,
                                               FilterWheelPosition position) {
-  auto _ignored_response = Device::execute_command(communication::Command(
+  this->note_travel(MoveKind::FILTER_WHEEL,
+                    distance_to(this->known.get().filter_wheel_positions,
+                                filter_wheel, position));
+  auto response = Device::execute_command(communication::Command(
       "mono_moveFilterWheel", {{"index", Device::device_id()},
                                {"locationId", static_cast<int>(filter_wheel)},
                                {"position", static_cast<int>(position)}}));
+  this->known.remember(Device::executed(response),
+                       &Profile::filter_wheel_positions, filter_wheel,
+                       position);
 }
 
 Monochromator::MirrorPosition Monochromator::get_mirror_position(
@@ -120,10 +228,15 @@ Monochromator::MirrorPosition Monochromator::get_mirror_position(
 
 void Monochromator::set_mirror_position(Mirror mirror,
                                         MirrorPosition position) {
-  auto _ignored_response = Device::execute_command(communication::Command(
+  this->note_travel(
+      MoveKind::MIRROR,
+      distance_to(this->known.get().mirror_positions, mirror, position));
+  auto response = Device::execute_command(communication::Command(
       "mono_moveMirror", {{"index", Device::device_id()},
                           {"locationId", static_cast<int>(mirror)},
                           {"position", static_cast<int>(position)}}));
+  this->known.remember(Device::executed(response), &Profile::mirror_positions,
+                       mirror, position);
 }
 
 double Monochromator::get_slit_position_in_mm(Slit slit) {
@@ -137,10 +250,15 @@ double Monochromator::get_slit_position_in_mm(Slit slit) {
 }
 
 void Monochromator::set_slit_position(Slit slit, double position_in_mm) {
-  auto _ignored_response = Device::execute_command(communication::Command(
+  this->note_travel(MoveKind::SLIT,
+                    distance_to(this->known.get().slit_positions_in_mm, slit,
+                                position_in_mm));
+  auto response = Device::execute_command(communication::Command(
       "mono_moveSlitMM", {{"index", Device::device_id()},
                           {"locationId", static_cast<int>(slit)},
                           {"position", position_in_mm}}));
+  this->known.remember(Device::executed(response),
+                       &Profile::slit_positions_in_mm, slit, position_in_mm);
 }
 
 int Monochromator::get_slit_step_position(Slit slit) {
@@ -154,10 +272,14 @@ int Monochromator::get_slit_step_position(Slit slit) {
 }
 
 void Monochromator::set_slit_step_position(Slit slit, int step_position) {
+  // the distance in mm of a move in steps is unknown
+  this->note_travel(MoveKind::SLIT, std::nullopt);
   auto _ignored_response = Device::execute_command(communication::Command(
       "mono_moveSlit", {{"index", Device::device_id()},
                         {"locationId", static_cast<int>(slit)},
                         {"position", step_position}}));
+  // the position in mm is not tracked for positions set in steps
+  this->known.forget(&Profile::slit_positions_in_mm, slit);
 }
 
 void Monochromator::open_shutter() {
@@ -186,18 +308,199 @@ Monochromator::ShutterPosition Monochromator::get_shutter_position(
 }
 
 void Monochromator::wait_until_ready(std::chrono::seconds timeout) {
-  std::this_thread::sleep_for(std::chrono::seconds(1));
-
-  int current_timeout_s = 0;
-  while (this->is_busy() && current_timeout_s < timeout.count()) {
-    std::this_thread::sleep_for(std::chrono::seconds(1));
-    current_timeout_s++;
+  std::chrono::microseconds waited{0};
+  try {
+    waited = wait_until_idle(
+        Device::wait_strategy(), [this]() { return this->is_busy(); },
+        timeout, this->take_pending_travel(),
+        "timeout reached while waiting for monochromator to be ready");
+  } catch (...) {
+    // the targets were remembered when the moves were ordered, they may not
+    // have been reached
+    this->known.forget();
+    throw;
   }
+  spdlog::debug("[Monochromator] ready after {} us", waited.count());
+}
 
-  if (this->is_busy()) {
-    throw std::runtime_error(
+boost::asio::awaitable<bool> Monochromator::is_busy_async() {
+  const communication::Command command(
+      "mono_isBusy", {{"index", Device::device_id()}});
+  auto response = co_await Device::execute_command_async(command);
+  auto json_results = response.json_results();
+  co_return json_results.at("busy").get<bool>();
+}
+
+boost::asio::awaitable<void> Monochromator::home_async(bool force_homing) {
+  this->note_travel(MoveKind::OTHER, std::nullopt);
+  this->forget_known_settings();
+  const communication::Command command(
+      "mono_init", {{"index", Device::device_id()}, {"force", force_homing}});
+  co_await Device::execute_command_async(command);
+}
+
+boost::asio::awaitable<double> Monochromator::get_current_wavelength_async() {
+  const communication::Command command(
+      "mono_getPosition", {{"index", Device::device_id()}});
+  auto response = co_await Device::execute_command_async(command);
+  auto json_results = response.json_results();
+  co_return json_results.at("wavelength").get<double>();
+}
+
+boost::asio::awaitable<void> Monochromator::move_to_target_wavelength_async(
+    double wavelength) {
+  this->note_travel(MoveKind::WAVELENGTH,
+                    distance_to(this->known.get().wavelength, wavelength));
+  const communication::Command command(
+      "mono_moveToPosition",
+      {{"index", Device::device_id()}, {"wavelength", wavelength}});
+  auto response = co_await Device::execute_command_async(command);
+  this->known.remember(Device::executed(response), &Profile::wavelength,
+                       wavelength);
+}
+
+boost::asio::awaitable<void> Monochromator::set_turret_grating_async(
+    Grating grating) {
+  this->note_travel(MoveKind::GRATING,
+                    distance_to(this->known.get().turret_grating, grating));
+  const communication::Command command(
+      "mono_moveGrating",
+      {{"index", Device::device_id()},
+       {"position", static_cast<int>(grating)}});
+  auto response = co_await Device::execute_command_async(command);
+  this->known.remember(Device::executed(response), &Profile::turret_grating,
+                       grating);
+  this->known.forget(&Profile::wavelength);
+}
+
+boost::asio::awaitable<void> Monochromator::wait_until_ready_async(
+    std::chrono::seconds timeout) {
+  auto busy = [this]() { return this->is_busy_async(); };
+  std::chrono::microseconds waited{0};
+  std::exception_ptr error;
+  try {
+    waited = co_await wait_until_idle_async(
+        Device::wait_strategy(), busy, timeout, this->take_pending_travel(),
         "timeout reached while waiting for monochromator to be ready");
+  } catch (...) {
+    error = std::current_exception();
+  }
+  if (error) {
+    this->known.forget();
+    std::rethrow_exception(error);
+  }
+  spdlog::debug("[Monochromator] ready after {} us", waited.count());
+}
+
+Monochromator::Profile Monochromator::known_settings() {
+  return this->known.get();
+}
+
+void Monochromator::forget_known_settings() { this->known.forget(); }
+
+std::size_t Monochromator::apply(const Profile& profile,
+                                 std::chrono::seconds timeout) {
+  std::size_t commands = 0;
+  const auto known_settings = this->known_settings();
+  const auto differs = [](const auto& wanted, const auto& current) {
+    return wanted.has_value() && wanted != current;
+  };
+  const auto move_changed = [&commands](const auto& wanted,
+                                        const auto& current, auto move) {
+    for (const auto& [location, position] : wanted) {
+      const auto found = current.find(location);
+      if (found == current.end() || found->second != position) {
+        move(location, position);
+        commands++;
+      }
+    }
+  };
+
+  if (differs(profile.turret_grating, known_settings.turret_grating)) {
+    this->set_turret_grating(profile.turret_grating.value());
+    commands++;
+    this->wait_until_ready(timeout);
+  }
+
+  // read again, as the wavelength is forgotten when the grating moves
+  if (differs(profile.wavelength, this->known_settings().wavelength)) {
+    this->move_to_target_wavelength(profile.wavelength.value());
+    commands++;
+    this->wait_until_ready(timeout);
+  }
+
+  const auto commands_before = commands;
+  move_changed(profile.mirror_positions, known_settings.mirror_positions,
+               [this](Mirror mirror, MirrorPosition position) {
+                 this->set_mirror_position(mirror, position);
+               });
+  move_changed(profile.slit_positions_in_mm,
+               known_settings.slit_positions_in_mm,
+               [this](Slit slit, double position) {
+                 this->set_slit_position(slit, position);
+               });
+  move_changed(profile.filter_wheel_positions,
+               known_settings.filter_wheel_positions,
+               [this](FilterWheel filter_wheel, FilterWheelPosition position) {
+                 this->set_filter_wheel_position(filter_wheel, position);
+               });
+  if (commands > commands_before) {
+    this->wait_until_ready(timeout);
+  }
+
+  spdlog::debug("[Monochromator] profile applied with {} commands", commands);
+  return commands;
+}
+
+std::future<bool> Monochromator::request_busy() {
+  return Device::request_flag(
+      communication::Command("mono_isBusy", {{"index", Device::device_id()}}),
+      "busy");
+}
+
+Travel Monochromator::take_pending_travel() {
+  const std::lock_guard<std::mutex> lock(this->pending_travel_mutex);
+  return std::exchange(this->pending_travel, std::nullopt).value_or(Travel{});
+}
+
+void Monochromator::note_travel(MoveKind kind,
+                                std::optional<double> distance) {
+  const std::lock_guard<std::mutex> lock(this->pending_travel_mutex);
+  if (!this->pending_travel) {
+    this->pending_travel = Travel{kind, distance};
+    return;
+  }
+  // moves of different kinds do not add up to a known distance
+  auto& pending = *this->pending_travel;
+  if (pending.kind != kind) {
+    pending = Travel{};
+    return;
+  }
+  // moves of the same kind run at the same time, e.g. several slits
+  if (pending.distance && distance) {
+    pending.distance = std::max(*pending.distance, *distance);
+  } else {
+    pending.distance = std::nullopt;
+  }
+}
+
+void Monochromator::invalidate_capabilities() {
+  const std::lock_guard<std::mutex> lock(this->capabilities_mutex);
+  this->cached_capabilities.reset();
+  this->preloaded_serial_number.reset();
+}
+
+void Monochromator::keep_preloaded_capabilities() {
+  const std::lock_guard<std::mutex> lock(this->capabilities_mutex);
+  const auto serial_number =
+      std::exchange(this->preloaded_serial_number, std::nullopt);
+  if (!serial_number || !this->cached_capabilities ||
+      !this->cached_capabilities->belongs_to(*serial_number)) {
+    this->cached_capabilities.reset();
+    return;
   }
+  spdlog::debug("[Monochromator] keeping the preloaded capabilities of mono {}",
+                Device::device_id());
 }
 
 } /* namespace horiba::devices::single_devices */
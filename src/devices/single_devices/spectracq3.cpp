@@ -4,6 +4,10 @@
 #include <horiba_cpp_sdk/devices/single_devices/spectracq3.h>
 #include <spdlog/spdlog.h>
 
+#include <array>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/asio/this_coro.hpp>
+#include <boost/asio/use_awaitable.hpp>
 #include <chrono>
 #include <memory>
 #include <nlohmann/json.hpp>
@@ -12,6 +16,75 @@ namespace horiba::devices::single_devices {
 
 using namespace nlohmann;
 
+namespace {
+communication::Command available_data_command(
+    int device_id,
+    const std::unordered_set<SpectrAcq3::Channel, SpectrAcq3::Channel::Hash>&
+        channels) {
+  if (channels.empty()) {
+    spdlog::error("At least one channel must be requested");
+    throw std::invalid_argument("At least one channel must be requested");
+  }
+  bool all_channel_exist = std::ranges::all_of(channels, [&](const auto& e) {
+    return SpectrAcq3::Channel::all_existing_channels.contains(e);
+  });
+  if (!all_channel_exist) {
+    spdlog::error("One or more requested channels do not exist:");
+    for (const auto& channel : channels) {
+      if (!SpectrAcq3::Channel::all_existing_channels.contains(channel)) {
+        spdlog::error(" - {} is inexistant", channel.json_name());
+      }
+    }
+    throw std::invalid_argument("One or more requested channels do not exist");
+  }
+
+  std::vector<std::string> channels_json_names;
+  channels_json_names.reserve(channels.size());
+
+  for (auto&& channel_json_name :
+       channels | std::views::transform([](const SpectrAcq3::Channel& c) {
+         return c.json_name();
+       })) {
+    channels_json_names.emplace_back(channel_json_name);
+  }
+
+  return communication::Command(
+      "saq3_getAvailableData",
+      {{"index", device_id}, {"channels", channels_json_names}});
+}
+
+communication::Command available_data_command(int device_id,
+                                              SpectrAcq3Channels channels) {
+  // ordered as the bits of SpectrAcq3Channels
+  static constexpr std::array<const char*, 4> channel_names{
+      "current", "voltage", "photon", "ppd"};
+
+  std::vector<std::string> channels_json_names;
+  for (std::size_t bit = 0; bit < channel_names.size(); bit++) {
+    if (has_channels(channels, static_cast<SpectrAcq3Channels>(1U << bit))) {
+      channels_json_names.emplace_back(channel_names[bit]);
+    }
+  }
+  if (channels_json_names.empty()) {
+    spdlog::error("At least one channel must be requested");
+    throw std::invalid_argument("At least one channel must be requested");
+  }
+
+  return communication::Command(
+      "saq3_getAvailableData",
+      {{"index", device_id}, {"channels", channels_json_names}});
+}
+
+SpectrAcq3Records decode_records(const communication::Response& response,
+                                 SpectrAcq3Channels channels) {
+  if (response.raw().empty()) {
+    const nlohmann::json json_response = {{"results", response.json_results()}};
+    return SpectrAcq3Records::parse(json_response.dump(), channels);
+  }
+  return SpectrAcq3Records::parse(response.raw(), channels);
+}
+}  // namespace
+
 const SpectrAcq3::Channel SpectrAcq3::Channel::Current{"current"};
 const SpectrAcq3::Channel SpectrAcq3::Channel::Voltage{"voltage"};
 const SpectrAcq3::Channel SpectrAcq3::Channel::Ppd{"ppd"};
@@ -47,6 +120,12 @@ bool SpectrAcq3::is_busy() {
   return response.json_results().at("isBusy").get<bool>();
 }
 
+std::future<bool> SpectrAcq3::request_busy() {
+  return Device::request_flag(
+      communication::Command("saq3_isBusy", {{"index", Device::device_id()}}),
+      "isBusy");
+}
+
 std::string SpectrAcq3::get_firmware_version() {
   auto response = Device::execute_command(communication::Command(
       "saq3_getFirmwareVersion", {{"index", Device::device_id()}}));
@@ -119,9 +198,14 @@ void SpectrAcq3::acquisition_start(SpectrAcq3::TriggerMode trigger) {
                                                {"trigger", trigger}}));
 }
 
-void SpectrAcq3::acquisition_stop() {
+std::chrono::microseconds SpectrAcq3::acquisition_stop() {
+  const auto start = std::chrono::steady_clock::now();
   [[maybe_unused]] auto ignored_response = Device::execute_command(
       communication::Command("saq3_acqStop", {{"index", Device::device_id()}}));
+  const auto latency = std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - start);
+  spdlog::info("[SpectrAcq3] acquisition stopped in {} us", latency.count());
+  return latency;
 }
 
 void SpectrAcq3::acquisition_pause() {
@@ -144,39 +228,19 @@ bool SpectrAcq3::is_data_available() {
 
 nlohmann::json SpectrAcq3::get_acquisition_data(
     std::unordered_set<Channel, Channel::Hash> channels) {
-  if (channels.empty()) {
-    spdlog::error("At least one channel must be requested");
-    throw std::invalid_argument("At least one channel must be requested");
-  }
-  bool all_channel_exist = std::ranges::all_of(channels, [&](const auto& e) {
-    return Channel::all_existing_channels.contains(e);
-  });
-  if (!all_channel_exist) {
-    spdlog::error("One or more requested channels do not exist:");
-    for (const auto& channel : channels) {
-      if (!Channel::all_existing_channels.contains(channel)) {
-        spdlog::error(" - {} is inexistant", channel.json_name());
-      }
-    }
-    throw std::invalid_argument("One or more requested channels do not exist");
-  }
-
-  std::vector<std::string> channels_json_names;
-  channels_json_names.reserve(channels.size());
-
-  for (auto&& channel_json_name :
-       channels | std::views::transform(
-                      [](const Channel& c) { return c.json_name(); })) {
-    channels_json_names.emplace_back(channel_json_name);
-  }
-
-  auto response = Device::execute_command(communication::Command(
-      "saq3_getAvailableData",
-      {{"index", Device::device_id()}, {"channels", channels_json_names}}));
+  auto response = Device::execute_command(
+      available_data_command(Device::device_id(), channels));
 
   return response.json_results()["data"];
 }
 
+SpectrAcq3Records SpectrAcq3::get_acquisition_records(
+    SpectrAcq3Channels channels) {
+  auto response = Device::execute_command(
+      available_data_command(Device::device_id(), channels));
+  return decode_records(response, channels);
+}
+
 void SpectrAcq3::force_trigger() {
   [[maybe_unused]] auto ignored_response =
       Device::execute_command(communication::Command(
@@ -193,10 +257,11 @@ std::pair<SpectrAcq3::TriggerMode, SpectrAcq3::HardwareTriggerPinMode>
 SpectrAcq3::get_in_trigger_mode() {
   auto response = Device::execute_command(communication::Command(
       "saq3_getInTriggerMode", {{"index", Device::device_id()}}));
+  const auto json_results = response.json_results();
   return {static_cast<SpectrAcq3::TriggerMode>(
-              response.json_results().at("inputTriggerMode").get<int>()),
+              json_results.at("inputTriggerMode").get<int>()),
           static_cast<SpectrAcq3::HardwareTriggerPinMode>(
-              response.json_results().at("scanStartMode").get<int>())};
+              json_results.at("scanStartMode").get<int>())};
 }
 
 void SpectrAcq3::set_trigger_in_polarity(
@@ -231,4 +296,86 @@ void SpectrAcq3::clear_error_log() {
       Device::execute_command(communication::Command(
           "saq3_clearErrorLog", {{"index", Device::device_id()}}));
 }
+
+boost::asio::awaitable<bool> SpectrAcq3::is_busy_async() {
+  const communication::Command command(
+      "saq3_isBusy", {{"index", Device::device_id()}});
+  auto response = co_await Device::execute_command_async(command);
+  co_return response.json_results().at("isBusy").get<bool>();
+}
+
+boost::asio::awaitable<void> SpectrAcq3::acquisition_start_async(
+    SpectrAcq3::TriggerMode trigger) {
+  const communication::Command command(
+      "saq3_acqStart", {{"index", Device::device_id()}, {"trigger", trigger}});
+  co_await Device::execute_command_async(command);
+}
+
+boost::asio::awaitable<std::chrono::microseconds>
+SpectrAcq3::acquisition_stop_async() {
+  const communication::Command command(
+      "saq3_acqStop", {{"index", Device::device_id()}});
+  const auto start = std::chrono::steady_clock::now();
+  co_await Device::execute_command_async(command);
+  const auto latency = std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - start);
+  spdlog::info("[SpectrAcq3] acquisition stopped in {} us", latency.count());
+  co_return latency;
+}
+
+boost::asio::awaitable<bool> SpectrAcq3::is_data_available_async() {
+  const communication::Command command(
+      "saq3_isDataAvailable", {{"index", Device::device_id()}});
+  auto response = co_await Device::execute_command_async(command);
+  co_return response.json_results().at("isDataAvailable").get<bool>();
+}
+
+boost::asio::awaitable<nlohmann::json> SpectrAcq3::get_acquisition_data_async(
+    std::unordered_set<Channel, Channel::Hash> channels) {
+  auto response = co_await Device::execute_command_async(
+      available_data_command(Device::device_id(), channels));
+
+  co_return response.json_results()["data"];
+}
+
+boost::asio::awaitable<SpectrAcq3Records>
+SpectrAcq3::get_acquisition_records_async(SpectrAcq3Channels channels) {
+  auto response = co_await Device::execute_command_async(
+      available_data_command(Device::device_id(), channels));
+
+  co_return decode_records(response, channels);
+}
+
+boost::asio::awaitable<void> SpectrAcq3::wait_until_ready_async(
+    std::chrono::milliseconds timeout,
+    std::chrono::milliseconds poll_interval) {
+  boost::asio::steady_timer timer{co_await boost::asio::this_coro::executor};
+  const auto deadline = std::chrono::steady_clock::now() + timeout;
+
+  while (co_await this->is_busy_async()) {
+    if (std::chrono::steady_clock::now() >= deadline) {
+      throw std::runtime_error(
+          "timeout reached while waiting for SpectrAcq3 to be ready");
+    }
+    timer.expires_after(poll_interval);
+    co_await timer.async_wait(boost::asio::use_awaitable);
+  }
+}
+
+boost::asio::awaitable<void> SpectrAcq3::wait_until_ready_async(
+    std::chrono::milliseconds timeout) {
+  auto busy = [this]() { return this->is_busy_async(); };
+  const auto waited = co_await wait_until_idle_async(
+      Device::wait_strategy(), busy, timeout, this->take_pending_travel(),
+      "timeout reached while waiting for SpectrAcq3 to be ready");
+  spdlog::debug("[SpectrAcq3] ready after {} us", waited.count());
+}
+
+void SpectrAcq3::wait_until_ready(std::chrono::milliseconds timeout) {
+  const auto waited = wait_until_idle(
+      Device::wait_strategy(), [this]() { return this->is_busy(); }, timeout,
+      this->take_pending_travel(),
+      "timeout reached while waiting for SpectrAcq3 to be ready");
+  spdlog::debug("[SpectrAcq3] ready after {} us", waited.count());
+}
 }  // namespace horiba::devices::single_devices
@@ -0,0 +1,404 @@
+#include "horiba_cpp_sdk/devices/single_devices/spectracq3_records.h"
+
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+#include <nlohmann/json.hpp>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace horiba::devices::single_devices {
+
+namespace {
+/**
+ * @brief Shared copy of a unit string. The set never shrinks and its nodes
+ * do not move, so the views stay valid.
+ */
+std::string_view intern_unit(const std::string& unit) {
+  static std::mutex mutex;
+  static std::unordered_set<std::string> units;
+  const std::lock_guard<std::mutex> lock(mutex);
+  return *units.insert(unit).first;
+}
+
+std::size_t column_of(SpectrAcq3Channels channel) {
+  return static_cast<std::size_t>(
+      std::countr_zero(static_cast<unsigned int>(channel)));
+}
+}  // namespace
+
+/**
+ * @brief SAX handler decoding a saq3_getAvailableData response into
+ * SpectrAcq3Records, without building JSON values.
+ */
+class SpectrAcq3RecordsParser {
+ public:
+  using json = nlohmann::json;
+
+  std::string error_message;
+
+  explicit SpectrAcq3RecordsParser(SpectrAcq3Channels channels) {
+    this->records.requested_channels = channels;
+  }
+
+  bool null() { return true; }
+
+  bool boolean(bool value) {
+    if (this->scope() != Scope::POINT) {
+      return true;
+    }
+    switch (this->current_key) {
+      case Key::EVENT_MARKER:
+        this->event_marker = value;
+        break;
+      case Key::OVERSCALE_CURRENT:
+        this->overscale_current = value;
+        break;
+      case Key::OVERSCALE_VOLTAGE:
+        this->overscale_voltage = value;
+        break;
+      default:
+        break;
+    }
+    return true;
+  }
+
+  bool number_integer(json::number_integer_t value) {
+    if (this->scope() == Scope::POINT &&
+        this->current_key == Key::POINT_NUMBER) {
+      this->point_number = value;
+      return true;
+    }
+    return this->number(static_cast<double>(value));
+  }
+
+  bool number_unsigned(json::number_unsigned_t value) {
+    if (this->scope() == Scope::POINT &&
+        this->current_key == Key::POINT_NUMBER) {
+      this->point_number = static_cast<std::int64_t>(value);
+      return true;
+    }
+    return this->number(static_cast<double>(value));
+  }
+
+  bool number_float(json::number_float_t value, const json::string_t& /*raw*/) {
+    if (this->scope() == Scope::POINT &&
+        this->current_key == Key::POINT_NUMBER) {
+      this->point_number = static_cast<std::int64_t>(value);
+      return true;
+    }
+    return this->number(value);
+  }
+
+  bool string(json::string_t& value) {
+    if (this->scope() == Scope::SIGNAL && this->current_key == Key::UNIT &&
+        this->signal_requested()) {
+      auto& unit = this->records.channel_units[column_of(this->signal)];
+      if (unit.empty()) {
+        unit = intern_unit(value);
+      }
+    }
+    return true;
+  }
+
+  bool binary(json::binary_t& /*value*/) { return true; }
+
+  bool start_object(std::size_t /*elements*/) {
+    if (this->scopes.empty()) {
+      this->scopes.push_back(Scope::TOP);
+      return true;
+    }
+
+    switch (this->scope()) {
+      case Scope::TOP:
+        this->scopes.push_back(this->current_key == Key::RESULTS
+                                   ? Scope::RESULTS
+                                   : Scope::IGNORED);
+        break;
+      case Scope::DATA:
+        this->start_point();
+        this->scopes.push_back(Scope::POINT);
+        break;
+      case Scope::POINT:
+        this->signal = signal_of(this->current_key);
+        this->scopes.push_back(this->signal == SpectrAcq3Channels::NONE
+                                   ? Scope::IGNORED
+                                   : Scope::SIGNAL);
+        break;
+      default:
+        this->scopes.push_back(Scope::IGNORED);
+        break;
+    }
+    return true;
+  }
+
+  bool key(json::string_t& key) {
+    this->current_key = key_of(key);
+    return true;
+  }
+
+  bool end_object() {
+    const auto ended = this->scope();
+    this->scopes.pop_back();
+    if (ended == Scope::POINT) {
+      return this->end_point();
+    }
+    return true;
+  }
+
+  bool start_array(std::size_t /*elements*/) {
+    this->scopes.push_back(this->scope() == Scope::RESULTS &&
+                                   this->current_key == Key::DATA
+                               ? Scope::DATA
+                               : Scope::IGNORED);
+    return true;
+  }
+
+  bool end_array() {
+    this->scopes.pop_back();
+    return true;
+  }
+
+  bool parse_error(std::size_t /*position*/, const std::string& /*last_token*/,
+                   const nlohmann::detail::exception& exception) {
+    this->error_message = exception.what();
+    return false;
+  }
+
+  SpectrAcq3Records result() { return std::move(this->records); }
+
+ private:
+  enum class Scope {
+    TOP,
+    RESULTS,
+    DATA,
+    POINT,
+    SIGNAL,
+    IGNORED,
+  };
+
+  enum class Key {
+    OTHER,
+    RESULTS,
+    DATA,
+    POINT_NUMBER,
+    ELAPSED_TIME,
+    EVENT_MARKER,
+    OVERSCALE_CURRENT,
+    OVERSCALE_VOLTAGE,
+    CURRENT_SIGNAL,
+    VOLTAGE_SIGNAL,
+    PMT_SIGNAL,
+    PPD_SIGNAL,
+    UNIT,
+    VALUE,
+  };
+
+  std::vector<Scope> scopes;
+  Key current_key{Key::OTHER};
+  SpectrAcq3Records records;
+
+  // the data point being decoded
+  std::optional<std::int64_t> point_number;
+  double elapsed_time{0.0};
+  std::array<std::optional<double>, SpectrAcq3Records::CHANNEL_COUNT> values;
+  bool event_marker{false};
+  bool overscale_current{false};
+  bool overscale_voltage{false};
+  SpectrAcq3Channels signal{SpectrAcq3Channels::NONE};
+
+  [[nodiscard]] Scope scope() const {
+    return this->scopes.empty() ? Scope::IGNORED : this->scopes.back();
+  }
+
+  static Key key_of(const std::string& key) {
+    if (key == "results") {
+      return Key::RESULTS;
+    }
+    if (key == "data") {
+      return Key::DATA;
+    }
+    if (key == "pointNumber") {
+      return Key::POINT_NUMBER;
+    }
+    if (key == "elapsedTime") {
+      return Key::ELAPSED_TIME;
+    }
+    // both spellings are sent by the ICL
+    if (key == "eventMarker" || key == "event_marker") {
+      return Key::EVENT_MARKER;
+    }
+    if (key == "overscaleCurrentChannel") {
+      return Key::OVERSCALE_CURRENT;
+    }
+    if (key == "overscaleVoltageChannel") {
+      return Key::OVERSCALE_VOLTAGE;
+    }
+    if (key == "currentSignal") {
+      return Key::CURRENT_SIGNAL;
+    }
+    if (key == "voltageSignal") {
+      return Key::VOLTAGE_SIGNAL;
+    }
+    if (key == "pmtSignal") {
+      return Key::PMT_SIGNAL;
+    }
+    if (key == "ppdSignal") {
+      return Key::PPD_SIGNAL;
+    }
+    if (key == "unit") {
+      return Key::UNIT;
+    }
+    if (key == "value") {
+      return Key::VALUE;
+    }
+    return Key::OTHER;
+  }
+
+  static SpectrAcq3Channels signal_of(Key key) {
+    switch (key) {
+      case Key::CURRENT_SIGNAL:
+        return SpectrAcq3Channels::CURRENT;
+      case Key::VOLTAGE_SIGNAL:
+        return SpectrAcq3Channels::VOLTAGE;
+      case Key::PMT_SIGNAL:
+        return SpectrAcq3Channels::PHOTON;
+      case Key::PPD_SIGNAL:
+        return SpectrAcq3Channels::PPD;
+      default:
+        return SpectrAcq3Channels::NONE;
+    }
+  }
+
+  [[nodiscard]] bool signal_requested() const {
+    return this->signal != SpectrAcq3Channels::NONE &&
+           has_channels(this->records.requested_channels, this->signal);
+  }
+
+  bool number(double value) {
+    if (this->scope() == Scope::POINT &&
+        this->current_key == Key::ELAPSED_TIME) {
+      this->elapsed_time = value;
+    } else if (this->scope() == Scope::SIGNAL &&
+               this->current_key == Key::VALUE && this->signal_requested()) {
+      this->values[column_of(this->signal)] = value;
+    }
+    return true;
+  }
+
+  void start_point() {
+    this->point_number.reset();
+    this->elapsed_time = 0.0;
+    this->values.fill(std::nullopt);
+    this->event_marker = false;
+    this->overscale_current = false;
+    this->overscale_voltage = false;
+  }
+
+  bool end_point() {
+    if (!this->point_number) {
+      this->error_message = "data point without pointNumber";
+      return false;
+    }
+
+    this->records.points.push_back(*this->point_number);
+    this->records.elapsed.push_back(this->elapsed_time);
+    for (std::size_t column = 0; column < SpectrAcq3Records::CHANNEL_COUNT;
+         column++) {
+      const auto channel = static_cast<SpectrAcq3Channels>(1U << column);
+      if (has_channels(this->records.requested_channels, channel)) {
+        this->records.channel_values[column].push_back(
+            this->values[column].value_or(
+                std::numeric_limits<double>::quiet_NaN()));
+      }
+    }
+    this->records.event_marker_flags.push_back(this->event_marker);
+    this->records.overscale_current_flags.push_back(this->overscale_current);
+    this->records.overscale_voltage_flags.push_back(this->overscale_voltage);
+    return true;
+  }
+};
+
+SpectrAcq3Records SpectrAcq3Records::parse(std::string_view raw_response,
+                                           SpectrAcq3Channels channels) {
+  SpectrAcq3RecordsParser parser(channels);
+  if (!nlohmann::json::sax_parse(raw_response, &parser)) {
+    throw std::invalid_argument("invalid spectracq3 data: " +
+                                parser.error_message);
+  }
+  return parser.result();
+}
+
+std::size_t SpectrAcq3Records::size() const { return this->points.size(); }
+
+bool SpectrAcq3Records::empty() const { return this->points.empty(); }
+
+SpectrAcq3Channels SpectrAcq3Records::channels() const {
+  return this->requested_channels;
+}
+
+std::span<const std::int64_t> SpectrAcq3Records::point_numbers() const {
+  return this->points;
+}
+
+std::span<const double> SpectrAcq3Records::elapsed_times() const {
+  return this->elapsed;
+}
+
+std::span<const double> SpectrAcq3Records::values(
+    SpectrAcq3Channels channel) const {
+  return this->channel_values[this->column(channel)];
+}
+
+std::string_view SpectrAcq3Records::unit(SpectrAcq3Channels channel) const {
+  return this->channel_units[this->column(channel)];
+}
+
+const std::vector<bool>& SpectrAcq3Records::event_markers() const {
+  return this->event_marker_flags;
+}
+
+const std::vector<bool>& SpectrAcq3Records::overscale_current() const {
+  return this->overscale_current_flags;
+}
+
+const std::vector<bool>& SpectrAcq3Records::overscale_voltage() const {
+  return this->overscale_voltage_flags;
+}
+
+SpectrAcq3Record SpectrAcq3Records::record(std::size_t index) const {
+  SpectrAcq3Record record;
+  record.point_number = this->points.at(index);
+  record.elapsed_time = this->elapsed[index];
+  const auto value = [this, index](SpectrAcq3Channels channel) {
+    return has_channels(this->requested_channels, channel)
+               ? std::optional<double>(
+                     this->channel_values[column_of(channel)][index])
+               : std::nullopt;
+  };
+  record.current = value(SpectrAcq3Channels::CURRENT);
+  record.voltage = value(SpectrAcq3Channels::VOLTAGE);
+  record.photon = value(SpectrAcq3Channels::PHOTON);
+  record.ppd = value(SpectrAcq3Channels::PPD);
+  record.event_marker = this->event_marker_flags[index];
+  record.overscale_current = this->overscale_current_flags[index];
+  record.overscale_voltage = this->overscale_voltage_flags[index];
+  return record;
+}
+
+std::size_t SpectrAcq3Records::column(SpectrAcq3Channels channel) const {
+  if (!std::has_single_bit(static_cast<unsigned int>(channel)) ||
+      !has_channels(this->requested_channels, channel)) {
+    throw std::invalid_argument("not one of the requested channels");
+  }
+  return column_of(channel);
+}
+
+} /* namespace horiba::devices::single_devices */
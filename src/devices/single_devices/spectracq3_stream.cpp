@@ -0,0 +1,152 @@
+#include "horiba_cpp_sdk/devices/single_devices/spectracq3_stream.h"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <chrono>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+namespace horiba::devices::single_devices {
+
+SpectrAcq3Stream::SpectrAcq3Stream(
+    std::shared_ptr<SpectrAcq3> spectracq3, Options options,
+    SpectrAcq3Channels channels)
+    : spectracq3{std::move(spectracq3)},
+      options{options},
+      channels{channels},
+      ring{options.capacity} {
+  if (!this->spectracq3) {
+    throw std::invalid_argument("spectracq3 must not be null");
+  }
+  if (this->channels == SpectrAcq3Channels::NONE) {
+    throw std::invalid_argument("at least one channel must be requested");
+  }
+  if (this->options.min_interval > this->options.max_interval) {
+    throw std::invalid_argument(
+        "min interval must not be greater than max interval");
+  }
+}
+
+SpectrAcq3Stream::~SpectrAcq3Stream() { this->stop(); }
+
+void SpectrAcq3Stream::start() {
+  if (this->started.exchange(true)) {
+    throw std::runtime_error("spectracq3 stream already started");
+  }
+  this->drain_thread = std::thread([this]() { this->drain(); });
+}
+
+void SpectrAcq3Stream::stop() {
+  {
+    const std::lock_guard<std::mutex> lock(this->mutex);
+    this->stopping = true;
+  }
+  this->stop_requested.notify_all();
+  if (this->drain_thread.joinable()) {
+    this->drain_thread.join();
+  }
+}
+
+std::optional<SpectrAcq3Record> SpectrAcq3Stream::try_pop() {
+  auto record = this->ring.try_pop();
+  if (!record && this->failed) {
+    const std::lock_guard<std::mutex> lock(this->mutex);
+    std::rethrow_exception(this->error);
+  }
+  return record;
+}
+
+SpectrAcq3Stream::Statistics SpectrAcq3Stream::statistics() const {
+  Statistics statistics;
+  statistics.fetches = this->fetches.load();
+  statistics.records = this->records.load();
+  statistics.overflowed_records = this->overflowed.load();
+  statistics.missing_points = this->missing_points.load();
+  statistics.gaps = this->gaps.load();
+  statistics.points_per_second = this->points_per_second.load();
+  statistics.fetch_interval = std::chrono::microseconds(this->interval_us);
+  return statistics;
+}
+
+void SpectrAcq3Stream::drain() {
+  try {
+    auto last_fetch = std::chrono::steady_clock::now();
+    while (true) {
+      const auto points = this->fetch();
+      const auto now = std::chrono::steady_clock::now();
+      const auto interval = this->next_interval(
+          points, std::chrono::duration_cast<std::chrono::microseconds>(
+                      now - last_fetch));
+      last_fetch = now;
+
+      std::unique_lock<std::mutex> lock(this->mutex);
+      if (this->stop_requested.wait_for(
+              lock, interval, [this]() { return this->stopping; })) {
+        break;
+      }
+    }
+    // the data acquired since the last fetch
+    this->fetch();
+  } catch (...) {
+    spdlog::error("[SpectrAcq3Stream] drain failed");
+    const std::lock_guard<std::mutex> lock(this->mutex);
+    this->error = std::current_exception();
+    this->failed = true;
+  }
+}
+
+std::size_t SpectrAcq3Stream::fetch() {
+  const auto data =
+      this->spectracq3->get_acquisition_records(this->channels);
+  this->fetches++;
+
+  for (std::size_t index = 0; index < data.size(); index++) {
+    auto record = data.record(index);
+    if (this->next_point && record.point_number > *this->next_point) {
+      spdlog::warn("[SpectrAcq3Stream] points {} to {} are missing",
+                   *this->next_point, record.point_number - 1);
+      this->missing_points +=
+          static_cast<std::size_t>(record.point_number - *this->next_point);
+      this->gaps++;
+    }
+    // a lower point number starts a new acquisition
+    this->next_point = record.point_number + 1;
+
+    this->records++;
+    if (!this->ring.try_push(std::move(record))) {
+      this->overflowed++;
+    }
+  }
+  return data.size();
+}
+
+std::chrono::microseconds SpectrAcq3Stream::next_interval(
+    std::size_t points, std::chrono::microseconds elapsed) {
+  if (elapsed.count() > 0) {
+    const auto rate = static_cast<double>(points) * 1e6 /
+                      static_cast<double>(elapsed.count());
+    const auto smoothed = this->points_per_second.load();
+    // decays towards 0 once the acquisition is over
+    this->points_per_second =
+        smoothed == 0.0 ? rate : smoothed + RATE_SMOOTHING * (rate - smoothed);
+  }
+
+  const auto rate = this->points_per_second.load();
+  std::chrono::microseconds interval = this->options.max_interval;
+  if (rate > 0.0) {
+    interval = std::chrono::microseconds(static_cast<long long>(
+        static_cast<double>(this->options.points_per_fetch) * 1e6 / rate));
+  }
+  interval = std::clamp<std::chrono::microseconds>(
+      interval, this->options.min_interval, this->options.max_interval);
+  this->interval_us = interval.count();
+  return interval;
+}
+
+} /* namespace horiba::devices::single_devices */
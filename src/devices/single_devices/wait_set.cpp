@@ -0,0 +1,121 @@
+#include "horiba_cpp_sdk/devices/single_devices/wait_set.h"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <future>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace horiba::devices::single_devices {
+
+WaitSet& WaitSet::add(std::shared_ptr<Device> device) {
+  if (!device) {
+    throw std::invalid_argument("device must not be null");
+  }
+  if (std::find(this->devices.begin(), this->devices.end(), device) ==
+      this->devices.end()) {
+    this->devices.push_back(std::move(device));
+  }
+  return *this;
+}
+
+std::size_t WaitSet::size() const { return this->devices.size(); }
+
+std::vector<std::shared_ptr<Device>> WaitSet::wait_any(
+    std::chrono::microseconds timeout) {
+  if (this->devices.empty()) {
+    throw std::runtime_error("no device to wait for");
+  }
+  return this->wait(timeout, false);
+}
+
+void WaitSet::wait_all(std::chrono::microseconds timeout) {
+  auto _ignored_ready = this->wait(timeout, true);
+}
+
+std::vector<std::shared_ptr<Device>> WaitSet::wait(
+    std::chrono::microseconds timeout, bool all) {
+  const auto started = std::chrono::steady_clock::now();
+  const auto deadline = started + timeout;
+
+  std::vector<Waiting> waiting;
+  waiting.reserve(this->devices.size());
+  for (const auto& device : this->devices) {
+    auto travel = device->take_pending_travel();
+    const auto unfinished_wait = std::ranges::find(
+        this->unfinished, device, [](const Waiting& entry) {
+          return entry.device;
+        });
+    // a device not moved since keeps waiting for its earlier move
+    if (unfinished_wait != this->unfinished.end() &&
+        travel.kind == MoveKind::OTHER && !travel.distance) {
+      unfinished_wait->resumed = true;
+      waiting.push_back(std::move(*unfinished_wait));
+      continue;
+    }
+    waiting.push_back(
+        {device, device->wait_strategy(), std::move(travel), started});
+  }
+  this->unfinished.clear();
+
+  std::vector<std::shared_ptr<Device>> ready;
+  std::vector<std::future<bool>> answers;
+  while (!waiting.empty()) {
+    // the device expected to be ready first sets the pace of the round
+    auto delay = std::chrono::microseconds::max();
+    for (auto& entry : waiting) {
+      delay = std::min(delay,
+                       entry.strategy->delay(entry.polls++, entry.travel));
+    }
+    std::this_thread::sleep_until(
+        std::min(std::chrono::steady_clock::now() + delay, deadline));
+
+    // all queries are in flight before the first answer is read
+    answers.clear();
+    for (const auto& entry : waiting) {
+      answers.push_back(entry.device->request_busy());
+    }
+
+    std::vector<Waiting> still_busy;
+    for (std::size_t i = 0; i < waiting.size(); i++) {
+      if (answers[i].get()) {
+        waiting[i].resumed = false;
+        still_busy.push_back(std::move(waiting[i]));
+        continue;
+      }
+      if (!waiting[i].resumed) {
+        const auto waited =
+            std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now() - waiting[i].started);
+        waiting[i].strategy->record(waiting[i].travel, waited);
+      }
+      ready.push_back(std::move(waiting[i].device));
+    }
+    waiting = std::move(still_busy);
+
+    if (!all && !ready.empty()) {
+      break;
+    }
+    if (!waiting.empty() && std::chrono::steady_clock::now() >= deadline) {
+      spdlog::error("[WaitSet] {} of {} devices still busy after {} us",
+                    waiting.size(), this->devices.size(), timeout.count());
+      this->unfinished = std::move(waiting);
+      throw std::runtime_error("timeout reached while waiting for devices");
+    }
+  }
+  this->unfinished = std::move(waiting);
+
+  spdlog::debug("[WaitSet] {} devices ready after {} us", ready.size(),
+                std::chrono::duration_cast<std::chrono::microseconds>(
+                    std::chrono::steady_clock::now() - started)
+                    .count());
+  return ready;
+}
+
+} /* namespace horiba::devices::single_devices */
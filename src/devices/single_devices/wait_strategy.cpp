@@ -0,0 +1,110 @@
+#include "horiba_cpp_sdk/devices/single_devices/wait_strategy.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <mutex>
+#include <optional>
+
+namespace horiba::devices::single_devices {
+
+FixedIntervalWait::FixedIntervalWait(std::chrono::microseconds interval)
+    : interval{interval} {}
+
+std::chrono::microseconds FixedIntervalWait::delay(
+    std::size_t /*poll*/, const Travel& /*travel*/) {
+  return this->interval;
+}
+
+ExponentialBackoffWait::ExponentialBackoffWait(
+    std::chrono::microseconds first_delay, double factor,
+    std::chrono::microseconds max_delay)
+    : first_delay{first_delay}, factor{factor}, max_delay{max_delay} {}
+
+std::chrono::microseconds ExponentialBackoffWait::delay(
+    std::size_t poll, const Travel& /*travel*/) {
+  const auto delay = static_cast<double>(this->first_delay.count()) *
+                     std::pow(this->factor, static_cast<double>(poll));
+  if (delay >= static_cast<double>(this->max_delay.count())) {
+    return this->max_delay;
+  }
+  return std::chrono::microseconds(static_cast<long long>(delay));
+}
+
+PredictiveWait::PredictiveWait(ExponentialBackoffWait backoff,
+                               std::size_t history)
+    : backoff{backoff}, history{std::max<std::size_t>(history, 1)} {}
+
+std::chrono::microseconds PredictiveWait::delay(std::size_t poll,
+                                                const Travel& travel) {
+  if (poll == 0) {
+    if (const auto prediction = this->predict(travel)) {
+      return std::max(this->backoff.delay(0, travel),
+                      std::chrono::microseconds(static_cast<long long>(
+                          static_cast<double>(prediction->count()) *
+                          PREDICTION_SHARE)));
+    }
+    return this->backoff.delay(0, travel);
+  }
+  // close to the predicted end, polled again soon
+  return this->backoff.delay(poll - 1, travel);
+}
+
+void PredictiveWait::record(const Travel& travel,
+                            std::chrono::microseconds duration) {
+  // a wait of unknown distance would bend the fit of its kind
+  if (!travel.distance) {
+    return;
+  }
+  const std::lock_guard<std::mutex> lock(this->mutex);
+  auto& samples = this->samples.at(static_cast<std::size_t>(travel.kind));
+  samples.push_back(Sample{std::abs(*travel.distance),
+                           static_cast<double>(duration.count())});
+  if (samples.size() > this->history) {
+    samples.pop_front();
+  }
+}
+
+std::optional<std::chrono::microseconds> PredictiveWait::predict(
+    const Travel& travel) const {
+  if (!travel.distance) {
+    return std::nullopt;
+  }
+  const auto distance = std::abs(*travel.distance);
+  const std::lock_guard<std::mutex> lock(this->mutex);
+  const auto& samples =
+      this->samples.at(static_cast<std::size_t>(travel.kind));
+  if (samples.empty()) {
+    return std::nullopt;
+  }
+
+  // least squares fit of duration = intercept + slope * travel
+  const auto count = static_cast<double>(samples.size());
+  double travel_sum = 0.0;
+  double duration_sum = 0.0;
+  for (const auto& sample : samples) {
+    travel_sum += sample.travel;
+    duration_sum += sample.duration_us;
+  }
+  const double travel_mean = travel_sum / count;
+  const double duration_mean = duration_sum / count;
+  double covariance = 0.0;
+  double variance = 0.0;
+  for (const auto& sample : samples) {
+    covariance +=
+        (sample.travel - travel_mean) * (sample.duration_us - duration_mean);
+    variance += (sample.travel - travel_mean) * (sample.travel - travel_mean);
+  }
+
+  double prediction = duration_mean;
+  // all waits had the same travel, or longer travels were faster
+  if (variance > 0.0 && covariance > 0.0) {
+    const double slope = covariance / variance;
+    prediction = duration_mean + slope * (distance - travel_mean);
+  }
+  return std::chrono::microseconds(
+      static_cast<long long>(std::max(prediction, 0.0)));
+}
+
+} /* namespace horiba::devices::single_devices */
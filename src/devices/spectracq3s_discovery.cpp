@@ -6,6 +6,7 @@
 #include <memory>
 #include <stdexcept>
 #include <string>
+#include <utility>
 
 namespace horiba::devices {
 
@@ -26,15 +27,19 @@ void SpectrAcq3sDiscovery::execute(bool error_on_no_devices) {
   const auto response = this->communicator->request_with_response(
       communication::Command("saq3_list", {}));
 
+  // the raw text is logged, nothing is formatted unless it is printed
   spdlog::debug("[SpectrAcq3sDiscovery] response: {}",
-                response.json_results().dump());
+                response.raw_results());
 
-  if (response.json_results().empty() && error_on_no_devices) {
+  auto raw_cdds = response.json_results();
+  if (raw_cdds.empty() && error_on_no_devices) {
     throw std::runtime_error("No SpectrAcq3s connected");
   }
 
-  auto raw_cdds = response.json_results();
-  this->saq3s = this->parse_saq3s(raw_cdds);
+  if (raw_cdds.contains("devices")) {
+    this->listed_devices = raw_cdds["devices"];
+  }
+  this->saq3s = this->parse_saq3s(std::move(raw_cdds));
 }
 
 std::vector<std::shared_ptr<single_devices::SpectrAcq3>>
@@ -42,6 +47,10 @@ SpectrAcq3sDiscovery::spectracq3s() const {
   return this->saq3s;
 }
 
+nlohmann::json SpectrAcq3sDiscovery::devices_list() const {
+  return this->listed_devices;
+}
+
 std::vector<std::shared_ptr<single_devices::SpectrAcq3>>
 SpectrAcq3sDiscovery::parse_saq3s(nlohmann::json raw_saq3s) {
   spdlog::info("[SpectrAcq3sDiscovery] detected #{} SpectrAcq3S",
@@ -0,0 +1,148 @@
+#include "horiba_cpp_sdk/devices/sweep_scan.h"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace horiba::devices {
+
+SweepScan::SweepScan(std::shared_ptr<single_devices::SpectrAcq3> saq3,
+                     std::shared_ptr<single_devices::Monochromator> mono,
+                     Options options)
+    : saq3{std::move(saq3)}, mono{std::move(mono)}, options{options} {
+  if (!this->saq3 || !this->mono) {
+    throw std::invalid_argument("saq3 and mono must not be null");
+  }
+  if (this->options.start_wavelength == this->options.end_wavelength) {
+    throw std::invalid_argument(
+        "start wavelength and end wavelength must differ");
+  }
+  if (this->options.scan_count <= 0 || this->options.time_step <= 0.0) {
+    throw std::invalid_argument("scan count and time step must be positive");
+  }
+  if (this->options.integration_time <= 0.0 ||
+      this->options.integration_time > this->options.time_step) {
+    throw std::invalid_argument(
+        "integration time must be positive and at most the time step");
+  }
+}
+
+SweepScan::Result SweepScan::run() {
+  const auto started = std::chrono::steady_clock::now();
+  this->mono->move_to_target_wavelength(this->options.start_wavelength);
+  this->mono->wait_until_ready(this->options.move_timeout);
+  this->saq3->wait_until_ready(this->options.move_timeout);
+  this->saq3->set_acquisition_set(
+      this->options.scan_count, this->options.time_step,
+      this->options.integration_time, this->options.external_param);
+
+  const auto sent = std::chrono::steady_clock::now();
+  this->saq3->acquisition_start(
+      single_devices::SpectrAcq3::TriggerMode::START_AND_INTERVAL);
+  const auto acknowledged = std::chrono::steady_clock::now();
+  // the acquisition started somewhere during the round trip
+  const auto acquisition_started = sent + (acknowledged - sent) / 2;
+
+  Result result;
+  try {
+    result.positions = this->sweep(acquisition_started);
+  } catch (...) {
+    spdlog::error("[SweepScan] sweep failed, stopping the acquisition");
+    try {
+      this->saq3->acquisition_stop();
+    } catch (const std::exception& e) {
+      spdlog::error("[SweepScan] stopping the acquisition failed: {}",
+                    e.what());
+    }
+    throw;
+  }
+
+  // the points after the end of the range would all be at its end
+  if (this->saq3->is_busy()) {
+    this->saq3->acquisition_stop();
+  }
+  result.records = this->saq3->get_acquisition_records(this->options.channels);
+  result.wavelengths =
+      wavelengths_at(result.positions, result.records.elapsed_times());
+  result.duration = std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - started);
+  spdlog::debug(
+      "[SweepScan] {} points over {} positions from {} nm to {} nm in {} us",
+      result.records.size(), result.positions.size(),
+      this->options.start_wavelength, this->options.end_wavelength,
+      result.duration.count());
+  return result;
+}
+
+std::vector<double> SweepScan::wavelengths_at(
+    const std::vector<PositionSample>& positions,
+    std::span<const double> elapsed_times) {
+  if (positions.empty()) {
+    throw std::invalid_argument("at least one position sample is required");
+  }
+
+  std::vector<double> wavelengths;
+  wavelengths.reserve(elapsed_times.size());
+  for (const auto elapsed_time : elapsed_times) {
+    const auto after = std::ranges::upper_bound(positions, elapsed_time, {},
+                                                &PositionSample::elapsed_time);
+    if (after == positions.begin()) {
+      wavelengths.push_back(positions.front().wavelength);
+      continue;
+    }
+    if (after == positions.end()) {
+      wavelengths.push_back(positions.back().wavelength);
+      continue;
+    }
+    const auto& before = *(after - 1);
+    const auto fraction = (elapsed_time - before.elapsed_time) /
+                          (after->elapsed_time - before.elapsed_time);
+    wavelengths.push_back(before.wavelength +
+                          fraction * (after->wavelength - before.wavelength));
+  }
+  return wavelengths;
+}
+
+std::vector<SweepScan::PositionSample> SweepScan::sweep(
+    std::chrono::steady_clock::time_point acquisition_started) {
+  const auto elapsed_ms = [acquisition_started](
+                              std::chrono::steady_clock::time_point time) {
+    return std::chrono::duration<double, std::milli>(time -
+                                                     acquisition_started)
+        .count();
+  };
+
+  // the monochromator rests at the start until it is told to move
+  std::vector<PositionSample> positions;
+  positions.push_back({elapsed_ms(std::chrono::steady_clock::now()),
+                       this->options.start_wavelength});
+  this->mono->move_to_target_wavelength(this->options.end_wavelength);
+  const auto deadline =
+      std::chrono::steady_clock::now() + this->options.move_timeout;
+
+  while (true) {
+    const auto busy = this->mono->is_busy();
+    const auto asked = std::chrono::steady_clock::now();
+    const auto wavelength = this->mono->get_current_wavelength();
+    const auto answered = std::chrono::steady_clock::now();
+    positions.push_back({elapsed_ms(asked + (answered - asked) / 2),
+                         wavelength});
+    if (!busy) {
+      return positions;
+    }
+    if (answered > deadline) {
+      throw std::runtime_error(
+          "timeout reached while sweeping the monochromator");
+    }
+    std::this_thread::sleep_for(this->options.position_interval);
+  }
+}
+
+} /* namespace horiba::devices */
@@ -98,20 +98,23 @@ auto main() -> int {
           this_thread::sleep_for(std::chrono::seconds(sleep_time));
           ;
           cout << "Trying for data...\n";
-          auto raw_data = any_cast<json>(ccd->get_acquisition_data());
+          auto acquisition_data = ccd->get_acquisition_data();
           break;
         } catch (const std::exception& e) {
           std::cout << "Caught exception: " << e.what() << "\n";
-          ccd->abort_acquisition();
+          const auto latency = ccd->abort_acquisition();
+          cout << "Acquisition aborted in " << latency.count() << " us\n";
           break;
         }
       }
 
       this_thread::sleep_for(std::chrono::seconds(sleep_time));
       ;
-      auto raw_data = any_cast<json>(ccd->get_acquisition_data());
-      vector<double> x_values = raw_data[0]["roi"][0]["xData"];
-      vector<int> y_values = raw_data[0]["roi"][0]["yData"][0];
+      const auto acquisition_data = ccd->get_acquisition_data();
+      const auto& roi =
+          acquisition_data.acquisitions()[0].regions_of_interest[0];
+      const auto x_values = roi.x_data();
+      const auto y_values = roi.row(0);
       cout << "Data during wait for trigger"
            << "\n";
       for (size_t i = 0; i < x_values.size(); i++) {
@@ -104,7 +104,7 @@ auto main() -> int {
 
     ccd->set_acquisition_count(1);
 
-    std::any data_return;
+    AcquisitionData data_return;
 
     if (ccd->get_acquisition_ready()) {
       const auto open_shutter = true;
@@ -123,10 +123,10 @@ auto main() -> int {
         }
       }
 
-      const json& raw_data = std::any_cast<const json&>(data_return);
+      const auto& roi = data_return.acquisitions()[0].regions_of_interest[0];
 
-      vector<double> x_values = raw_data[0]["roi"][0]["xData"];
-      vector<int> y_values = raw_data[0]["roi"][0]["yData"][0];
+      vector<double> x_values(roi.x_data().begin(), roi.x_data().end());
+      vector<double> y_values(roi.row(0).begin(), roi.row(0).end());
 
       plot(x_values, y_values);
       title("Center Scan At Wavelength " + to_string(target_wavelength) + "nm");
@@ -0,0 +1,147 @@
+#include <horiba_cpp_sdk/devices/icl_device_manager.h>
+#include <horiba_cpp_sdk/devices/single_devices/ccd.h>
+#include <horiba_cpp_sdk/devices/single_devices/mono.h>
+#include <horiba_cpp_sdk/os/process.h>
+#include <spdlog/spdlog.h>
+
+#include <boost/asio/awaitable.hpp>
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/io_context.hpp>
+#include <chrono>
+#include <exception>
+#include <memory>
+
+#ifdef _WIN32
+#include <horiba_cpp_sdk/os/windows_process.h>
+#endif
+
+namespace horiba::os {
+class FakeProcess : public Process {
+ public:
+  void start() override { this->is_running = true; }
+  bool running() override { return this->is_running; }
+  void stop() override { this->is_running = false; }
+
+ private:
+  bool is_running = false;
+};
+} /* namespace horiba::os */
+
+using horiba::devices::single_devices::AcquisitionData;
+using horiba::devices::single_devices::ChargeCoupledDevice;
+using horiba::devices::single_devices::Monochromator;
+
+boost::asio::awaitable<void> prepare_mono(std::shared_ptr<Monochromator> mono,
+                                          double wavelength) {
+  co_await mono->move_to_target_wavelength_async(wavelength);
+  co_await mono->wait_until_ready_async(std::chrono::seconds(30));
+  spdlog::info("Mono at {} nm", co_await mono->get_current_wavelength_async());
+}
+
+boost::asio::awaitable<void> prepare_ccd(
+    std::shared_ptr<ChargeCoupledDevice> ccd, int mono_id, double wavelength,
+    int exposure_time) {
+  co_await ccd->set_exposure_time_async(exposure_time);
+  co_await ccd->set_center_wavelength_async(mono_id, wavelength);
+  spdlog::info("CCD configured");
+}
+
+boost::asio::awaitable<void> acquire(std::shared_ptr<ChargeCoupledDevice> ccd,
+                                     int exposure_time) {
+  if (!co_await ccd->get_acquisition_ready_async()) {
+    spdlog::error("CCD is not ready to acquire");
+    co_return;
+  }
+
+  const auto open_shutter = true;
+  co_await ccd->set_acquisition_start_async(open_shutter);
+  co_await ccd->wait_until_acquisition_done_async(
+      std::chrono::milliseconds(exposure_time * 10));
+
+  const AcquisitionData data = co_await ccd->get_acquisition_data_async();
+  for (const auto& acquisition : data.acquisitions()) {
+    for (const auto& roi : acquisition.regions_of_interest) {
+      spdlog::info("Acquisition {} ROI {}: {} rows of {} samples",
+                   acquisition.index, roi.index, roi.rows(),
+                   roi.x_data().size());
+    }
+  }
+}
+
+auto main() -> int {
+  using namespace horiba::devices;
+  using namespace horiba::os;
+
+  spdlog::set_level(spdlog::level::debug);
+
+#ifdef _WIN32
+  auto icl_process = std::make_shared<WindowsProcess>(
+      R"(C:\Program Files\HORIBA Scientific\SDK\)", R"(icl.exe)");
+#else
+  auto icl_process = std::make_shared<FakeProcess>();
+#endif
+
+  auto icl_device_manager = ICLDeviceManager(icl_process);
+
+  icl_device_manager.start();
+  icl_device_manager.discover_devices();
+
+  const auto ccds = icl_device_manager.charge_coupled_devices();
+  const auto monos = icl_device_manager.monochromators();
+  if (ccds.empty() || monos.empty()) {
+    spdlog::error("No CCD or monochromator found.");
+    return 1;
+  }
+  const auto& ccd = ccds[0];
+  const auto& mono = monos[0];
+
+  // all the coroutines run on the thread calling run()
+  boost::asio::io_context context;
+  std::exception_ptr failure;
+  auto on_done = [&failure](std::exception_ptr error) {
+    if (error && !failure) {
+      failure = error;
+    }
+  };
+
+  try {
+    ccd->open();
+    mono->open();
+
+    constexpr double wavelength = 500.0;
+    constexpr int exposure_time = 1000;
+
+    // the mono moves while the CCD is being configured
+    boost::asio::co_spawn(context, prepare_mono(mono, wavelength), on_done);
+    boost::asio::co_spawn(
+        context,
+        prepare_ccd(ccd, mono->device_id(), wavelength, exposure_time),
+        on_done);
+    context.run();
+    if (failure) {
+      std::rethrow_exception(failure);
+    }
+
+    context.restart();
+    boost::asio::co_spawn(context, acquire(ccd, exposure_time), on_done);
+    context.run();
+    if (failure) {
+      std::rethrow_exception(failure);
+    }
+  } catch (const std::exception& e) {
+    spdlog::error("An error occurred: {}", e.what());
+    icl_device_manager.stop();
+    return 1;
+  }
+
+  try {
+    ccd->close();
+    mono->close();
+    icl_device_manager.stop();
+  } catch (const std::exception& e) {
+    // we expect an exception when the socket gets closed by the remote
+    spdlog::info("An error occurred while closing the device: {}", e.what());
+  }
+
+  return 0;
+}
@@ -12,7 +12,6 @@
 #include <chrono>
 #include <iostream>
 #include <nlohmann/json.hpp>
-#include <thread>
 
 #ifdef _WIN32
 #include <horiba_cpp_sdk/os/windows_process.h>
@@ -105,56 +104,34 @@ auto main() -> int {
     ccd->set_acquisition_count(1);
 
     std::vector<double> x_values;
-    std::vector<int> y_values_shutter_closed;
+    std::vector<double> y_values_shutter_closed;
 
-    std::any data_return;
+    AcquisitionData data_return;
 
     if (ccd->get_acquisition_ready()) {
       const auto close_shutter = false;
       ccd->set_acquisition_start(close_shutter);
-      // wait a short time for the acquisition to start
-      int sleep_time = (exposure_time / 1000) * 2;
-      while (true) {
-        try {
-          this_thread::sleep_for(std::chrono::seconds(sleep_time));
-          ;
-          cout << "Trying for data...\n";
-          data_return = ccd->get_acquisition_data();
-          break;
-        } catch (const std::exception& e) {
-          std::cout << "Data not ready yet...\n";
-        }
-      }
-
-      const json& raw_data = std::any_cast<const json&>(data_return);
-
-      x_values = raw_data[0]["roi"][0]["xData"].get<std::vector<double>>();
-      y_values_shutter_closed =
-          raw_data[0]["roi"][0]["yData"][0].get<std::vector<int>>();
+      ccd->wait_until_acquisition_done(
+          std::chrono::milliseconds(exposure_time + 10000));
+      data_return = ccd->get_acquisition_data();
+
+      const auto& roi = data_return.acquisitions()[0].regions_of_interest[0];
+
+      x_values.assign(roi.x_data().begin(), roi.x_data().end());
+      y_values_shutter_closed.assign(roi.row(0).begin(), roi.row(0).end());
     }
 
-    std::vector<int> y_values_shutter_open;
+    std::vector<double> y_values_shutter_open;
     if (ccd->get_acquisition_ready()) {
       const auto open_shutter = true;
       ccd->set_acquisition_start(open_shutter);
-      // wait a short time for the acquisition to start
-      int sleep_time = (exposure_time / 1000) * 2;
-      while (true) {
-        try {
-          this_thread::sleep_for(std::chrono::seconds(sleep_time));
-          ;
-          cout << "Trying for data...\n";
-          data_return = ccd->get_acquisition_data();
-          break;
-        } catch (const std::exception& e) {
-          std::cout << "Data not ready yet...\n";
-        }
-      }
-
-      const json& raw_data = std::any_cast<const json&>(data_return);
-
-      y_values_shutter_open =
-          raw_data[0]["roi"][0]["yData"][0].get<std::vector<int>>();
+      ccd->wait_until_acquisition_done(
+          std::chrono::milliseconds(exposure_time + 10000));
+      data_return = ccd->get_acquisition_data();
+
+      const auto& roi = data_return.acquisitions()[0].regions_of_interest[0];
+
+      y_values_shutter_open.assign(roi.row(0).begin(), roi.row(0).end());
     }
 
     if (y_values_shutter_closed.size() != y_values_shutter_open.size()) {
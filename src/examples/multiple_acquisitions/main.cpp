@@ -11,7 +11,6 @@
 #include <chrono>
 #include <iostream>
 #include <nlohmann/json.hpp>
-#include <thread>
 
 #ifdef _WIN32
 #include <horiba_cpp_sdk/os/windows_process.h>
@@ -68,44 +67,40 @@ auto main() -> int {
     int chip_x = config["chipWidth"];
     int chip_y = config["chipHeight"];
 
-    ccd->set_acquisition_format(
-        1, ChargeCoupledDevice::AcquisitionFormat::SPECTRA_IMAGE);
-
-    ccd->set_region_of_interest(1, 0, 0, chip_x, chip_y, 1, chip_y);
-
-    ccd->set_x_axis_conversion_type(
-        ChargeCoupledDevice::XAxisConversionType::NONE);
-
-    ccd->set_timer_resolution(
-        ChargeCoupledDevice::TimerResolution::THOUSAND_MICROSECONDS);
-
+    // the configuration is sent in one go instead of one command at a time
     constexpr int exposure_time = 1000;
-    ccd->set_exposure_time(exposure_time);
-
-    ccd->set_acquisition_count(5);
-
-    std::any data_return;
+    ccd->batch()
+        .add(&ChargeCoupledDevice::set_acquisition_format, 1,
+             ChargeCoupledDevice::AcquisitionFormat::SPECTRA_IMAGE)
+        .add(&ChargeCoupledDevice::set_region_of_interest, 1, 0, 0, chip_x,
+             chip_y, 1, chip_y)
+        .add(&ChargeCoupledDevice::set_x_axis_conversion_type,
+             ChargeCoupledDevice::XAxisConversionType::NONE)
+        .add(&ChargeCoupledDevice::set_timer_resolution,
+             ChargeCoupledDevice::TimerResolution::THOUSAND_MICROSECONDS)
+        .add(&ChargeCoupledDevice::set_exposure_time, exposure_time)
+        .add(&ChargeCoupledDevice::set_acquisition_count, 5)
+        .execute()
+        .throw_if_failed();
+
+    AcquisitionData data_return;
 
     if (ccd->get_acquisition_ready()) {
       const auto open_shutter = true;
       ccd->set_acquisition_start(open_shutter);
-      // wait a short time for the acquisition to start
-      int sleep_time = (exposure_time / 1000) * 2;
-      while (true) {
-        try {
-          this_thread::sleep_for(std::chrono::seconds(sleep_time));
-          ;
-          cout << "Trying for data...\n";
-          data_return = ccd->get_acquisition_data();
-          break;
-        } catch (const std::exception& e) {
-          std::cout << "Data not ready yet...\n";
+      ccd->wait_until_acquisition_done(
+          std::chrono::milliseconds(5 * exposure_time + 10000));
+      data_return = ccd->get_acquisition_data();
+
+      spdlog::info("Acquisition data size: {}",
+                   data_return.acquisitions().size());
+      for (const auto& acquisition : data_return.acquisitions()) {
+        for (const auto& roi : acquisition.regions_of_interest) {
+          spdlog::info("Acquisition {} ROI {}: {} rows of {} samples",
+                       acquisition.index, roi.index, roi.rows(),
+                       roi.x_data().size());
         }
       }
-
-      const json& raw_data = std::any_cast<const json&>(data_return);
-      spdlog::info("Acquisition data size: {}", raw_data.size());
-      spdlog::info("Acquisition data: {}", raw_data.dump());
     }
 
   } catch (const exception& e) {
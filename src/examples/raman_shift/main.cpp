@@ -15,7 +15,6 @@
 #include <nlohmann/json.hpp>
 #include <stdexcept>
 #include <string>
-#include <thread>
 
 #include "raman_shift.h"
 
@@ -144,29 +143,19 @@ auto main() -> int {
 
     ccd->set_acquisition_count(1);
 
-    std::any data_return;
+    AcquisitionData data_return;
 
     if (ccd->get_acquisition_ready()) {
       const auto open_shutter = true;
       ccd->set_acquisition_start(open_shutter);
-      // wait a short time for the acquisition to start
-      int sleep_time = (exposure_time / 1000) * 2;
-      while (true) {
-        try {
-          this_thread::sleep_for(std::chrono::seconds(sleep_time));
-          ;
-          cout << "Trying for data...\n";
-          data_return = ccd->get_acquisition_data();
-          break;
-        } catch (const std::exception& e) {
-          std::cout << "Data not ready yet...\n";
-        }
-      }
-
-      const json& raw_data = std::any_cast<const json&>(data_return);
-
-      vector<double> x_values = raw_data[0]["roi"][0]["xData"];
-      vector<int> y_values = raw_data[0]["roi"][0]["yData"][0];
+      ccd->wait_until_acquisition_done(
+          std::chrono::milliseconds(exposure_time + 10000));
+      data_return = ccd->get_acquisition_data();
+
+      const auto& roi = data_return.acquisitions()[0].regions_of_interest[0];
+
+      vector<double> x_values(roi.x_data().begin(), roi.x_data().end());
+      vector<double> y_values(roi.row(0).begin(), roi.row(0).end());
       const double excitation_wavelength = 532.0;
       auto raman_shift = RamanShift(x_values, excitation_wavelength);
       auto x_values_raman_shift = raman_shift.compute();
@@ -1,19 +1,16 @@
 // Note: on Windows if you use scaling, add the environment variable
 // GNUTERM="qt" to avoid strange rendering artifacts
 #include <horiba_cpp_sdk/communication/websocket_communicator.h>
-#include <horiba_cpp_sdk/core/stitching/simple_spectra_stitch.h>
 #include <horiba_cpp_sdk/devices/icl_device_manager.h>
+#include <horiba_cpp_sdk/devices/range_scan.h>
 #include <horiba_cpp_sdk/devices/single_devices/ccd.h>
 #include <horiba_cpp_sdk/devices/single_devices/mono.h>
 #include <horiba_cpp_sdk/os/process.h>
 #include <matplot/matplot.h>
 #include <spdlog/spdlog.h>
 
-#include <algorithm>
 #include <chrono>
 #include <nlohmann/json.hpp>
-#include <thread>
-#include <vector>
 
 #ifdef _WIN32
 #include <horiba_cpp_sdk/os/windows_process.h>
@@ -36,7 +33,6 @@ auto main() -> int {
   using namespace horiba::devices;
   using namespace horiba::os;
   using namespace horiba::devices::single_devices;
-  using namespace horiba::core::stitching;
   using namespace horiba::communication;
   using namespace matplot;
   using namespace std;
@@ -112,60 +108,32 @@ auto main() -> int {
     ccd->set_acquisition_count(1);
 
     if (ccd->get_acquisition_ready()) {
-      std::vector<std::vector<std::vector<double>>> spectra;
-
       const double start_wavelength = 400.0;
       const double end_wavelength = 600.0;
-      const int pixel_overlap = 10;
-
-      auto wavelengths = ccd->range_mode_center_wavelenghts(
-          mono->device_id(), start_wavelength, end_wavelength, pixel_overlap);
-
-      for (auto wavelength : wavelengths) {
-        mono->move_to_target_wavelength(wavelength);
-        mono->wait_until_ready(timeout);
-
-        ccd->set_center_wavelength(mono->device_id(), wavelength);
-
-        auto open_shutter = true;
-
-        std::any data_return;
-
-        ccd->set_acquisition_start(open_shutter);
-        int sleep_time = (exposure_time / 1000) * 2;
-        while (true) {
-          try {
-            this_thread::sleep_for(std::chrono::seconds(sleep_time));
-            ;
-            cout << "Trying for data...\n";
-            data_return = ccd->get_acquisition_data();
-            break;
-          } catch (const std::exception& e) {
-            std::cout << "Data not ready yet...\n";
-          }
-        }
-
-        const json& raw_data = std::any_cast<const json&>(data_return);
-
-        std::vector<double> x_data =
-            raw_data[0]["roi"][0]["xData"].get<std::vector<double>>();
-        std::ranges::reverse(x_data);
-        std::vector<double> y_data =
-            raw_data[0]["roi"][0]["yData"][0].get<std::vector<double>>();
-        std::ranges::reverse(y_data);
-        spectra.push_back({x_data, y_data});
-      }
 
-      std::ranges::sort(spectra, [](const auto& a, const auto& b) {
-        return a[0][0] < b[0][0];
-      });
-
-      // Here are some examples of how to stitch the spectra together.
-      // You can of course create your own stitching algorithm.
-      auto spectra_stitch = make_unique<SimpleSpectraStitch>(spectra);
-      auto stitched_spectra_data = spectra_stitch->stitched_spectra();
+      // the monochromator moves to the next segment while the data of the
+      // last one is transferred, decoding and stitching run in the background
+      RangeScan::Options options;
+      options.start_wavelength = start_wavelength;
+      options.end_wavelength = end_wavelength;
+      options.pixel_overlap = 10;
+      options.move_timeout = timeout;
+      options.acquisition_timeout =
+          std::chrono::milliseconds(exposure_time + 10000);
+      RangeScan scan(ccd, mono, options);
+      const auto result = scan.run();
+
+      for (const auto& timing : result.timings) {
+        spdlog::info(
+            "Segment at {}nm: move {} us, exposure {} us, transfer {} us, "
+            "decode {} us, stitch {} us",
+            timing.center_wavelength, timing.move.count(),
+            timing.exposure.count(), timing.transfer.count(),
+            timing.decode.count(), timing.stitch.count());
+      }
+      spdlog::info("Range scan took {} us", result.duration.count());
 
-      plot(stitched_spectra_data[0], stitched_spectra_data[1]);
+      plot(result.spectrum[0], result.spectrum[1]);
       title("Range Scan From " + to_string(start_wavelength) + "nm to " +
             to_string(end_wavelength) + "nm");
       xlabel("Wavelength [nm]");
@@ -6,16 +6,15 @@
 #include <horiba_cpp_sdk/devices/single_devices/ccd.h>
 #include <horiba_cpp_sdk/devices/single_devices/mono.h>
 #include <horiba_cpp_sdk/devices/single_devices/spectracq3.h>
+#include <horiba_cpp_sdk/devices/sweep_scan.h>
 #include <horiba_cpp_sdk/os/process.h>
 #include <matplot/matplot.h>
 #include <spdlog/spdlog.h>
 
-#include <chrono>
 #include <iostream>
 #include <memory>
 #include <nlohmann/json.hpp>
 #include <string>
-#include <thread>
 
 #ifdef _WIN32
 #include <horiba_cpp_sdk/os/windows_process.h>
@@ -61,7 +60,6 @@ auto main() -> int {
   using namespace horiba::communication;
   using namespace matplot;
   using namespace std;
-  using Channel = horiba::devices::single_devices::SpectrAcq3::Channel;
 
   spdlog::set_level(spdlog::level::debug);
 
@@ -102,70 +100,36 @@ auto main() -> int {
     auto firmware_version = spectracq3->get_firmware_version();
     spdlog::info("Firmware version: {}", firmware_version);
 
-    // do an acquisition
+    // sweep the monochromator through the range while the SpectrAcq3
+    // acquires, instead of stopping at each wavelength
     constexpr auto start_wavelength = 400;
     constexpr auto end_wavelength = 700;
-    constexpr auto increment_wavelength = 1;
-    std::vector<double> wavelengths;
 
-    for (double wavelength = start_wavelength;
-         wavelength <= end_wavelength + 1e-9;
-         wavelength += increment_wavelength) {
-      wavelengths.push_back(wavelength);
+    SweepScan::Options options;
+    options.start_wavelength = start_wavelength;
+    options.end_wavelength = end_wavelength;
+    options.scan_count = 10000;
+    options.time_step = 0.01;
+    options.integration_time = 0.01;
+    // include only the ones you need, e.g. | SpectrAcq3Channels::PPD
+    options.channels = SpectrAcq3Channels::VOLTAGE |
+                       SpectrAcq3Channels::CURRENT | SpectrAcq3Channels::PHOTON;
+
+    const auto result = SweepScan(spectracq3, mono, options).run();
+    spdlog::info("Acquired {} points in {} ms", result.records.size(),
+                 result.duration.count() / 1000);
+    if (result.records.empty()) {
+      spdlog::error("No data points acquired");
+      spectracq3->close();
+      mono->close();
+      icl_device_manager.stop();
+      return 1;
     }
 
-    constexpr auto scan_count = 1;
-    constexpr auto time_step = 0;
-    constexpr auto integration_time = 0.1;
-    constexpr auto external_param = 0;
-
-    std::vector<double> x_data(wavelengths.begin(), wavelengths.end());
-    std::vector<double> y_data_current;
-    std::vector<double> y_data_voltage;
-    std::vector<double> y_data_counts;
-
-    for (const auto& wavelength : wavelengths) {
-      mono->move_to_target_wavelength(wavelength);
-      while (mono->is_busy()) {
-        std::this_thread::sleep_for(std::chrono::milliseconds(100));
-      }
-      spdlog::info("Mono moved to wavelength: {}", wavelength);
-
-      while (spectracq3->is_busy()) {
-        std::this_thread::sleep_for(std::chrono::milliseconds(100));
-        spdlog::info("Spectracq3 is busy, waiting...");
-      }
-      spectracq3->set_acquisition_set(scan_count, time_step, integration_time,
-                                      external_param);
-      spectracq3->acquisition_start(
-          SpectrAcq3::TriggerMode::START_AND_INTERVAL);
-      while (spectracq3->is_busy()) {
-        std::this_thread::sleep_for(std::chrono::milliseconds(150));
-        spdlog::info("Spectracq3 is busy, waiting...");
-      }
-      std::this_thread::sleep_for(std::chrono::milliseconds(150));
-      if (!spectracq3->is_data_available()) {
-        spdlog::error("No data available for wavelength: {}", wavelength);
-        spectracq3->close();
-        mono->close();
-        icl_device_manager.stop();
-        return 1;
-      }
-
-      std::unordered_set<Channel, Channel::Hash> channels = {
-          Channel::Voltage, Channel::Current,
-          Channel::Photon,  // include only the ones you need
-                            // Channel:Ppd
-      };
-
-      auto data = spectracq3->get_acquisition_data(channels);
-      spdlog::info("Acquisition data for wavelength {}nm: {}", wavelength,
-                   data.dump());
-
-      y_data_current.push_back(data[0]["currentSignal"]["value"]);
-      y_data_voltage.push_back(data[0]["voltageSignal"]["value"]);
-      y_data_counts.push_back(data[0]["pmtSignal"]["value"]);
-    }
+    const auto counts = result.records.values(SpectrAcq3Channels::PHOTON);
+    std::vector<double> x_data(result.wavelengths.begin(),
+                               result.wavelengths.end());
+    std::vector<double> y_data_counts(counts.begin(), counts.end());
 
     plot_spectral_data(start_wavelength, end_wavelength, x_data, y_data_counts);
 
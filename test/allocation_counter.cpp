@@ -0,0 +1,127 @@
+#include "allocation_counter.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+
+namespace horiba::test {
+
+namespace {
+std::atomic<bool> counting{false};
+std::atomic<std::size_t> allocations{0};
+thread_local bool thread_ignored = false;
+
+void count_allocation() {
+  if (counting.load(std::memory_order_relaxed) && !thread_ignored) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+void* allocate(std::size_t size) {
+  count_allocation();
+  void* pointer = std::malloc(size == 0 ? 1 : size);
+  if (pointer == nullptr) {
+    throw std::bad_alloc();
+  }
+  return pointer;
+}
+
+void* allocate_aligned(std::size_t size, std::align_val_t alignment) {
+  count_allocation();
+  const auto align = static_cast<std::size_t>(alignment);
+  const auto rounded_size = ((size == 0 ? 1 : size) + align - 1) / align * align;
+#ifdef _WIN32
+  void* pointer = _aligned_malloc(rounded_size, align);
+#else
+  void* pointer = std::aligned_alloc(align, rounded_size);
+#endif
+  if (pointer == nullptr) {
+    throw std::bad_alloc();
+  }
+  return pointer;
+}
+
+void free_aligned(void* pointer) {
+#ifdef _WIN32
+  _aligned_free(pointer);
+#else
+  std::free(pointer);
+#endif
+}
+}  // namespace
+
+void AllocationCounter::start() {
+  allocations.store(0);
+  counting.store(true);
+}
+
+std::size_t AllocationCounter::stop() {
+  counting.store(false);
+  return allocations.load();
+}
+
+void AllocationCounter::ignore_current_thread() { thread_ignored = true; }
+
+}  // namespace horiba::test
+
+void* operator new(std::size_t size) { return horiba::test::allocate(size); }
+
+void* operator new[](std::size_t size) { return horiba::test::allocate(size); }
+
+void* operator new(std::size_t size, const std::nothrow_t& /*tag*/) noexcept {
+  try {
+    return horiba::test::allocate(size);
+  } catch (...) {
+    return nullptr;
+  }
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t& /*tag*/) noexcept {
+  try {
+    return horiba::test::allocate(size);
+  } catch (...) {
+    return nullptr;
+  }
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+  return horiba::test::allocate_aligned(size, alignment);
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+  return horiba::test::allocate_aligned(size, alignment);
+}
+
+void operator delete(void* pointer) noexcept { std::free(pointer); }
+
+void operator delete[](void* pointer) noexcept { std::free(pointer); }
+
+void operator delete(void* pointer, std::size_t /*size*/) noexcept {
+  std::free(pointer);
+}
+
+void operator delete[](void* pointer, std::size_t /*size*/) noexcept {
+  std::free(pointer);
+}
+
+void operator delete(void* pointer, std::align_val_t /*alignment*/) noexcept {
+  horiba::test::free_aligned(pointer);
+}
+
+void operator delete[](void* pointer, std::align_val_t /*alignment*/) noexcept {
+  horiba::test::free_aligned(pointer);
+}
+
+void operator delete(void* pointer, std::size_t /*size*/,
+                     std::align_val_t /*alignment*/) noexcept {
+  horiba::test::free_aligned(pointer);
+}
+
+void operator delete[](void* pointer, std::size_t /*size*/,
+                       std::align_val_t /*alignment*/) noexcept {
+  horiba::test::free_aligned(pointer);
+}
@@ -0,0 +1,37 @@
+#ifndef ALLOCATION_COUNTER_H
+#define ALLOCATION_COUNTER_H
+
+#include <cstddef>
+
+namespace horiba::test {
+
+/**
+ * @brief Counts the heap allocations of the test process.
+ *
+ * The global operator new is replaced in allocation_counter.cpp. Only
+ * allocations between start() and stop() are counted, on every thread except
+ * the ones that called ignore_current_thread(), e.g. the fake ICL server.
+ */
+class AllocationCounter {
+ public:
+  /**
+   * @brief Starts counting allocations from zero.
+   */
+  static void start();
+
+  /**
+   * @brief Stops counting allocations.
+   *
+   * @return The number of allocations since start()
+   */
+  static std::size_t stop();
+
+  /**
+   * @brief Excludes the allocations of the calling thread from the count.
+   */
+  static void ignore_current_thread();
+};
+
+}  // namespace horiba::test
+
+#endif /* ifndef ALLOCATION_COUNTER_H */
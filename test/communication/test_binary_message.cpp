@@ -0,0 +1,111 @@
+#include <horiba_cpp_sdk/communication/binary_message.h>
+
+#include <boost/asio/buffer.hpp>
+#include <boost/beast/core/flat_buffer.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace horiba::test {
+using namespace horiba::communication;
+
+namespace {
+std::shared_ptr<const BinaryMessage> make_message(
+    BinaryMessageType type, const std::vector<std::uint8_t>& content) {
+  boost::beast::flat_buffer buffer;
+  auto writable = buffer.prepare(content.size());
+  boost::asio::buffer_copy(writable, boost::asio::buffer(content));
+  buffer.commit(content.size());
+  return std::make_shared<const BinaryMessage>(type, std::move(buffer));
+}
+}  // namespace
+
+TEST_CASE("Binary messages are classified by their first byte",
+          "[binary_message]") {
+  const std::vector<std::byte> log{std::byte{0}, std::byte{'a'}};
+  const std::vector<std::byte> information{std::byte{1}};
+  const std::vector<std::byte> data{std::byte{2}, std::byte{0xFF}};
+  const std::vector<std::byte> unknown{std::byte{42}};
+  const std::vector<std::byte> empty;
+
+  REQUIRE(default_binary_message_classifier(log) == BinaryMessageType::LOG);
+  REQUIRE(default_binary_message_classifier(information) ==
+          BinaryMessageType::INFORMATION);
+  REQUIRE(default_binary_message_classifier(data) == BinaryMessageType::DATA);
+  REQUIRE(default_binary_message_classifier(unknown) ==
+          BinaryMessageType::UNKNOWN);
+  REQUIRE(default_binary_message_classifier(empty) ==
+          BinaryMessageType::UNKNOWN);
+}
+
+TEST_CASE("Binary message keeps the buffer it was read into",
+          "[binary_message]") {
+  // arrange
+  boost::beast::flat_buffer buffer;
+  const std::vector<std::uint8_t> content{2, 7, 8, 9};
+  auto writable = buffer.prepare(content.size());
+  boost::asio::buffer_copy(writable, boost::asio::buffer(content));
+  buffer.commit(content.size());
+  const auto* const read_into = buffer.data().data();
+
+  // act
+  const BinaryMessage message(BinaryMessageType::DATA, std::move(buffer));
+
+  // assert
+  REQUIRE(message.type() == BinaryMessageType::DATA);
+  REQUIRE(message.size() == content.size());
+  REQUIRE(message.data().data() == read_into);
+  REQUIRE(message.data()[3] == std::byte{9});
+}
+
+TEST_CASE("Binary message queue", "[binary_message]") {
+  SECTION("Messages are taken in the order they were pushed") {
+    // arrange
+    BinaryMessageQueue queue;
+    const auto first = make_message(BinaryMessageType::LOG, {0, 1});
+    const auto second = make_message(BinaryMessageType::LOG, {0, 2});
+
+    // act
+    queue.push(first);
+    queue.push(second);
+
+    // assert
+    REQUIRE(queue.size() == 2);
+    REQUIRE(queue.try_pop() == first);
+    REQUIRE(queue.try_pop() == second);
+    REQUIRE(queue.try_pop() == nullptr);
+  }
+
+  SECTION("Waiting on an empty queue times out") {
+    // arrange
+    BinaryMessageQueue queue;
+
+    // act
+    const auto message = queue.wait_and_pop(std::chrono::milliseconds(10));
+
+    // assert
+    REQUIRE(message == nullptr);
+  }
+
+  SECTION("A full queue drops the oldest message") {
+    // arrange
+    BinaryMessageQueue queue(2);
+    const auto first = make_message(BinaryMessageType::DATA, {2, 1});
+    const auto second = make_message(BinaryMessageType::DATA, {2, 2});
+    const auto third = make_message(BinaryMessageType::DATA, {2, 3});
+
+    // act
+    queue.push(first);
+    queue.push(second);
+    queue.push(third);
+
+    // assert
+    REQUIRE(queue.size() == 2);
+    REQUIRE(queue.dropped() == 1);
+    REQUIRE(queue.try_pop() == second);
+    REQUIRE(queue.try_pop() == third);
+  }
+}
+}  // namespace horiba::test
@@ -0,0 +1,220 @@
+#include <horiba_cpp_sdk/communication/command.h>
+#include <horiba_cpp_sdk/communication/communicator_pool.h>
+#include <horiba_cpp_sdk/communication/response.h>
+
+#include <catch2/catch_test_macros.hpp>
+#include <chrono>
+#include <future>
+#include <memory>
+#include <string>
+
+#include "../fake_icl_server.h"
+
+namespace horiba::test {
+
+using namespace horiba::communication;
+
+TEST_CASE("Communicator pool test with fake ICL", "[communicator_pool]") {
+  // arrange
+  CommunicatorPool pool(FakeICLServer::FAKE_ICL_ADDRESS,
+                        std::to_string(FakeICLServer::FAKE_ICL_PORT),
+                        ConnectionPoolConfig{2, 1});
+
+  SECTION("Communicator pool opens and closes all its connections") {
+    // act
+    pool.open();
+    const auto pool_open = pool.is_open();
+    pool.close();
+
+    // assert
+    REQUIRE(pool.connections() == 4);
+    REQUIRE(pool_open);
+    REQUIRE_FALSE(pool.is_open());
+  }
+
+  SECTION("Already opened communicator pool cannot be opened again") {
+    // act
+    pool.open();
+
+    // assert
+    REQUIRE_THROWS(pool.open());
+    REQUIRE(pool.is_open());
+  }
+
+  SECTION("Communicator pool sends requests and receives responses") {
+    // arrange
+    pool.open();
+    const Command control_command("mono_isBusy", {{"index", 0}});
+    const Command bulk_command("ccd_getAcquisitionData", {{"index", 0}});
+
+    // act
+    const auto control_response = pool.request_with_response(control_command);
+    const auto bulk_response = pool.request_with_response(bulk_command);
+
+    // assert
+    REQUIRE(control_response.id() == control_command.id());
+    REQUIRE(bulk_response.id() == bulk_command.id());
+  }
+
+  SECTION("Bulk data commands use another connection than control commands") {
+    // arrange
+    const Command control_command("ccd_getAcquisitionBusy", {{"index", 0}});
+    const Command bulk_command("ccd_getAcquisitionData", {{"index", 0}});
+
+    // act
+    const auto control_connection = pool.connection_for(control_command);
+    const auto bulk_connection = pool.connection_for(bulk_command);
+
+    // assert
+    REQUIRE(control_connection != bulk_connection);
+  }
+
+  SECTION("Priority commands use a connection of their own") {
+    // arrange
+    const Command control_command("ccd_getAcquisitionBusy", {{"index", 0}});
+    const Command bulk_command("ccd_getAcquisitionData", {{"index", 0}});
+    const Command abort_command("ccd_acquisitionAbort", {{"index", 0}});
+    const Command stop_command("saq3_acqStop", {{"index", 0}});
+
+    // act
+    const auto abort_connection = pool.connection_for(abort_command);
+
+    // assert
+    REQUIRE(abort_connection != pool.connection_for(control_command));
+    REQUIRE(abort_connection != pool.connection_for(bulk_command));
+    REQUIRE(pool.connection_for(stop_command) == abort_connection);
+  }
+
+  SECTION("Priority commands use the control connections if they have none") {
+    // arrange
+    CommunicatorPool shared_pool(FakeICLServer::FAKE_ICL_ADDRESS,
+                                 std::to_string(FakeICLServer::FAKE_ICL_PORT),
+                                 ConnectionPoolConfig{1, 1, 0});
+    const Command control_command("ccd_getAcquisitionBusy", {{"index", 0}});
+    const Command abort_command("ccd_acquisitionAbort", {{"index", 0}});
+
+    // act
+    const auto abort_connection = shared_pool.connection_for(abort_command);
+
+    // assert
+    REQUIRE(shared_pool.connections() == 2);
+    REQUIRE(abort_connection == shared_pool.connection_for(control_command));
+  }
+
+  SECTION("Devices are spread over the connections and keep theirs") {
+    // arrange
+    const Command first_ccd_command("ccd_getAcquisitionBusy", {{"index", 0}});
+    const Command second_ccd_command("ccd_getAcquisitionBusy", {{"index", 1}});
+    const Command first_ccd_other_command("ccd_getExposureTime",
+                                          {{"index", 0}});
+
+    // act
+    const auto first_ccd_connection = pool.connection_for(first_ccd_command);
+    const auto second_ccd_connection = pool.connection_for(second_ccd_command);
+
+    // assert
+    REQUIRE(first_ccd_connection != second_ccd_connection);
+    REQUIRE(pool.connection_for(first_ccd_other_command) ==
+            first_ccd_connection);
+  }
+
+  SECTION("Commands without device use the first control connection") {
+    // arrange
+    const Command device_command("mono_isBusy", {{"index", 0}});
+    const Command other_device_command("mono_isBusy", {{"index", 1}});
+    const Command icl_command("icl_info");
+
+    // act
+    const auto icl_connection = pool.connection_for(icl_command);
+    const auto first_device_connection = pool.connection_for(device_command);
+    const auto second_device_connection =
+        pool.connection_for(other_device_command);
+
+    // assert
+    REQUIRE(icl_connection == first_device_connection);
+    REQUIRE(icl_connection != second_device_connection);
+  }
+
+  SECTION("A held bulk response does not hold back control commands") {
+    // arrange
+    pool.open();
+    pool.set_command_classifier([](const Command& command) {
+      return command.name() == "test_hold_response" ? CommandClass::BULK_DATA
+                                                    : CommandClass::CONTROL;
+    });
+    const Command held_command("test_hold_response");
+    const Command control_command("test_command");
+
+    // act
+    auto held_response = pool.request_async(held_command);
+    const auto control_response = pool.request_with_response(control_command);
+
+    // assert
+    REQUIRE(control_response.id() == control_command.id());
+    // the fake ICL only sends a held response after the next response on the
+    // same connection
+    REQUIRE(held_response.wait_for(std::chrono::milliseconds(100)) ==
+            std::future_status::timeout);
+    pool.close();
+    REQUIRE_THROWS(held_response.get());
+  }
+
+  SECTION("A priority command is answered while a bulk response is held") {
+    // arrange
+    pool.open();
+    pool.set_command_classifier([](const Command& command) {
+      if (command.name() == "test_hold_response") {
+        return CommandClass::BULK_DATA;
+      }
+      return command.name() == "test_command" ? CommandClass::PRIORITY
+                                              : CommandClass::CONTROL;
+    });
+    const Command held_command("test_hold_response");
+    const Command priority_command("test_command");
+
+    // act
+    auto held_response = pool.request_async(held_command);
+    const auto priority_response =
+        pool.request_with_response(priority_command);
+    const auto latency = pool.priority_latency();
+
+    // assert
+    REQUIRE(priority_response.id() == priority_command.id());
+    REQUIRE(held_response.wait_for(std::chrono::milliseconds(100)) ==
+            std::future_status::timeout);
+    REQUIRE(latency.count == 1);
+    REQUIRE(latency.last > std::chrono::microseconds{0});
+    REQUIRE(latency.max == latency.last);
+    REQUIRE(latency.mean() == latency.last);
+    pool.close();
+    REQUIRE_THROWS(held_response.get());
+  }
+
+  SECTION("Only priority commands are measured") {
+    // arrange
+    pool.open();
+    const Command control_command("mono_isBusy", {{"index", 0}});
+
+    // act
+    const auto _ignored_response = pool.request_with_response(control_command);
+
+    // assert
+    REQUIRE(pool.priority_latency().count == 0);
+    REQUIRE(pool.priority_latency().mean() == std::chrono::microseconds{0});
+  }
+
+  SECTION("Communicator pool needs a control connection") {
+    // act
+    // assert
+    REQUIRE_THROWS_AS(CommunicatorPool(FakeICLServer::FAKE_ICL_ADDRESS,
+                                       std::to_string(
+                                           FakeICLServer::FAKE_ICL_PORT),
+                                       ConnectionPoolConfig{0, 1}),
+                      std::invalid_argument);
+  }
+
+  if (pool.is_open()) {
+    pool.close();
+  }
+}
+}  // namespace horiba::test
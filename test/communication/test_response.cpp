@@ -0,0 +1,70 @@
+#include <horiba_cpp_sdk/communication/response.h>
+
+#include <catch2/catch_test_macros.hpp>
+#include <optional>
+#include <stdexcept>
+#include <string>
+
+namespace horiba::test {
+using namespace horiba::communication;
+
+TEST_CASE("Response is built from the raw text of the ICL", "[response]") {
+  SECTION("Id, errors and results are decoded") {
+    // arrange
+    const std::string raw_response =
+        R"({"command":"ccd_getChipSize","errors":["first","second"],)"
+        R"("id":42,"results":{"x":1024,"y":256}})";
+
+    // act
+    const Response response(raw_response);
+
+    // assert
+    REQUIRE(response.id() == 42);
+    REQUIRE(response.errors().size() == 2);
+    REQUIRE(response.errors()[1] == "second");
+    REQUIRE(response.json_results().at("x").get<int>() == 1024);
+    REQUIRE(response.raw() == raw_response);
+  }
+
+  SECTION("Missing results are empty") {
+    // arrange
+    // act
+    const Response response(R"({"command":"icl_info","id":1,"errors":[]})");
+
+    // assert
+    REQUIRE(response.json_results().empty());
+  }
+
+  SECTION("Invalid responses are rejected") {
+    REQUIRE_THROWS_AS(Response(std::string{R"({"command":"icl_info")"}),
+                      std::invalid_argument);
+    REQUIRE_THROWS_AS(Response(std::string{R"({"command":"icl_info"})"}),
+                      std::invalid_argument);
+  }
+
+  SECTION("The id of an invalid response can still be read") {
+    // arrange
+    const std::string truncated = R"({"id":42,"command":"icl_info","results)";
+
+    // act
+    const auto id = Response::scan_id(truncated);
+
+    // assert
+    REQUIRE_THROWS_AS(Response(truncated), std::invalid_argument);
+    REQUIRE(id == std::optional<unsigned long long int>(42));
+    REQUIRE_FALSE(Response::scan_id(R"({"command":"icl_info"})").has_value());
+    REQUIRE_FALSE(Response::scan_id("not json").has_value());
+  }
+}
+
+TEST_CASE("Response built from its parts has no raw text", "[response]") {
+  // arrange
+  // act
+  const Response response(7, "icl_info", {{"key", 1}}, {});
+
+  // assert
+  REQUIRE(response.id() == 7);
+  REQUIRE(response.raw().empty());
+  REQUIRE(response.json_results().at("key").get<int>() == 1);
+}
+}  // namespace horiba::test
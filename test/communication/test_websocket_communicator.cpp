@@ -1,12 +1,25 @@
+#include <horiba_cpp_sdk/communication/binary_message.h>
 #include <horiba_cpp_sdk/communication/command.h>
 #include <horiba_cpp_sdk/communication/response.h>
 #include <horiba_cpp_sdk/communication/websocket_communicator.h>
+#include <spdlog/spdlog.h>
 
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/use_awaitable.hpp>
+#include <boost/asio/use_future.hpp>
 #include <catch2/catch_message.hpp>
 #include <catch2/catch_test_macros.hpp>
+#include <algorithm>
+#include <cstddef>
 #include <cstdlib>
+#include <future>
 #include <nlohmann/json.hpp>
+#include <string>
+#include <thread>
+#include <vector>
 
+#include "../allocation_counter.h"
 #include "../fake_icl_server.h"
 #include "../icl_exe.h"
 
@@ -91,6 +104,203 @@ TEST_CASE("WebSocket communicator test with fake ICL",
     }
   }
 
+  SECTION("WebSocketCommunicator can have multiple requests in flight") {
+    // arrange
+    websocket_communicator.open();
+    const size_t amount_requests = 50;
+    std::vector<horiba::communication::Command> commands;
+    commands.reserve(amount_requests);
+    for (size_t i = 0; i < amount_requests; i++) {
+      commands.emplace_back("test_command");
+    }
+
+    // act
+    std::vector<std::future<communication::Response>> responses;
+    responses.reserve(amount_requests);
+    for (const auto& command : commands) {
+      responses.push_back(websocket_communicator.request_async(command));
+    }
+
+    // assert
+    for (size_t i = 0; i < amount_requests; i++) {
+      REQUIRE(responses[i].get().id() == commands[i].id());
+    }
+    REQUIRE(websocket_communicator.pending_requests() == 0);
+  }
+
+  SECTION("WebSocketCommunicator matches out of order responses by id") {
+    // arrange
+    websocket_communicator.open();
+    const horiba::communication::Command held_command("test_hold_response");
+    const horiba::communication::Command command("test_command");
+
+    // act
+    auto held_response = websocket_communicator.request_async(held_command);
+    auto response = websocket_communicator.request_async(command);
+
+    // assert
+    REQUIRE(response.get().id() == command.id());
+    REQUIRE(held_response.get().id() == held_command.id());
+  }
+
+  SECTION("WebSocketCommunicator calls the completion handler") {
+    // arrange
+    websocket_communicator.open();
+    const horiba::communication::Command command("test_command");
+    std::promise<unsigned long long int> received_id;
+
+    // act
+    websocket_communicator.request_async(
+        command, [&received_id](std::exception_ptr error,
+                                communication::Response response) {
+          if (error) {
+            received_id.set_exception(error);
+            return;
+          }
+          received_id.set_value(response.id());
+        });
+
+    // assert
+    REQUIRE(received_id.get_future().get() == command.id());
+  }
+
+  SECTION("WebSocketCommunicator can be used from many threads at once") {
+    // arrange
+    websocket_communicator.open();
+    const size_t amount_threads = 8;
+    const size_t amount_requests = 100;
+    const std::vector<std::string> command_names = {
+        "mono_isBusy", "ccd_getExposureTime", "test_command"};
+    // the assertion macros are not thread-safe, the threads only count
+    std::vector<size_t> matched_responses(amount_threads, 0);
+
+    // act
+    std::vector<std::thread> threads;
+    threads.reserve(amount_threads);
+    for (size_t t = 0; t < amount_threads; t++) {
+      threads.emplace_back([&, t] {
+        const auto& command_name = command_names[t % command_names.size()];
+        for (size_t i = 0; i < amount_requests; i++) {
+          const horiba::communication::Command command(command_name,
+                                                       {{"index", 0}});
+          const auto response =
+              websocket_communicator.request_with_response(command);
+          if (response.id() == command.id()) {
+            matched_responses[t]++;
+          }
+        }
+      });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+
+    // assert
+    for (size_t t = 0; t < amount_threads; t++) {
+      REQUIRE(matched_responses[t] == amount_requests);
+    }
+    REQUIRE(websocket_communicator.pending_requests() == 0);
+  }
+
+  SECTION("WebSocketCommunicator requests can be awaited in a coroutine") {
+    // arrange
+    websocket_communicator.open();
+    boost::asio::io_context context;
+    const horiba::communication::Command command("test_command");
+
+    // act
+    auto completion_thread = boost::asio::co_spawn(
+        context,
+        [&]() -> boost::asio::awaitable<std::thread::id> {
+          const auto response = co_await websocket_communicator.async_request(
+              command, boost::asio::use_awaitable);
+          if (response.id() != command.id()) {
+            throw std::runtime_error("unexpected response");
+          }
+          co_return std::this_thread::get_id();
+        },
+        boost::asio::use_future);
+    context.run();
+
+    // assert
+    // the coroutine is resumed on its own executor
+    REQUIRE(completion_thread.get() == std::this_thread::get_id());
+  }
+
+  SECTION("Awaited requests fail when WebSocketCommunicator is closed") {
+    // arrange
+    boost::asio::io_context context;
+    const horiba::communication::Command command("test_command");
+
+    // act
+    auto response = boost::asio::co_spawn(
+        context,
+        [&]() -> boost::asio::awaitable<communication::Response> {
+          co_return co_await websocket_communicator.async_request(
+              command, boost::asio::use_awaitable);
+        },
+        boost::asio::use_future);
+    context.run();
+
+    // assert
+    REQUIRE_THROWS_AS(response.get(), std::runtime_error);
+  }
+
+  SECTION("Pending requests fail when WebSocketCommunicator is closed") {
+    // arrange
+    websocket_communicator.open();
+    const horiba::communication::Command held_command("test_hold_response");
+
+    // act
+    auto held_response = websocket_communicator.request_async(held_command);
+    websocket_communicator.close();
+
+    // assert
+    REQUIRE_THROWS(held_response.get());
+  }
+
+  SECTION("WebSocketCommunicator hands binary messages to the subscribers") {
+    // arrange
+    websocket_communicator.open();
+    auto logs = websocket_communicator.subscribe_binary_messages(
+        communication::BinaryMessageType::LOG);
+    auto data = websocket_communicator.subscribe_binary_messages(
+        communication::BinaryMessageType::DATA);
+    auto other_data = websocket_communicator.subscribe_binary_messages(
+        communication::BinaryMessageType::DATA);
+    const horiba::communication::Command command("test_send_binary_messages");
+
+    // act
+    const auto response = websocket_communicator.request_with_response(command);
+
+    // assert
+    REQUIRE(response.id() == command.id());
+    REQUIRE(logs->size() == 1);
+    REQUIRE(data->size() == 1);
+    const auto log_message = logs->try_pop();
+    REQUIRE(log_message->type() == communication::BinaryMessageType::LOG);
+    REQUIRE(log_message->size() == FakeICLServer::FAKE_BINARY_MESSAGES[0].size());
+    const auto data_message = data->try_pop();
+    REQUIRE(data_message->type() == communication::BinaryMessageType::DATA);
+    REQUIRE(data_message->data()[1] == std::byte{0x10});
+    // all subscribers share the same message
+    REQUIRE(other_data->try_pop() == data_message);
+  }
+
+  SECTION("WebSocketCommunicator can be opened again after being closed") {
+    // arrange
+    websocket_communicator.open();
+    websocket_communicator.close();
+
+    // act
+    websocket_communicator.open();
+    const horiba::communication::Command command("test_command");
+    const auto response = websocket_communicator.request_with_response(command);
+
+    // assert
+    REQUIRE(response.id() == command.id());
+  }
+
   SECTION("Already opened WebSocketCommunicator cannot be opened again") {
     // act
     websocket_communicator.open();
@@ -101,6 +311,33 @@ TEST_CASE("WebSocket communicator test with fake ICL",
     REQUIRE(websocket_communicator.is_open() == true);
   }
 
+  SECTION("WebSocketCommunicator is opened only once by concurrent callers") {
+    // arrange
+    const size_t amount_threads = 4;
+    std::vector<int> opened(amount_threads, 0);
+
+    // act
+    std::vector<std::thread> threads;
+    threads.reserve(amount_threads);
+    for (size_t t = 0; t < amount_threads; t++) {
+      threads.emplace_back([&, t] {
+        try {
+          websocket_communicator.open();
+          opened[t] = 1;
+        } catch (const std::runtime_error&) {
+          opened[t] = 0;
+        }
+      });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+
+    // assert
+    REQUIRE(std::count(opened.begin(), opened.end(), 1) == 1);
+    REQUIRE(websocket_communicator.is_open() == true);
+  }
+
   SECTION("Already closed WebSocketCommunicator cannot be closed again") {
     // arrange
     websocket_communicator.open();
@@ -119,6 +356,42 @@ TEST_CASE("WebSocket communicator test with fake ICL",
   }
 }
 
+TEST_CASE("WebSocket communicator does not allocate once warmed up",
+          "[websocket_communicator]") {
+  // arrange
+  horiba::communication::WebSocketCommunicator websocket_communicator(
+      FakeICLServer::FAKE_ICL_ADDRESS,
+      std::to_string(FakeICLServer::FAKE_ICL_PORT));
+  websocket_communicator.open();
+  const horiba::communication::Command get_command("ccd_getExposureTime",
+                                                   {{"index", 0}});
+  const horiba::communication::Command set_command(
+      "ccd_setExposureTime", {{"index", 0}, {"time", 100}});
+  // formatting debug logs allocates
+  const auto log_level = spdlog::get_level();
+  spdlog::set_level(spdlog::level::info);
+
+  const size_t warm_up_requests = 100;
+  for (size_t i = 0; i < warm_up_requests; i++) {
+    auto _get_response = websocket_communicator.request_with_response(get_command);
+    auto _set_response = websocket_communicator.request_with_response(set_command);
+  }
+
+  // act
+  const size_t amount_requests = 1000;
+  AllocationCounter::start();
+  for (size_t i = 0; i < amount_requests; i++) {
+    auto _get_response = websocket_communicator.request_with_response(get_command);
+    auto _set_response = websocket_communicator.request_with_response(set_command);
+  }
+  const auto allocations = AllocationCounter::stop();
+  spdlog::set_level(log_level);
+  websocket_communicator.close();
+
+  // assert
+  REQUIRE(allocations == 0);
+}
+
 TEST_CASE("WebSocket communicator test without fake ICL",
           "[websocket_communicator]") {
   horiba::communication::WebSocketCommunicator websocket_communicator(
@@ -221,6 +494,33 @@ TEST_CASE_METHOD(ICLExe, "WebSocket communicator test with real ICL",
     REQUIRE(websocket_communicator.is_open() == true);
   }
 
+  SECTION("WebSocketCommunicator is opened only once by concurrent callers") {
+    // arrange
+    const size_t amount_threads = 4;
+    std::vector<int> opened(amount_threads, 0);
+
+    // act
+    std::vector<std::thread> threads;
+    threads.reserve(amount_threads);
+    for (size_t t = 0; t < amount_threads; t++) {
+      threads.emplace_back([&, t] {
+        try {
+          websocket_communicator.open();
+          opened[t] = 1;
+        } catch (const std::runtime_error&) {
+          opened[t] = 0;
+        }
+      });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+
+    // assert
+    REQUIRE(std::count(opened.begin(), opened.end(), 1) == 1);
+    REQUIRE(websocket_communicator.is_open() == true);
+  }
+
   SECTION("Already closed WebSocketCommunicator cannot be closed again") {
     // arrange
     websocket_communicator.open();
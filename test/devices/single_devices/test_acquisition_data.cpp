@@ -0,0 +1,164 @@
+#include <horiba_cpp_sdk/devices/single_devices/acquisition_data.h>
+
+#include <catch2/catch_test_macros.hpp>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+
+namespace horiba::test {
+using namespace horiba::devices::single_devices;
+
+namespace {
+std::string acquisition_response(const std::string& acquisitions) {
+  return R"({"command":"ccd_getAcquisitionData","errors":[],"id":1,)"
+         R"("results":{"acquisition":[)" +
+         acquisitions + R"(],"timestamp":"2024.04.22 15:07:50.096"}})";
+}
+
+std::string full_frame_acquisition(int acquisition_index, std::size_t columns,
+                                   std::size_t rows) {
+  std::string x_data;
+  for (std::size_t column = 0; column < columns; column++) {
+    x_data += (column == 0 ? "" : ",") + std::to_string(column);
+  }
+
+  std::string y_data;
+  for (std::size_t row = 0; row < rows; row++) {
+    y_data += row == 0 ? "[" : ",[";
+    for (std::size_t column = 0; column < columns; column++) {
+      y_data += (column == 0 ? "" : ",") + std::to_string(row * columns + column);
+    }
+    y_data += "]";
+  }
+
+  return R"({"acqIndex":)" + std::to_string(acquisition_index) +
+         R"(,"roi":[{"roiIndex":1,"xBinning":1,"xData":[[)" + x_data +
+         R"(]],"xOrigin":0,"xSize":)" + std::to_string(columns) +
+         R"(,"yBinning":1,"yData":[)" + y_data +
+         R"(],"yOrigin":0,"ySize":)" + std::to_string(rows) + "}]}";
+}
+}  // namespace
+
+TEST_CASE("Acquisition data is decoded from the raw response",
+          "[acquisition_data]") {
+  SECTION("Full frame image") {
+    // arrange
+    const std::size_t columns = 1024;
+    const std::size_t rows = 256;
+    const auto raw_response =
+        acquisition_response(full_frame_acquisition(1, columns, rows));
+
+    // act
+    const auto data = AcquisitionData::parse(raw_response);
+
+    // assert
+    REQUIRE(data.timestamp() == "2024.04.22 15:07:50.096");
+    REQUIRE(data.acquisitions().size() == 1);
+    const auto& acquisition = data.acquisitions()[0];
+    REQUIRE(acquisition.index == 1);
+    REQUIRE(acquisition.regions_of_interest.size() == 1);
+    const auto& roi = acquisition.regions_of_interest[0];
+    REQUIRE(roi.index == 1);
+    REQUIRE(roi.x_size == static_cast<int>(columns));
+    REQUIRE(roi.y_size == static_cast<int>(rows));
+    REQUIRE(roi.x_data().size() == columns);
+    REQUIRE(roi.rows() == rows);
+    REQUIRE(roi.samples().size() == columns * rows);
+    REQUIRE(roi.row(3)[5] == static_cast<double>(3 * columns + 5));
+    REQUIRE(roi.row(rows - 1).back() ==
+            static_cast<double>(columns * rows - 1));
+    REQUIRE_THROWS_AS(roi.row(rows), std::out_of_range);
+  }
+
+  SECTION("Identical x axes are stored once") {
+    // arrange
+    const auto raw_response = acquisition_response(
+        full_frame_acquisition(1, 16, 2) + "," +
+        full_frame_acquisition(2, 16, 2) + "," +
+        full_frame_acquisition(3, 8, 2));
+
+    // act
+    const auto data = AcquisitionData::parse(raw_response);
+
+    // assert
+    REQUIRE(data.acquisitions().size() == 3);
+    REQUIRE(data.distinct_x_axes() == 2);
+    const auto& first = data.acquisitions()[0].regions_of_interest[0];
+    const auto& second = data.acquisitions()[1].regions_of_interest[0];
+    REQUIRE(first.x_data().data() == second.x_data().data());
+    // the samples of all acquisitions are in one buffer
+    REQUIRE(first.samples().data() + first.samples().size() ==
+            second.samples().data());
+  }
+
+  SECTION("Flat x and y data") {
+    // arrange
+    const auto raw_response = acquisition_response(
+        R"({"acqIndex":1,"roi":[{"roiIndex":1,"xData":[1.5,2.5,3.5],)"
+        R"("yData":[10,20,30]}]})");
+
+    // act
+    const auto data = AcquisitionData::parse(raw_response);
+
+    // assert
+    const auto& roi = data.acquisitions()[0].regions_of_interest[0];
+    REQUIRE(roi.x_data()[1] == 2.5);
+    REQUIRE(roi.rows() == 1);
+    REQUIRE(roi.row(0)[2] == 30.0);
+  }
+
+  SECTION("xy data pairs") {
+    // arrange
+    const auto raw_response = acquisition_response(
+        R"({"acqIndex":1,"roi":[{"roiIndex":1,"xSize":2,)"
+        R"("xyData":[[885.63,976],[885.28,975]]}]})");
+
+    // act
+    const auto data = AcquisitionData::parse(raw_response);
+
+    // assert
+    const auto& roi = data.acquisitions()[0].regions_of_interest[0];
+    REQUIRE(roi.x_data().size() == 2);
+    REQUIRE(roi.x_data()[0] == 885.63);
+    REQUIRE(roi.rows() == 1);
+    REQUIRE(roi.row(0)[1] == 975.0);
+  }
+
+  SECTION("Copies share the decoded buffers") {
+    // arrange
+    const auto raw_response =
+        acquisition_response(full_frame_acquisition(1, 4, 2));
+    const auto* samples = static_cast<const double*>(nullptr);
+
+    // act
+    AcquisitionData copy;
+    {
+      const auto data = AcquisitionData::parse(raw_response);
+      samples = data.acquisitions()[0].regions_of_interest[0].samples().data();
+      copy = data;
+    }
+
+    // assert
+    REQUIRE(copy.acquisitions()[0].regions_of_interest[0].samples().data() ==
+            samples);
+    REQUIRE(copy.acquisitions()[0].regions_of_interest[0].row(1)[0] == 4.0);
+  }
+
+  SECTION("Rows of different lengths are rejected") {
+    // arrange
+    const auto raw_response = acquisition_response(
+        R"({"acqIndex":1,"roi":[{"roiIndex":1,"xData":[1,2],)"
+        R"("yData":[[1,2],[3]]}]})");
+
+    // act
+    // assert
+    REQUIRE_THROWS_AS(AcquisitionData::parse(raw_response),
+                      std::invalid_argument);
+  }
+
+  SECTION("Invalid JSON is rejected") {
+    REQUIRE_THROWS_AS(AcquisitionData::parse(R"({"results":{"acquisition":[)"),
+                      std::invalid_argument);
+  }
+}
+}  // namespace horiba::test
@@ -0,0 +1,132 @@
+#include <horiba_cpp_sdk/communication/websocket_communicator.h>
+#include <horiba_cpp_sdk/devices/single_devices/acquisition_pipeline.h>
+#include <horiba_cpp_sdk/devices/single_devices/ccd.h>
+
+#include <atomic>
+#include <catch2/catch_test_macros.hpp>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#include "../../fake_icl_server.h"
+
+namespace horiba::test {
+
+using namespace horiba::devices::single_devices;
+using namespace horiba::communication;
+
+TEST_CASE("Acquisition pipeline test with fake ICL",
+          "[acquisition_pipeline]") {
+  // arrange
+  auto websocket_communicator = std::make_shared<WebSocketCommunicator>(
+      FakeICLServer::FAKE_ICL_ADDRESS,
+      std::to_string(FakeICLServer::FAKE_ICL_PORT));
+  auto ccd = std::make_shared<ChargeCoupledDevice>(0, websocket_communicator);
+  AcquisitionPipeline::Options options;
+  options.frames = 3;
+  options.capacity = 1;
+  options.frame_timeout = std::chrono::seconds(2);
+
+  SECTION("Acquisition pipeline queues the decoded frames") {
+    // arrange
+    ccd->open();
+    AcquisitionPipeline pipeline(ccd, options);
+
+    // act
+    pipeline.start();
+    std::size_t popped = 0;
+    while (auto frame = pipeline.wait_and_pop(std::chrono::seconds(2))) {
+      // assert
+      REQUIRE(frame->sequence == popped);
+      REQUIRE_FALSE(frame->data.acquisitions().empty());
+      REQUIRE(frame->started <= frame->acquired);
+      REQUIRE(frame->acquired <= frame->decoded);
+      popped++;
+    }
+
+    REQUIRE(popped == 3);
+    REQUIRE(pipeline.acquired_frames() == 3);
+    REQUIRE(pipeline.finished());
+    REQUIRE_FALSE(pipeline.try_pop().has_value());
+  }
+
+  SECTION("Acquisition pipeline hands the frames to a handler") {
+    // arrange
+    ccd->open();
+    std::atomic<std::size_t> handled{0};
+    AcquisitionPipeline pipeline(
+        ccd, options,
+        [&handled](const AcquisitionPipeline::Frame& /*frame*/) {
+          handled++;
+        });
+
+    // act
+    pipeline.start();
+    pipeline.wait_and_pop(std::chrono::seconds(2));
+    pipeline.stop();
+
+    // assert
+    REQUIRE(handled == 3);
+    REQUIRE_THROWS_AS(pipeline.start(), std::runtime_error);
+  }
+
+  SECTION("Acquisition pipeline decodes the frames fetched before stopping") {
+    // arrange
+    ccd->open();
+    options.frames = 0;
+    AcquisitionPipeline pipeline(ccd, options);
+    pipeline.start();
+    // one frame fills the queue, the next one waits to be decoded
+    const auto deadline =
+        std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (pipeline.acquired_frames() < 2 &&
+           std::chrono::steady_clock::now() < deadline) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    // act
+    pipeline.stop();
+    std::size_t popped = 0;
+    while (pipeline.try_pop().has_value()) {
+      popped++;
+    }
+
+    // assert
+    REQUIRE(pipeline.acquired_frames() >= 2);
+    REQUIRE(popped == pipeline.acquired_frames());
+    REQUIRE(pipeline.finished());
+  }
+
+  SECTION("Acquisition pipeline reports the error that stopped it") {
+    // arrange
+    // the communicator is not opened
+    AcquisitionPipeline pipeline(ccd, options);
+
+    // act
+    pipeline.start();
+
+    // assert
+    REQUIRE_THROWS_AS(pipeline.wait_and_pop(std::chrono::seconds(2)),
+                      std::runtime_error);
+    REQUIRE(pipeline.acquired_frames() == 0);
+  }
+
+  SECTION("Acquisition pipeline needs a CCD and room for frames") {
+    // arrange
+    options.capacity = 0;
+
+    // act
+    // assert
+    REQUIRE_THROWS_AS(AcquisitionPipeline(nullptr, {}), std::invalid_argument);
+    REQUIRE_THROWS_AS(AcquisitionPipeline(ccd, options),
+                      std::invalid_argument);
+  }
+
+  if (websocket_communicator->is_open()) {
+    websocket_communicator->close();
+  }
+}
+}  // namespace horiba::test
@@ -1,8 +1,14 @@
 #include <horiba_cpp_sdk/communication/websocket_communicator.h>
 #include <horiba_cpp_sdk/devices/single_devices/ccd.h>
 
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/use_awaitable.hpp>
+#include <boost/asio/use_future.hpp>
 #include <catch2/catch_test_macros.hpp>
+#include <chrono>
 #include <memory>
+#include <stdexcept>
 #include <string>
 #include <utility>
 #include <vector>
@@ -64,6 +70,42 @@ TEST_CASE("CCD test with fake ICL", "[ccd_no_hw]") {
     REQUIRE(configuration.empty() == false);
   }
 
+  SECTION("CCD capabilities are cached until the CCD is restarted") {
+    // arrange
+    ccd.open();
+
+    // act
+    const auto capabilities = ccd.capabilities();
+    const auto cached_capabilities = ccd.capabilities();
+    ccd.restart();
+    const auto capabilities_after_restart = ccd.capabilities();
+
+    // assert
+    REQUIRE(capabilities->chip_width == 1024);
+    REQUIRE(capabilities->chip_height == 256);
+    REQUIRE(capabilities->gains.size() == 3);
+    REQUIRE(cached_capabilities == capabilities);
+    REQUIRE(capabilities_after_restart != capabilities);
+  }
+
+  SECTION("CCD trigger input is validated against its capabilities") {
+    // arrange
+    ccd.open();
+
+    // act
+    // assert
+    REQUIRE_NOTHROW(ccd.set_trigger_input(true, 0, 1, 1));
+    REQUIRE_THROWS_AS(ccd.set_trigger_input(true, 1, 0, 0),
+                      std::runtime_error);
+    REQUIRE_THROWS_AS(ccd.set_trigger_input(true, 0, 2, 0),
+                      std::runtime_error);
+    REQUIRE_THROWS_AS(ccd.set_trigger_input(true, 0, 0, 2),
+                      std::runtime_error);
+    REQUIRE_NOTHROW(ccd.set_signal_output(true, 0, 3, 1));
+    REQUIRE_THROWS_AS(ccd.set_signal_output(true, 0, 4, 0),
+                      std::runtime_error);
+  }
+
   SECTION("CCD get gain") {
     // arrange
     ccd.open();
@@ -326,7 +368,12 @@ TEST_CASE("CCD test with fake ICL", "[ccd_no_hw]") {
     auto acquisition_data = ccd.get_acquisition_data();
 
     // assert
-    REQUIRE(acquisition_data.has_value() == true);
+    REQUIRE(acquisition_data.acquisitions().size() == 1);
+    const auto& roi = acquisition_data.acquisitions()[0].regions_of_interest[0];
+    REQUIRE(roi.x_size == 1000);
+    REQUIRE(roi.x_data().size() == 1000);
+    REQUIRE(roi.rows() == 1);
+    REQUIRE(roi.row(0).size() == 1000);
   }
 
   SECTION("CCD get acquisition busy") {
@@ -345,12 +392,127 @@ TEST_CASE("CCD test with fake ICL", "[ccd_no_hw]") {
     ccd.open();
 
     // act
+    const auto latency = ccd.abort_acquisition();
+
     // assert
-    REQUIRE_NOTHROW(ccd.abort_acquisition());
+    REQUIRE(latency > std::chrono::microseconds{0});
     // we do not check if the acquisition has truly stopped, as the fake answer
     // from the ICL always returns the same value
   }
 
+  SECTION("CCD acquisition can be done from a coroutine") {
+    // arrange
+    ccd.open();
+    boost::asio::io_context context;
+
+    // act
+    auto acquisition_data = boost::asio::co_spawn(
+        context,
+        [&]() -> boost::asio::awaitable<AcquisitionData> {
+          co_await ccd.set_exposure_time_async(100);
+          if (!co_await ccd.get_acquisition_ready_async()) {
+            throw std::runtime_error("CCD not ready");
+          }
+          co_await ccd.set_acquisition_start_async(true);
+          co_await ccd.wait_until_acquisition_done_async(
+              std::chrono::seconds(1));
+          // a fixed interval overrides the wait strategy of the CCD
+          co_await ccd.set_acquisition_start_async(true);
+          co_await ccd.wait_until_acquisition_done_async(
+              std::chrono::seconds(1), std::chrono::milliseconds(10));
+          co_return co_await ccd.get_acquisition_data_async();
+        },
+        boost::asio::use_future);
+    context.run();
+
+    // assert
+    const auto data = acquisition_data.get();
+    REQUIRE(data.acquisitions().size() == 1);
+    REQUIRE(data.acquisitions()[0].regions_of_interest[0].x_size == 1000);
+  }
+
+  SECTION("CCD profile only sends the settings that differ") {
+    // arrange
+    ccd.open();
+    ChargeCoupledDevice::Profile profile;
+    profile.acquisition_format = ChargeCoupledDevice::AcquisitionFormatSettings{
+        1, ChargeCoupledDevice::AcquisitionFormat::SPECTRA_IMAGE};
+    profile.regions_of_interest[1] =
+        ChargeCoupledDevice::RegionOfInterestSettings{0, 0, 1024, 256, 1, 256};
+    profile.gain = 0;
+    profile.exposure_time = 100;
+
+    // act
+    const auto first = ccd.apply(profile);
+    const auto second = ccd.apply(profile);
+    profile.exposure_time = 200;
+    const auto third = ccd.apply(profile);
+
+    // assert
+    REQUIRE(first == 4);
+    REQUIRE(second == 0);
+    REQUIRE(third == 1);
+    REQUIRE(ccd.known_settings().exposure_time == 200);
+    REQUIRE(ccd.known_settings().regions_of_interest.size() == 1);
+  }
+
+  SECTION("CCD setters update the known settings") {
+    // arrange
+    ccd.open();
+
+    // act
+    ccd.set_gain(1);
+    ccd.set_acquisition_count(2);
+
+    // assert
+    const auto known_settings = ccd.known_settings();
+    REQUIRE(known_settings.gain == 1);
+    REQUIRE(known_settings.acquisition_count == 2);
+    REQUIRE_FALSE(known_settings.speed.has_value());
+  }
+
+  SECTION("CCD forgets its known settings when it restarts") {
+    // arrange
+    ccd.open();
+    ChargeCoupledDevice::Profile profile;
+    profile.gain = 0;
+    ccd.apply(profile);
+
+    // act
+    ccd.restart();
+
+    // assert
+    REQUIRE_FALSE(ccd.known_settings().gain.has_value());
+    REQUIRE(ccd.apply(profile) == 1);
+  }
+
+  SECTION("CCD profile does not remember settings of a batch in progress") {
+    // arrange
+    ccd.open();
+    auto batch = ccd.batch();
+
+    // act
+    batch.add(&ChargeCoupledDevice::set_gain, 1);
+
+    // assert
+    REQUIRE_FALSE(ccd.known_settings().gain.has_value());
+  }
+
+  SECTION("CCD tells the exposure time of its started acquisition once") {
+    // arrange
+    ccd.open();
+    ccd.set_exposure_time(100);
+
+    // act
+    ccd.set_acquisition_start(true);
+    const auto travel = ccd.take_pending_travel();
+
+    // assert
+    REQUIRE(travel.kind == MoveKind::ACQUISITION);
+    REQUIRE(travel.distance == 100.0);
+    REQUIRE_FALSE(ccd.take_pending_travel().distance.has_value());
+  }
+
   if (websocket_communicator->is_open()) {
     websocket_communicator->close();
   }
@@ -0,0 +1,129 @@
+#include <horiba_cpp_sdk/communication/command.h>
+#include <horiba_cpp_sdk/communication/websocket_communicator.h>
+#include <horiba_cpp_sdk/devices/single_devices/ccd.h>
+#include <horiba_cpp_sdk/devices/single_devices/command_batch.h>
+#include <horiba_cpp_sdk/devices/single_devices/mono.h>
+
+#include <catch2/catch_test_macros.hpp>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+#include "../../fake_icl_server.h"
+
+namespace horiba::test {
+
+using namespace horiba::devices::single_devices;
+using namespace horiba::communication;
+
+TEST_CASE("Command batch test with fake ICL", "[command_batch]") {
+  // arrange
+  auto websocket_communicator = std::make_shared<WebSocketCommunicator>(
+      FakeICLServer::FAKE_ICL_ADDRESS,
+      std::to_string(FakeICLServer::FAKE_ICL_PORT));
+  auto ccd = ChargeCoupledDevice(0, websocket_communicator);
+
+  SECTION("Command batch queues the commands of setters") {
+    // arrange
+    auto batch = ccd.batch();
+
+    // act
+    batch.add(&ChargeCoupledDevice::set_exposure_time, 100)
+        .add(&ChargeCoupledDevice::set_acquisition_count, 1);
+
+    // assert
+    REQUIRE(batch.size() == 2);
+    // nothing is sent while queueing, the communicator is not even open
+    REQUIRE_FALSE(websocket_communicator->is_open());
+  }
+
+  SECTION("Command batch sends all its commands") {
+    // arrange
+    ccd.open();
+    auto batch = ccd.batch();
+    batch.add(&ChargeCoupledDevice::set_acquisition_format, 1,
+              ChargeCoupledDevice::AcquisitionFormat::SPECTRA_IMAGE)
+        .add(&ChargeCoupledDevice::set_exposure_time, 100)
+        .add(&ChargeCoupledDevice::set_acquisition_count, 1)
+        .add(Command("ccd_getExposureTime", {{"index", 0}}));
+
+    // act
+    const auto result = batch.execute();
+
+    // assert
+    REQUIRE(result.succeeded());
+    REQUIRE_NOTHROW(result.throw_if_failed());
+    REQUIRE(batch.size() == 0);
+    REQUIRE(result.outcomes.size() == 4);
+    REQUIRE(result.outcomes[0].command.name() == "ccd_setAcqFormat");
+    REQUIRE(result.outcomes[1].command.name() == "ccd_setExposureTime");
+    REQUIRE(result.outcomes[2].command.name() == "ccd_setAcqCount");
+    for (const auto& outcome : result.outcomes) {
+      REQUIRE(outcome.response.id() == outcome.command.id());
+    }
+    REQUIRE(result.outcomes[3].response.json_results().contains("time"));
+  }
+
+  SECTION("Command batch reports the errors of each command") {
+    // arrange
+    ccd.open();
+    auto batch = ccd.batch();
+    batch.add(&ChargeCoupledDevice::set_exposure_time, 100)
+        .add(Command("test_error"))
+        .add(&ChargeCoupledDevice::set_acquisition_count, 1);
+
+    // act
+    const auto result = batch.execute();
+
+    // assert
+    REQUIRE_FALSE(result.succeeded());
+    REQUIRE(result.outcomes[0].succeeded());
+    REQUIRE_FALSE(result.outcomes[1].succeeded());
+    REQUIRE(result.outcomes[1].response.errors().front() == "test error");
+    REQUIRE(result.outcomes[2].succeeded());
+    REQUIRE_THROWS_AS(result.throw_if_failed(), std::runtime_error);
+  }
+
+  SECTION("Command batch reads the capabilities a setter checks right away") {
+    // arrange
+    ccd.open();
+    ccd.restart();
+    auto batch = ccd.batch();
+
+    // act
+    batch.add(&ChargeCoupledDevice::set_trigger_input, true, 0, 1, 1);
+
+    // assert
+    // ccd_getConfig was sent, only the setter is queued
+    REQUIRE(batch.size() == 1);
+    REQUIRE(ccd.loaded_capabilities() != nullptr);
+    REQUIRE(batch.execute().succeeded());
+  }
+
+  SECTION("Command batch only takes setters of its device type") {
+    // arrange
+    auto batch = ccd.batch();
+
+    // act
+    // assert
+    REQUIRE_THROWS_AS(batch.add(&Monochromator::set_turret_grating,
+                                Monochromator::Grating::FIRST),
+                      std::invalid_argument);
+    REQUIRE(batch.size() == 0);
+  }
+
+  SECTION("Command batch cannot be sent if the communicator is closed") {
+    // arrange
+    auto batch = ccd.batch();
+    batch.add(&ChargeCoupledDevice::set_exposure_time, 100);
+
+    // act
+    // assert
+    REQUIRE_THROWS_AS(batch.execute(), std::runtime_error);
+  }
+
+  if (websocket_communicator->is_open()) {
+    websocket_communicator->close();
+  }
+}
+}  // namespace horiba::test
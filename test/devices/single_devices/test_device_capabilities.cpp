@@ -0,0 +1,114 @@
+#include <horiba_cpp_sdk/devices/single_devices/device_capabilities.h>
+
+#include <catch2/catch_test_macros.hpp>
+#include <nlohmann/json.hpp>
+
+namespace horiba::test {
+using namespace horiba::devices::single_devices;
+
+namespace {
+nlohmann::json ccd_configuration() {
+  return nlohmann::json::parse(R"({
+    "chipHeight": 256,
+    "chipName": "CCD30-11-1-275",
+    "chipWidth": 1024,
+    "deviceType": "HORIBA Scientific Syncerity",
+    "fitParameters": [0, 1, 0, 0, 0],
+    "gains": [{"info": "High Sensitivity", "token": 2},
+              {"info": "High Light", "token": 0}],
+    "productId": "13",
+    "serialNumber": "Camera SN:  2244",
+    "signals": [{"events": [{"name": "Shutter Open", "token": 3,
+                             "types": [{"name": "TTL Active High",
+                                        "token": 0}]}],
+                 "name": "Signal Output", "token": 0}],
+    "speeds": [{"info": "45 kHz", "token": 0}],
+    "triggers": [{"events": [{"name": "Once - Start All", "token": 0,
+                              "types": [{"name": "TTL Falling Edge",
+                                         "token": 0},
+                                        {"name": "TTL Rising  Edge",
+                                         "token": 1}]},
+                             {"name": "Each - For Each Acq", "token": 1,
+                              "types": [{"name": "TTL Falling Edge",
+                                         "token": 0}]}],
+                  "name": "Trigger Input", "token": 0}]
+  })");
+}
+}  // namespace
+
+TEST_CASE("CCD capabilities are compiled from the configuration",
+          "[device_capabilities]") {
+  // act
+  const auto capabilities = CcdCapabilities::parse(ccd_configuration());
+
+  // assert
+  REQUIRE(capabilities.chip_width == 1024);
+  REQUIRE(capabilities.chip_height == 256);
+  REQUIRE(capabilities.chip_name == "CCD30-11-1-275");
+  REQUIRE(capabilities.serial_number == "Camera SN:  2244");
+  REQUIRE(capabilities.fit_parameters.size() == 5);
+  REQUIRE(capabilities.gains.size() == 2);
+  REQUIRE(capabilities.gains[0].info == "High Sensitivity");
+  REQUIRE(capabilities.has_gain(2));
+  REQUIRE_FALSE(capabilities.has_gain(1));
+  REQUIRE(capabilities.has_speed(0));
+  REQUIRE(capabilities.configuration == ccd_configuration());
+
+  REQUIRE(capabilities.triggers.size() == 3);
+  REQUIRE(capabilities.triggers.contains(0, 0, 1));
+  REQUIRE(capabilities.triggers.contains(0, 1, 0));
+  REQUIRE_FALSE(capabilities.triggers.contains(0, 1, 1));
+  REQUIRE(capabilities.triggers.contains_event(0, 1));
+  REQUIRE_FALSE(capabilities.triggers.contains_event(0, 2));
+  REQUIRE(capabilities.triggers.contains_address(0));
+  REQUIRE_FALSE(capabilities.triggers.contains_address(1));
+
+  REQUIRE(capabilities.signals.size() == 1);
+  REQUIRE(capabilities.signals.contains(0, 3, 0));
+  REQUIRE_FALSE(capabilities.signals.contains(0, 0, 0));
+}
+
+TEST_CASE("CCD capabilities accept a partial configuration",
+          "[device_capabilities]") {
+  // act
+  const auto capabilities =
+      CcdCapabilities::parse(nlohmann::json::parse(R"({"chipWidth": 10})"));
+
+  // assert
+  REQUIRE(capabilities.chip_width == 10);
+  REQUIRE(capabilities.gains.empty());
+  REQUIRE(capabilities.triggers.size() == 0);
+  REQUIRE_FALSE(capabilities.triggers.contains_address(0));
+}
+
+TEST_CASE("Monochromator capabilities are compiled from the configuration",
+          "[device_capabilities]") {
+  // arrange
+  const auto configuration = nlohmann::json::parse(R"({
+    "filterWheels": [],
+    "gratings": [{"blaze": 0, "grooveDensity": 1800, "positionIndex": 0},
+                 {"blaze": 500, "grooveDensity": 300, "positionIndex": 2}],
+    "mirrors": [{"location": 1}, {"location": 2}],
+    "monoModel": "iHR320",
+    "ports": [{"monoPortLocation": 1, "slitType": 2}],
+    "procuctId": 257,
+    "serialNumber": ""
+  })");
+
+  // act
+  const auto capabilities = MonochromatorCapabilities::parse(configuration);
+
+  // assert
+  REQUIRE(capabilities.model == "iHR320");
+  REQUIRE(capabilities.product_id == "257");
+  REQUIRE(capabilities.gratings.size() == 2);
+  REQUIRE(capabilities.gratings[1].groove_density == 300.0);
+  REQUIRE(capabilities.gratings[1].blaze == 500.0);
+  REQUIRE(capabilities.has_grating(2));
+  REQUIRE_FALSE(capabilities.has_grating(1));
+  REQUIRE(capabilities.mirror_locations.size() == 2);
+  REQUIRE(capabilities.ports.size() == 1);
+  REQUIRE(capabilities.ports[0].slit_type == 2);
+  REQUIRE(capabilities.filter_wheels == 0);
+}
+}  // namespace horiba::test
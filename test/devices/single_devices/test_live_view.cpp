@@ -0,0 +1,111 @@
+#include <horiba_cpp_sdk/communication/websocket_communicator.h>
+#include <horiba_cpp_sdk/devices/single_devices/ccd.h>
+#include <horiba_cpp_sdk/devices/single_devices/live_view.h>
+#include <horiba_cpp_sdk/devices/single_devices/triple_buffer.h>
+
+#include <catch2/catch_test_macros.hpp>
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#include "../../fake_icl_server.h"
+
+namespace horiba::test {
+
+using namespace horiba::devices::single_devices;
+using namespace horiba::communication;
+
+TEST_CASE("Triple buffer hands over the latest value", "[live_view]") {
+  // arrange
+  TripleBuffer<int> buffer;
+
+  SECTION("Triple buffer is empty at first") {
+    // act
+    // assert
+    REQUIRE_FALSE(buffer.fresh());
+    REQUIRE_FALSE(buffer.take().has_value());
+  }
+
+  SECTION("Triple buffer returns a value once") {
+    // act
+    const auto replaced = buffer.publish(1);
+
+    // assert
+    REQUIRE_FALSE(replaced);
+    REQUIRE(buffer.fresh());
+    REQUIRE(buffer.take() == 1);
+    REQUIRE_FALSE(buffer.take().has_value());
+  }
+
+  SECTION("Triple buffer drops values never read") {
+    // act
+    buffer.publish(1);
+    const auto replaced = buffer.publish(2);
+    const auto value = buffer.take();
+    buffer.publish(3);
+    buffer.publish(4);
+
+    // assert
+    REQUIRE(replaced);
+    REQUIRE(value == 2);
+    REQUIRE(buffer.take() == 4);
+  }
+}
+
+TEST_CASE("Live view test with fake ICL", "[live_view]") {
+  // arrange
+  auto websocket_communicator = std::make_shared<WebSocketCommunicator>(
+      FakeICLServer::FAKE_ICL_ADDRESS,
+      std::to_string(FakeICLServer::FAKE_ICL_PORT));
+  auto ccd = std::make_shared<ChargeCoupledDevice>(0, websocket_communicator);
+  LiveView::Options options;
+  options.frame_timeout = std::chrono::seconds(2);
+
+  SECTION("Live view hands over the newest frames") {
+    // arrange
+    ccd->open();
+    LiveView live_view(ccd, options);
+
+    // act
+    live_view.start();
+    const auto first = live_view.wait_for_frame(std::chrono::seconds(2));
+    // the consumer falls behind
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    const auto second = live_view.wait_for_frame(std::chrono::seconds(2));
+    live_view.stop();
+    const auto statistics = live_view.statistics();
+
+    // assert
+    REQUIRE(first.has_value());
+    REQUIRE_FALSE(first->data.acquisitions().empty());
+    REQUIRE(second.has_value());
+    REQUIRE(second->sequence > first->sequence);
+    REQUIRE(statistics.taken_frames == 2);
+    REQUIRE(statistics.dropped_frames > 0);
+    REQUIRE(statistics.acquired_frames >=
+            statistics.taken_frames + statistics.dropped_frames);
+    REQUIRE(statistics.frames_per_second > 0.0);
+    REQUIRE(statistics.last_frame_age < std::chrono::seconds(2));
+  }
+
+  SECTION("Live view reports the error that stopped it") {
+    // arrange
+    // the communicator is not opened
+    LiveView live_view(ccd, options);
+
+    // act
+    live_view.start();
+
+    // assert
+    REQUIRE_THROWS_AS(live_view.wait_for_frame(std::chrono::seconds(2)),
+                      std::runtime_error);
+    REQUIRE_THROWS_AS(live_view.start(), std::runtime_error);
+  }
+
+  if (websocket_communicator->is_open()) {
+    websocket_communicator->close();
+  }
+}
+}  // namespace horiba::test
@@ -1,9 +1,15 @@
 #include <horiba_cpp_sdk/communication/websocket_communicator.h>
 #include <horiba_cpp_sdk/devices/single_devices/mono.h>
 
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/use_awaitable.hpp>
+#include <boost/asio/use_future.hpp>
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/matchers/catch_matchers_floating_point.hpp>
 #include <catch2/matchers/catch_matchers_string.hpp>
+#include <chrono>
+#include <vector>
 
 #include "../../fake_icl_server.h"
 
@@ -74,6 +80,22 @@ TEST_CASE("Mono test with fake ICL", "[mono_no_hw]") {
     REQUIRE_FALSE(config.empty());
   }
 
+  SECTION("Mono capabilities are cached while it is open") {
+    // arrange
+    mono.open();
+
+    // act
+    const auto capabilities = mono.capabilities();
+    const auto cached_capabilities = mono.capabilities();
+
+    // assert
+    REQUIRE(capabilities->model == "iHR320");
+    REQUIRE(capabilities->gratings.size() == 3);
+    REQUIRE(capabilities->has_grating(2));
+    REQUIRE(cached_capabilities == capabilities);
+    REQUIRE(mono.configuration() == capabilities->configuration);
+  }
+
   SECTION("Mono get current wavelength") {
     // arrange
     mono.open();
@@ -274,6 +296,166 @@ TEST_CASE("Mono test with fake ICL", "[mono_no_hw]") {
     REQUIRE(shutter_position == expected_shutter_position);
   }
 
+  SECTION("Mono can be used from a coroutine") {
+    // arrange
+    mono.open();
+    boost::asio::io_context context;
+    const double target_wavelength = 320.0;
+
+    // act
+    auto current_wavelength = boost::asio::co_spawn(
+        context,
+        [&]() -> boost::asio::awaitable<double> {
+          co_await mono.move_to_target_wavelength_async(target_wavelength);
+          co_await mono.wait_until_ready_async(std::chrono::seconds(1));
+          co_return co_await mono.get_current_wavelength_async();
+        },
+        boost::asio::use_future);
+    context.run();
+
+    // assert
+    REQUIRE_THAT(current_wavelength.get(), WithinAbs(target_wavelength, 0.1));
+  }
+
+  SECTION("One thread drives many mono coroutines at once") {
+    // arrange
+    mono.open();
+    boost::asio::io_context context;
+    const size_t amount_workflows = 20;
+
+    // act
+    std::vector<std::future<bool>> busy_results;
+    busy_results.reserve(amount_workflows);
+    for (size_t i = 0; i < amount_workflows; i++) {
+      busy_results.push_back(boost::asio::co_spawn(
+          context,
+          [&]() -> boost::asio::awaitable<bool> {
+            co_await mono.set_turret_grating_async(
+                Monochromator::Grating::SECOND);
+            co_return co_await mono.is_busy_async();
+          },
+          boost::asio::use_future));
+    }
+    context.run();
+
+    // assert
+    for (auto& busy : busy_results) {
+      REQUIRE_FALSE(busy.get());
+    }
+  }
+
+  SECTION("Mono coroutine fails when the communicator is closed") {
+    // arrange
+    boost::asio::io_context context;
+
+    // act
+    auto busy = boost::asio::co_spawn(context, mono.is_busy_async(),
+                                      boost::asio::use_future);
+    context.run();
+
+    // assert
+    REQUIRE_THROWS_AS(busy.get(), std::runtime_error);
+  }
+
+  SECTION("Mono wait polls soon instead of once a second") {
+    // arrange
+    mono.open();
+    const auto started = std::chrono::steady_clock::now();
+
+    // act
+    mono.move_to_target_wavelength(500.0);
+    mono.wait_until_ready(std::chrono::seconds(2));
+    mono.move_to_target_wavelength(520.0);
+    mono.wait_until_ready(std::chrono::seconds(2));
+
+    // assert
+    REQUIRE(std::chrono::steady_clock::now() - started <
+            std::chrono::milliseconds(500));
+  }
+
+  SECTION("Mono profile only moves what differs") {
+    // arrange
+    mono.open();
+    Monochromator::Profile profile;
+    profile.turret_grating = Monochromator::Grating::SECOND;
+    profile.wavelength = 500.0;
+    profile.slit_positions_in_mm[Monochromator::Slit::A] = 1.5;
+    profile.mirror_positions[Monochromator::Mirror::ENTRANCE] =
+        Monochromator::MirrorPosition::AXIAL;
+
+    // act
+    const auto first = mono.apply(profile, std::chrono::seconds(5));
+    const auto second = mono.apply(profile, std::chrono::seconds(5));
+
+    // assert
+    REQUIRE(first == 4);
+    REQUIRE(second == 0);
+    const auto known_settings = mono.known_settings();
+    REQUIRE(known_settings.turret_grating == Monochromator::Grating::SECOND);
+    REQUIRE(known_settings.slit_positions_in_mm.at(Monochromator::Slit::A) ==
+            1.5);
+  }
+
+  SECTION("Mono forgets the wavelength when the grating moves") {
+    // arrange
+    mono.open();
+    mono.move_to_target_wavelength(500.0);
+
+    // act
+    mono.set_turret_grating(Monochromator::Grating::THIRD);
+
+    // assert
+    const auto known_settings = mono.known_settings();
+    REQUIRE(known_settings.turret_grating == Monochromator::Grating::THIRD);
+    REQUIRE_FALSE(known_settings.wavelength.has_value());
+  }
+
+  SECTION("Mono forgets its known settings when it is homed") {
+    // arrange
+    mono.open();
+    mono.set_slit_position(Monochromator::Slit::A, 1.0);
+
+    // act
+    mono.home();
+
+    // assert
+    REQUIRE(mono.known_settings().slit_positions_in_mm.empty());
+  }
+
+  SECTION("Mono forgets the targets it may not have reached") {
+    // arrange
+    mono.open();
+    mono.move_to_target_wavelength(500.0);
+    websocket_communicator->close();
+
+    // act
+    // assert
+    REQUIRE_THROWS_AS(mono.wait_until_ready(std::chrono::seconds(1)),
+                      std::runtime_error);
+    REQUIRE_FALSE(mono.known_settings().wavelength.has_value());
+  }
+
+  SECTION("Mono tells the kind and distance of its pending moves") {
+    // arrange
+    mono.open();
+    mono.calibrate_wavelength(400.0);
+
+    // act
+    mono.move_to_target_wavelength(450.0);
+    const auto wavelength_travel = mono.take_pending_travel();
+    mono.set_slit_position(Monochromator::Slit::A, 1.0);
+    mono.move_to_target_wavelength(500.0);
+    const auto mixed_travel = mono.take_pending_travel();
+
+    // assert
+    REQUIRE(wavelength_travel.kind == MoveKind::WAVELENGTH);
+    REQUIRE(wavelength_travel.distance == 50.0);
+    REQUIRE(mixed_travel.kind == MoveKind::OTHER);
+    REQUIRE_FALSE(mixed_travel.distance.has_value());
+    // a travel is only taken once
+    REQUIRE_FALSE(mono.take_pending_travel().distance.has_value());
+  }
+
   if (websocket_communicator->is_open()) {
     websocket_communicator->close();
   }
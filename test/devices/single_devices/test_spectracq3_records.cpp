@@ -0,0 +1,118 @@
+#include <horiba_cpp_sdk/devices/single_devices/spectracq3_records.h>
+
+#include <catch2/catch_test_macros.hpp>
+#include <cmath>
+#include <cstdint>
+#include <nlohmann/json.hpp>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace horiba::test {
+
+using namespace horiba::devices::single_devices;
+
+namespace {
+nlohmann::json data_point(std::int64_t point_number) {
+  return {{"currentSignal", {{"unit", "uAmps"}, {"value", 9.15}}},
+          {"elapsedTime", point_number * 10},
+          {"eventMarker", point_number == 2},
+          {"overscaleCurrentChannel", false},
+          {"overscaleVoltageChannel", point_number == 1},
+          {"pointNumber", point_number},
+          {"voltageSignal", {{"unit", "Volts"}, {"value", -0.35}}}};
+}
+
+std::string response(const std::vector<nlohmann::json>& data) {
+  return nlohmann::json{{"command", "saq3_getAvailableData"},
+                        {"errors", nlohmann::json::array()},
+                        {"id", 1234},
+                        {"results", {{"data", data}}}}
+      .dump();
+}
+}  // namespace
+
+TEST_CASE("SpectrAcq3 records are decoded by column", "[spectracq3_records]") {
+  // arrange
+  const auto raw_response =
+      response({data_point(0), data_point(1), data_point(2)});
+
+  // act
+  const auto records = SpectrAcq3Records::parse(
+      raw_response, SpectrAcq3Channels::CURRENT | SpectrAcq3Channels::VOLTAGE);
+
+  // assert
+  REQUIRE(records.size() == 3);
+  REQUIRE(std::vector<std::int64_t>(records.point_numbers().begin(),
+                                    records.point_numbers().end()) ==
+          std::vector<std::int64_t>{0, 1, 2});
+  REQUIRE(records.elapsed_times()[2] == 20.0);
+  REQUIRE(records.values(SpectrAcq3Channels::CURRENT).size() == 3);
+  REQUIRE(records.values(SpectrAcq3Channels::CURRENT)[1] == 9.15);
+  REQUIRE(records.values(SpectrAcq3Channels::VOLTAGE)[0] == -0.35);
+  REQUIRE(records.unit(SpectrAcq3Channels::CURRENT) == "uAmps");
+  REQUIRE(records.unit(SpectrAcq3Channels::VOLTAGE) == "Volts");
+  REQUIRE(records.event_markers() == std::vector<bool>{false, false, true});
+  REQUIRE(records.overscale_voltage() ==
+          std::vector<bool>{false, true, false});
+  REQUIRE(records.overscale_current() ==
+          std::vector<bool>{false, false, false});
+}
+
+TEST_CASE("SpectrAcq3 records keep only the requested channels",
+          "[spectracq3_records]") {
+  // arrange
+  auto point = data_point(0);
+  point.erase("voltageSignal");
+  const auto raw_response = response({point});
+
+  // act
+  const auto records = SpectrAcq3Records::parse(
+      raw_response, SpectrAcq3Channels::VOLTAGE | SpectrAcq3Channels::PHOTON);
+  const auto record = records.record(0);
+
+  // assert
+  REQUIRE(std::isnan(records.values(SpectrAcq3Channels::VOLTAGE)[0]));
+  REQUIRE(std::isnan(records.values(SpectrAcq3Channels::PHOTON)[0]));
+  REQUIRE(records.unit(SpectrAcq3Channels::VOLTAGE).empty());
+  REQUIRE_THROWS_AS(records.values(SpectrAcq3Channels::CURRENT),
+                    std::invalid_argument);
+  REQUIRE_THROWS_AS(records.values(SpectrAcq3Channels::ALL),
+                    std::invalid_argument);
+  REQUIRE_FALSE(record.current.has_value());
+  REQUIRE(record.voltage.has_value());
+  REQUIRE_THROWS_AS(records.record(1), std::out_of_range);
+}
+
+TEST_CASE("SpectrAcq3 records share the unit strings",
+          "[spectracq3_records]") {
+  // arrange
+  const auto raw_response = response({data_point(0)});
+
+  // act
+  const auto first =
+      SpectrAcq3Records::parse(raw_response, SpectrAcq3Channels::ALL);
+  const auto second =
+      SpectrAcq3Records::parse(raw_response, SpectrAcq3Channels::ALL);
+
+  // assert
+  REQUIRE(first.unit(SpectrAcq3Channels::CURRENT).data() ==
+          second.unit(SpectrAcq3Channels::CURRENT).data());
+}
+
+TEST_CASE("SpectrAcq3 records reject invalid data", "[spectracq3_records]") {
+  // arrange
+  auto point = data_point(0);
+  point.erase("pointNumber");
+
+  // act & assert
+  REQUIRE(
+      SpectrAcq3Records::parse(response({}), SpectrAcq3Channels::ALL).empty());
+  REQUIRE_THROWS_AS(
+      SpectrAcq3Records::parse(response({point}), SpectrAcq3Channels::ALL),
+      std::invalid_argument);
+  REQUIRE_THROWS_AS(
+      SpectrAcq3Records::parse("{\"results\": ", SpectrAcq3Channels::ALL),
+      std::invalid_argument);
+}
+}  // namespace horiba::test
@@ -0,0 +1,189 @@
+#include <horiba_cpp_sdk/communication/command.h>
+#include <horiba_cpp_sdk/communication/communicator.h>
+#include <horiba_cpp_sdk/devices/single_devices/spectracq3.h>
+#include <horiba_cpp_sdk/devices/single_devices/spectracq3_stream.h>
+#include <horiba_cpp_sdk/devices/single_devices/spsc_ring.h>
+
+#include <catch2/catch_test_macros.hpp>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <nlohmann/json.hpp>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace horiba::test {
+
+using namespace horiba::devices::single_devices;
+using namespace horiba::communication;
+
+namespace {
+nlohmann::json data_point(std::int64_t point_number) {
+  return {{"currentSignal", {{"unit", "uAmps"}, {"value", 9.15}}},
+          {"elapsedTime", point_number * 10},
+          {"eventMarker", point_number == 2},
+          {"overscaleCurrentChannel", false},
+          {"overscaleVoltageChannel", false},
+          {"pointNumber", point_number},
+          {"voltageSignal", {{"unit", "Volts"}, {"value", -0.35}}}};
+}
+
+// answers saq3_getAvailableData with the queued batches of points
+class DataPointsCommunicator final : public Communicator {
+ public:
+  void open() override { this->opened = true; }
+  void close() override { this->opened = false; }
+  bool is_open() override { return this->opened; }
+
+  void request_async(const Command& command,
+                     ResponseHandler handler) override {
+    nlohmann::json data = nlohmann::json::array();
+    {
+      const std::lock_guard<std::mutex> lock(this->mutex);
+      if (command.name() == "saq3_getAvailableData" &&
+          !this->batches.empty()) {
+        data = this->batches.front();
+        this->batches.pop_front();
+      }
+    }
+    handler(nullptr, Response(command.id(), command.name(),
+                              {{"data", data}}, {}));
+  }
+
+  std::shared_ptr<BinaryMessageQueue> subscribe_binary_messages(
+      BinaryMessageType /*type*/, std::size_t capacity) override {
+    return std::make_shared<BinaryMessageQueue>(capacity);
+  }
+
+  void queue(std::vector<std::int64_t> point_numbers) {
+    nlohmann::json batch = nlohmann::json::array();
+    for (const auto point_number : point_numbers) {
+      batch.push_back(data_point(point_number));
+    }
+    const std::lock_guard<std::mutex> lock(this->mutex);
+    this->batches.push_back(batch);
+  }
+
+ private:
+  bool opened{true};
+  std::mutex mutex;
+  std::deque<nlohmann::json> batches;
+};
+}  // namespace
+
+TEST_CASE("SPSC ring passes values in order", "[spectracq3_stream]") {
+  // arrange
+  SpscRing<int> ring(3);
+
+  // act
+  const auto pushed = ring.try_push(1) && ring.try_push(2) &&
+                      ring.try_push(3) && ring.try_push(4);
+  const auto overflowed = ring.try_push(5);
+
+  // assert
+  REQUIRE(ring.capacity() == 4);
+  REQUIRE(pushed);
+  REQUIRE_FALSE(overflowed);
+  REQUIRE(ring.size() == 4);
+  REQUIRE(ring.try_pop() == 1);
+  REQUIRE(ring.try_pop() == 2);
+  REQUIRE(ring.try_push(5));
+  REQUIRE(ring.try_pop() == 3);
+  REQUIRE(ring.try_pop() == 4);
+  REQUIRE(ring.try_pop() == 5);
+  REQUIRE_FALSE(ring.try_pop().has_value());
+  REQUIRE_THROWS_AS(SpscRing<int>(0), std::invalid_argument);
+}
+
+TEST_CASE("SpectrAcq3 stream drains the data in the background",
+          "[spectracq3_stream]") {
+  // arrange
+  auto communicator = std::make_shared<DataPointsCommunicator>();
+  auto spectracq3 = std::make_shared<SpectrAcq3>(0, communicator);
+  SpectrAcq3Stream::Options options;
+  options.min_interval = std::chrono::milliseconds(1);
+  options.max_interval = std::chrono::milliseconds(10);
+
+  SECTION("SpectrAcq3 stream counts the missing points") {
+    // arrange
+    communicator->queue({0, 1, 2});
+    communicator->queue({3, 6});
+    communicator->queue({7});
+    SpectrAcq3Stream stream(spectracq3, options);
+
+    // act
+    stream.start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    stream.stop();
+    std::vector<std::int64_t> point_numbers;
+    while (auto record = stream.try_pop()) {
+      point_numbers.push_back(record->point_number);
+    }
+    const auto statistics = stream.statistics();
+
+    // assert
+    REQUIRE(point_numbers == std::vector<std::int64_t>{0, 1, 2, 3, 6, 7});
+    REQUIRE(statistics.records == 6);
+    REQUIRE(statistics.gaps == 1);
+    REQUIRE(statistics.missing_points == 2);
+    REQUIRE(statistics.overflowed_records == 0);
+    REQUIRE(statistics.fetches > 3);
+    REQUIRE(statistics.fetch_interval <= options.max_interval);
+  }
+
+  SECTION("SpectrAcq3 stream drops the records a full ring cannot hold") {
+    // arrange
+    options.capacity = 2;
+    communicator->queue({0, 1, 2, 3});
+    SpectrAcq3Stream stream(spectracq3, options);
+
+    // act
+    stream.start();
+    stream.stop();
+    const auto statistics = stream.statistics();
+
+    // assert
+    REQUIRE(statistics.records == 4);
+    REQUIRE(statistics.overflowed_records == 2);
+    REQUIRE(stream.try_pop()->point_number == 0);
+    REQUIRE(stream.try_pop()->point_number == 1);
+    REQUIRE_FALSE(stream.try_pop().has_value());
+  }
+
+  SECTION("SpectrAcq3 stream fetches only the requested channels") {
+    // arrange
+    communicator->queue({0});
+    SpectrAcq3Stream stream(spectracq3, options, SpectrAcq3Channels::VOLTAGE);
+
+    // act
+    stream.start();
+    stream.stop();
+    const auto record = stream.try_pop();
+
+    // assert
+    REQUIRE(record.has_value());
+    REQUIRE(record->voltage == -0.35);
+    REQUIRE_FALSE(record->current.has_value());
+    REQUIRE_THROWS_AS(
+        SpectrAcq3Stream(spectracq3, options, SpectrAcq3Channels::NONE),
+        std::invalid_argument);
+  }
+
+  SECTION("SpectrAcq3 stream reports the error that stopped it") {
+    // arrange
+    communicator->close();
+    SpectrAcq3Stream stream(spectracq3, options);
+
+    // act
+    stream.start();
+    stream.stop();
+
+    // assert
+    REQUIRE_THROWS_AS(stream.try_pop(), std::runtime_error);
+  }
+}
+}  // namespace horiba::test
@@ -0,0 +1,213 @@
+#include <horiba_cpp_sdk/communication/websocket_communicator.h>
+#include <horiba_cpp_sdk/devices/single_devices/ccd.h>
+#include <horiba_cpp_sdk/devices/single_devices/mono.h>
+#include <horiba_cpp_sdk/devices/single_devices/wait_set.h>
+#include <horiba_cpp_sdk/devices/single_devices/wait_strategy.h>
+
+#include <catch2/catch_test_macros.hpp>
+#include <chrono>
+#include <cstddef>
+#include <future>
+#include <memory>
+#include <stdexcept>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../../fake_icl_server.h"
+
+namespace horiba::test {
+
+using namespace horiba::devices::single_devices;
+using namespace horiba::communication;
+
+namespace {
+// busy for a given amount of polls, without ICL
+class PolledDevice final : public Device {
+ public:
+  explicit PolledDevice(std::size_t busy_polls,
+                        std::chrono::microseconds poll_interval =
+                            std::chrono::milliseconds(1))
+      : Device(0, nullptr), busy_polls{busy_polls} {
+    this->set_wait_strategy(
+        std::make_shared<FixedIntervalWait>(poll_interval));
+  }
+
+  void close() override {}
+
+  std::future<bool> request_busy() override {
+    this->polls++;
+    std::promise<bool> busy;
+    busy.set_value(this->polls <= this->busy_polls);
+    return busy.get_future();
+  }
+
+  [[nodiscard]] Travel take_pending_travel() override {
+    return std::exchange(this->pending_travel, std::nullopt)
+        .value_or(Travel{});
+  }
+
+  std::size_t busy_polls;
+  std::size_t polls{0};
+  std::optional<Travel> pending_travel;
+};
+
+// polls every millisecond and keeps the recorded waits
+class RecordingWait final : public WaitStrategy {
+ public:
+  [[nodiscard]] std::chrono::microseconds delay(
+      std::size_t /*poll*/, const Travel& /*travel*/) override {
+    return std::chrono::milliseconds(1);
+  }
+
+  void record(const Travel& travel,
+              std::chrono::microseconds duration) override {
+    this->records.emplace_back(travel, duration);
+  }
+
+  std::vector<std::pair<Travel, std::chrono::microseconds>> records;
+};
+
+}  // namespace
+
+TEST_CASE("Wait set polls devices together", "[wait_set]") {
+  SECTION("Wait set waits for all devices") {
+    // arrange
+    auto fast = std::make_shared<PolledDevice>(1);
+    auto slow = std::make_shared<PolledDevice>(3);
+    WaitSet waits;
+    waits.add(fast).add(slow).add(fast);
+
+    // act
+    waits.wait_all(std::chrono::seconds(1));
+
+    // assert
+    REQUIRE(waits.size() == 2);
+    // a ready device is not polled anymore
+    REQUIRE(fast->polls == 2);
+    REQUIRE(slow->polls == 4);
+  }
+
+  SECTION("Wait set returns the first ready devices") {
+    // arrange
+    auto fast = std::make_shared<PolledDevice>(1);
+    auto slow = std::make_shared<PolledDevice>(100);
+    WaitSet waits;
+    waits.add(slow).add(fast);
+
+    // act
+    const auto ready = waits.wait_any(std::chrono::seconds(1));
+
+    // assert
+    REQUIRE(ready.size() == 1);
+    REQUIRE(ready[0] == fast);
+    REQUIRE(slow->polls == 2);
+  }
+
+  SECTION("Wait set keeps the travel of the devices still busy") {
+    // arrange
+    auto fast = std::make_shared<PolledDevice>(1);
+    auto slow = std::make_shared<PolledDevice>(20);
+    auto slow_strategy = std::make_shared<RecordingWait>();
+    slow->set_wait_strategy(slow_strategy);
+    slow->pending_travel = Travel{MoveKind::WAVELENGTH, 50.0};
+    WaitSet waits;
+    waits.add(slow).add(fast);
+
+    // act
+    const auto started = std::chrono::steady_clock::now();
+    const auto first_ready = waits.wait_any(std::chrono::seconds(1));
+    const auto first_wait = std::chrono::steady_clock::now() - started;
+    waits.wait_all(std::chrono::seconds(1));
+
+    // assert
+    REQUIRE(first_ready == std::vector<std::shared_ptr<Device>>{fast});
+    REQUIRE(slow_strategy->records.size() == 1);
+    const auto& [travel, duration] = slow_strategy->records.front();
+    REQUIRE(travel.kind == MoveKind::WAVELENGTH);
+    REQUIRE(travel.distance == std::optional<double>(50.0));
+    // measured from the start of the first wait
+    REQUIRE(duration > first_wait);
+  }
+
+  SECTION("Wait set polls as soon as the first device may be ready") {
+    // arrange
+    auto slow = std::make_shared<PolledDevice>(3, std::chrono::seconds(1));
+    auto fast = std::make_shared<PolledDevice>(3);
+    WaitSet waits;
+    waits.add(slow).add(fast);
+
+    // act
+    const auto started = std::chrono::steady_clock::now();
+    waits.wait_all(std::chrono::seconds(10));
+
+    // assert
+    REQUIRE(std::chrono::steady_clock::now() - started <
+            std::chrono::milliseconds(500));
+    REQUIRE(slow->polls == 4);
+  }
+
+  SECTION("Wait set throws when the timeout is reached") {
+    // arrange
+    auto busy = std::make_shared<PolledDevice>(1000000);
+    WaitSet waits;
+    waits.add(busy);
+
+    // act
+    // assert
+    REQUIRE_THROWS_AS(waits.wait_all(std::chrono::milliseconds(20)),
+                      std::runtime_error);
+    REQUIRE_THROWS_AS(waits.wait_any(std::chrono::milliseconds(20)),
+                      std::runtime_error);
+  }
+
+  SECTION("Wait set rejects missing devices") {
+    // arrange
+    WaitSet waits;
+
+    // act
+    // assert
+    REQUIRE_THROWS_AS(waits.add(nullptr), std::invalid_argument);
+    REQUIRE_THROWS_AS(waits.wait_any(std::chrono::milliseconds(1)),
+                      std::runtime_error);
+    REQUIRE_NOTHROW(waits.wait_all(std::chrono::milliseconds(1)));
+  }
+}
+
+TEST_CASE("Wait set test with fake ICL", "[wait_set]") {
+  // arrange
+  auto websocket_communicator = std::make_shared<WebSocketCommunicator>(
+      FakeICLServer::FAKE_ICL_ADDRESS,
+      std::to_string(FakeICLServer::FAKE_ICL_PORT));
+  auto mono = std::make_shared<Monochromator>(0, websocket_communicator);
+  auto ccd = std::make_shared<ChargeCoupledDevice>(0, websocket_communicator);
+  auto mono_strategy = std::make_shared<PredictiveWait>();
+  mono->set_wait_strategy(mono_strategy);
+
+  SECTION("Wait set waits for a monochromator and a CCD") {
+    // arrange
+    mono->open();
+    WaitSet waits;
+    waits.add(mono).add(ccd);
+    mono->calibrate_wavelength(400.0);
+    mono->move_to_target_wavelength(500.0);
+
+    // act
+    const auto started = std::chrono::steady_clock::now();
+    waits.wait_all(std::chrono::seconds(2));
+
+    // assert
+    REQUIRE(std::chrono::steady_clock::now() - started <
+            std::chrono::milliseconds(500));
+    // the wait feeds the prediction of the monochromator for its kind of move
+    REQUIRE(mono_strategy->predict({MoveKind::WAVELENGTH, 100.0}).has_value());
+    REQUIRE_FALSE(
+        mono_strategy->predict({MoveKind::GRATING, 100.0}).has_value());
+  }
+
+  if (websocket_communicator->is_open()) {
+    websocket_communicator->close();
+  }
+}
+}  // namespace horiba::test
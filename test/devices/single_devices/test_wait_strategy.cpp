@@ -0,0 +1,167 @@
+#include <horiba_cpp_sdk/devices/single_devices/wait_strategy.h>
+
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/use_future.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <chrono>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+
+namespace horiba::test {
+using namespace horiba::devices::single_devices;
+using std::chrono::microseconds;
+using std::chrono::milliseconds;
+
+TEST_CASE("Wait strategies decide the delays between polls",
+          "[wait_strategy]") {
+  const Travel WAVELENGTH_10{MoveKind::WAVELENGTH, 10.0};
+
+  SECTION("Fixed interval wait always waits the same") {
+    // arrange
+    FixedIntervalWait wait(milliseconds(100));
+
+    // act
+    // assert
+    REQUIRE(wait.delay(0, {}) == milliseconds(100));
+    REQUIRE(wait.delay(10, {MoveKind::WAVELENGTH, 5.0}) == milliseconds(100));
+  }
+
+  SECTION("Exponential backoff wait doubles the delays up to a maximum") {
+    // arrange
+    ExponentialBackoffWait wait(milliseconds(5), 2.0, milliseconds(30));
+
+    // act
+    // assert
+    REQUIRE(wait.delay(0, {}) == milliseconds(5));
+    REQUIRE(wait.delay(1, {}) == milliseconds(10));
+    REQUIRE(wait.delay(2, {}) == milliseconds(20));
+    REQUIRE(wait.delay(3, {}) == milliseconds(30));
+    REQUIRE(wait.delay(100, {}) == milliseconds(30));
+  }
+
+  SECTION("Predictive wait backs off as long as it has no past wait") {
+    // arrange
+    PredictiveWait wait(ExponentialBackoffWait(milliseconds(5)));
+
+    // act
+    // assert
+    REQUIRE_FALSE(wait.predict(WAVELENGTH_10).has_value());
+    REQUIRE(wait.delay(0, WAVELENGTH_10) == milliseconds(5));
+  }
+
+  SECTION("Predictive wait fits the duration to the travel") {
+    // arrange
+    PredictiveWait wait(ExponentialBackoffWait(milliseconds(5)));
+    wait.record({MoveKind::WAVELENGTH, 10.0}, milliseconds(150));
+    wait.record({MoveKind::WAVELENGTH, 20.0}, milliseconds(250));
+    wait.record({MoveKind::WAVELENGTH, -40.0}, milliseconds(450));
+    const Travel travel{MoveKind::WAVELENGTH, 30.0};
+
+    // act
+    const auto prediction = wait.predict(travel);
+
+    // assert
+    REQUIRE(prediction.has_value());
+    REQUIRE(*prediction > milliseconds(340));
+    REQUIRE(*prediction < milliseconds(360));
+    // most of the predicted time is slept through before the first poll
+    REQUIRE(wait.delay(0, travel) > milliseconds(300));
+    REQUIRE(wait.delay(0, travel) < *prediction);
+    REQUIRE(wait.delay(1, travel) == milliseconds(5));
+  }
+
+  SECTION("Predictive wait keeps the waits of each kind of move apart") {
+    // arrange
+    PredictiveWait wait(ExponentialBackoffWait(milliseconds(5)));
+    wait.record({MoveKind::GRATING, 1.0}, milliseconds(3000));
+    wait.record({MoveKind::SLIT, 1.0}, milliseconds(100));
+
+    // act
+    // assert
+    REQUIRE(wait.predict({MoveKind::GRATING, 1.0}) == milliseconds(3000));
+    REQUIRE(wait.predict({MoveKind::SLIT, 1.0}) == milliseconds(100));
+    REQUIRE_FALSE(wait.predict(WAVELENGTH_10).has_value());
+    REQUIRE(wait.delay(0, WAVELENGTH_10) == milliseconds(5));
+  }
+
+  SECTION("Predictive wait ignores waits of unknown distance") {
+    // arrange
+    PredictiveWait wait(ExponentialBackoffWait(milliseconds(5)));
+    wait.record({MoveKind::WAVELENGTH, std::nullopt}, milliseconds(3000));
+    wait.record(WAVELENGTH_10, milliseconds(100));
+
+    // act
+    // assert
+    REQUIRE(wait.predict(WAVELENGTH_10) == milliseconds(100));
+    REQUIRE_FALSE(
+        wait.predict({MoveKind::WAVELENGTH, std::nullopt}).has_value());
+    // the first poll is not delayed without a prediction
+    REQUIRE(wait.delay(0, {MoveKind::WAVELENGTH, std::nullopt}) ==
+            milliseconds(5));
+  }
+
+  SECTION("Predictive wait forgets the oldest waits") {
+    // arrange
+    PredictiveWait wait(ExponentialBackoffWait{}, 2);
+    wait.record(WAVELENGTH_10, milliseconds(1000));
+    wait.record(WAVELENGTH_10, milliseconds(100));
+    wait.record(WAVELENGTH_10, milliseconds(100));
+
+    // act
+    // assert
+    REQUIRE(wait.predict(WAVELENGTH_10) == milliseconds(100));
+  }
+}
+
+TEST_CASE("Waiting until a device is idle", "[wait_strategy]") {
+  // arrange
+  auto strategy = std::make_shared<PredictiveWait>(
+      ExponentialBackoffWait(milliseconds(1), 2.0, milliseconds(10)));
+  const Travel travel{MoveKind::WAVELENGTH, 5.0};
+  int polls = 0;
+
+  SECTION("Wait polls until the device is not busy and records it") {
+    // act
+    const auto waited = wait_until_idle(
+        strategy, [&polls]() { return ++polls < 4; }, milliseconds(1000),
+        travel, "timeout");
+
+    // assert
+    REQUIRE(polls == 4);
+    REQUIRE(waited < milliseconds(500));
+    REQUIRE(strategy->predict(travel) == waited);
+  }
+
+  SECTION("Wait throws when the device stays busy") {
+    // act
+    // assert
+    REQUIRE_THROWS_AS(wait_until_idle(
+                          strategy, []() { return true; }, milliseconds(50),
+                          travel, "timeout"),
+                      std::runtime_error);
+    REQUIRE_FALSE(strategy->predict(travel).has_value());
+  }
+
+  SECTION("Wait can be awaited in a coroutine") {
+    // arrange
+    boost::asio::io_context context;
+    auto busy = [&polls]() -> boost::asio::awaitable<bool> {
+      co_return ++polls < 3;
+    };
+
+    // act
+    auto waited = boost::asio::co_spawn(
+        context,
+        wait_until_idle_async(strategy, busy, milliseconds(1000), travel,
+                              "timeout"),
+        boost::asio::use_future);
+    context.run();
+
+    // assert
+    REQUIRE(waited.get() < milliseconds(500));
+    REQUIRE(polls == 3);
+  }
+}
+}  // namespace horiba::test
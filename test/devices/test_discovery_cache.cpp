@@ -0,0 +1,74 @@
+#include <horiba_cpp_sdk/devices/discovery_cache.h>
+
+#include <catch2/catch_test_macros.hpp>
+#include <filesystem>
+#include <fstream>
+#include <nlohmann/json.hpp>
+
+namespace horiba::test {
+using namespace horiba::devices;
+
+TEST_CASE("Discovery cache", "[discovery_cache]") {
+  // arrange
+  const auto file =
+      std::filesystem::temp_directory_path() / "horiba_discovery_cache.json";
+  std::filesystem::remove(file);
+  const auto ccds = nlohmann::json::parse(R"([
+    {"deviceType": "HORIBA Scientific Syncerity", "index": 0,
+     "productId": 13, "serialNumber": "Camera SN:  2244"}
+  ])");
+
+  SECTION("Discovery cache is written and read back") {
+    // arrange
+    DiscoveryCache cache;
+    cache.charge_coupled_devices = ccds;
+    cache.configurations["Camera SN:  2244"] = {{"chipWidth", 1024}};
+
+    // act
+    cache.save(file);
+    const auto loaded = DiscoveryCache::load(file);
+
+    // assert
+    REQUIRE(loaded.has_value());
+    REQUIRE(loaded->charge_coupled_devices == ccds);
+    REQUIRE(loaded->monochromators.empty());
+    REQUIRE(loaded->configurations.at("Camera SN:  2244").at("chipWidth") ==
+            1024);
+    REQUIRE_FALSE(std::filesystem::exists(file.string() + ".tmp"));
+  }
+
+  SECTION("Missing or broken discovery cache is not loaded") {
+    // act
+    const auto missing = DiscoveryCache::load(file);
+    std::ofstream(file) << "{\"version\": 1, \"ccds\": [";
+    const auto broken = DiscoveryCache::load(file);
+    std::ofstream(file) << R"({"version": 0, "ccds": []})";
+    const auto other_version = DiscoveryCache::load(file);
+
+    // assert
+    REQUIRE_FALSE(missing.has_value());
+    REQUIRE_FALSE(broken.has_value());
+    REQUIRE_FALSE(other_version.has_value());
+  }
+
+  SECTION("Devices are the same if their indices and serials are") {
+    // arrange
+    auto padded = ccds;
+    padded[0]["serialNumber"] = "Camera SN:  2244   ";
+    auto moved = ccds;
+    moved[0]["index"] = 1;
+    auto other = ccds;
+    other[0]["serialNumber"] = "Camera SN:  2245";
+
+    // act
+    // assert
+    REQUIRE(DiscoveryCache::same_devices(ccds, padded));
+    REQUIRE_FALSE(DiscoveryCache::same_devices(ccds, moved));
+    REQUIRE_FALSE(DiscoveryCache::same_devices(ccds, other));
+    REQUIRE_FALSE(
+        DiscoveryCache::same_devices(ccds, nlohmann::json::array()));
+  }
+
+  std::filesystem::remove(file);
+}
+}  // namespace horiba::test
@@ -1,14 +1,25 @@
+#include <horiba_cpp_sdk/communication/communicator_pool.h>
+#include <horiba_cpp_sdk/devices/discovery_cache.h>
 #include <horiba_cpp_sdk/devices/icl_device_manager.h>
+#include <horiba_cpp_sdk/devices/single_devices/ccd.h>
+#include <horiba_cpp_sdk/devices/single_devices/mono.h>
 #include <horiba_cpp_sdk/os/process.h>
 
 #if _WIN32
 #include <horiba_cpp_sdk/os/windows_process.h>
 #endif
 
+#include <atomic>
 #include <catch2/catch_test_macros.hpp>
+#include <chrono>
+#include <cstddef>
 #include <cstdlib>
+#include <filesystem>
 #include <memory>
+#include <stdexcept>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include "../fake_icl_server.h"
 #include "../os/fake_process.h"
@@ -20,6 +31,41 @@ namespace horiba::test {
 
 using json = nlohmann::json;
 
+namespace {
+// answers every command right away, except the *_discover commands which
+// take a while, like on an ICL with devices connected
+class SlowDiscoveryCommunicator final
+    : public horiba::communication::Communicator {
+ public:
+  static constexpr std::chrono::milliseconds DISCOVERY_TIME{200};
+
+  void open() override { this->opened = true; }
+  void close() override { this->opened = false; }
+  bool is_open() override { return this->opened; }
+
+  void request_async(const horiba::communication::Command& command,
+                     ResponseHandler handler) override {
+    if (command.name().ends_with("_discover")) {
+      std::this_thread::sleep_for(DISCOVERY_TIME);
+    }
+    handler(nullptr,
+            horiba::communication::Response(
+                command.id(), command.name(),
+                {{"devices", nlohmann::json::array()}}, {}));
+  }
+
+  std::shared_ptr<horiba::communication::BinaryMessageQueue>
+  subscribe_binary_messages(horiba::communication::BinaryMessageType /*type*/,
+                            std::size_t capacity) override {
+    return std::make_shared<horiba::communication::BinaryMessageQueue>(
+        capacity);
+  }
+
+ private:
+  std::atomic<bool> opened{false};
+};
+}  // namespace
+
 TEST_CASE("ICL Device Manager test with fake ICL", "[icl_device_manager]") {
   spdlog::set_level(spdlog::level::debug);
 
@@ -41,6 +87,185 @@ TEST_CASE("ICL Device Manager test with fake ICL", "[icl_device_manager]") {
     REQUIRE(ccds.size() == 1);
     REQUIRE(monos.size() == 1);
   }
+
+  SECTION("Device manager starts as soon as the ICL answers") {
+    // act
+    device_manager.start();
+    const auto timing = device_manager.startup_timing();
+    device_manager.stop();
+
+    // assert
+    REQUIRE(fake_icl_process->running());
+    REQUIRE(device_manager.charge_coupled_devices().size() == 1);
+    REQUIRE(timing.attempts == 1);
+    REQUIRE(timing.total < std::chrono::seconds(2));
+    REQUIRE(timing.total >= timing.connect + timing.probe + timing.discovery);
+  }
+}
+
+TEST_CASE("ICL Device Manager discovers the device families concurrently",
+          "[icl_device_manager]") {
+  // arrange
+  const std::vector<std::shared_ptr<horiba::communication::Communicator>>
+      connections{std::make_shared<SlowDiscoveryCommunicator>()};
+  horiba::devices::ICLDeviceManager device_manager(
+      std::make_shared<horiba::os::FakeProcess>(),
+      std::make_shared<horiba::communication::CommunicatorPool>(
+          connections,
+          std::vector<std::shared_ptr<horiba::communication::Communicator>>{},
+          std::vector<
+              std::shared_ptr<horiba::communication::Communicator>>{}));
+
+  // act
+  device_manager.discover_devices();
+  const auto timing = device_manager.discovery_timing();
+
+  // assert
+  const auto discovery_time = SlowDiscoveryCommunicator::DISCOVERY_TIME;
+  REQUIRE(timing.charge_coupled_devices >= discovery_time);
+  REQUIRE(timing.monochromators >= discovery_time);
+  REQUIRE(timing.spectracq3s >= discovery_time);
+  // one after the other they would take at least the sum of their times
+  REQUIRE(timing.total * 2 < timing.charge_coupled_devices +
+                                 timing.monochromators + timing.spectracq3s);
+}
+
+TEST_CASE("ICL Device Manager gives up on an ICL that does not answer",
+          "[icl_device_manager]") {
+  // arrange
+  const std::shared_ptr<horiba::os::Process> fake_icl_process =
+      std::make_shared<horiba::os::FakeProcess>();
+  // nothing listens on this port
+  horiba::devices::ICLDeviceManager device_manager(
+      fake_icl_process, FakeICLServer::FAKE_ICL_ADDRESS,
+      std::to_string(FakeICLServer::FAKE_ICL_PORT + 1), true, false, {},
+      horiba::devices::ReadinessConfig{std::chrono::milliseconds(10),
+                                       std::chrono::milliseconds(40),
+                                       std::chrono::milliseconds(300)});
+  const auto started = std::chrono::steady_clock::now();
+
+  // act
+  // assert
+  REQUIRE_THROWS_AS(device_manager.start(), std::runtime_error);
+  REQUIRE(std::chrono::steady_clock::now() - started <
+          std::chrono::seconds(2));
+}
+
+TEST_CASE("ICL Device Manager restarts from the discovery cache",
+          "[icl_device_manager]") {
+  // arrange
+  const auto cache_file = std::filesystem::temp_directory_path() /
+                          "horiba_icl_device_manager_cache.json";
+  std::filesystem::remove(cache_file);
+  const std::shared_ptr<horiba::os::Process> fake_icl_process =
+      std::make_shared<horiba::os::FakeProcess>();
+  const auto make_device_manager = [&]() {
+    return std::make_unique<horiba::devices::ICLDeviceManager>(
+        fake_icl_process, FakeICLServer::FAKE_ICL_ADDRESS,
+        std::to_string(FakeICLServer::FAKE_ICL_PORT), false, false,
+        horiba::communication::ConnectionPoolConfig{},
+        horiba::devices::ReadinessConfig{}, cache_file);
+  };
+
+  SECTION("Discovered devices are written to the cache") {
+    // act
+    auto device_manager = make_device_manager();
+    device_manager->start();
+    const auto restored = device_manager->wait_for_cache_check();
+    device_manager->stop();
+
+    // assert
+    REQUIRE_FALSE(restored);
+    const auto cache = horiba::devices::DiscoveryCache::load(cache_file);
+    REQUIRE(cache.has_value());
+    REQUIRE(cache->charge_coupled_devices.size() == 1);
+    REQUIRE(cache->monochromators.size() == 1);
+  }
+
+  SECTION("Devices are taken from the cache and checked") {
+    // arrange
+    auto first_device_manager = make_device_manager();
+    first_device_manager->start();
+    first_device_manager->stop();
+    auto cache = horiba::devices::DiscoveryCache::load(cache_file).value();
+    cache.configurations["Camera SN:  2244"] = {{"chipWidth", 2048}};
+    cache.save(cache_file);
+
+    // act
+    auto device_manager = make_device_manager();
+    device_manager->start();
+    const auto confirmed = device_manager->wait_for_cache_check();
+    const auto ccds = device_manager->charge_coupled_devices();
+    device_manager->stop();
+
+    // assert
+    REQUIRE(confirmed);
+    REQUIRE(ccds.size() == 1);
+    // the configuration of the cache is used, the fake CCD has 1024 columns
+    REQUIRE(ccds[0]->loaded_capabilities()->chip_width == 2048);
+  }
+
+  SECTION("Configurations fetched on a run are not fetched on the next") {
+    // arrange
+    auto first_device_manager = make_device_manager();
+    first_device_manager->start();
+    first_device_manager->charge_coupled_devices()[0]->open();
+    first_device_manager->monochromators()[0]->open();
+    first_device_manager->charge_coupled_devices()[0]->close();
+    first_device_manager->monochromators()[0]->close();
+    first_device_manager->stop();
+    const auto ccd_configs = FakeICLServer::received("ccd_getConfig");
+    const auto mono_configs = FakeICLServer::received("mono_getConfig");
+
+    // act
+    auto device_manager = make_device_manager();
+    device_manager->start();
+    const auto confirmed = device_manager->wait_for_cache_check();
+    const auto ccd = device_manager->charge_coupled_devices()[0];
+    const auto mono = device_manager->monochromators()[0];
+    ccd->open();
+    mono->open();
+    const auto chip_width = ccd->capabilities()->chip_width;
+    ccd->close();
+    mono->close();
+    device_manager->stop();
+
+    // assert
+    REQUIRE(confirmed);
+    REQUIRE(chip_width == 1024);
+    REQUIRE(FakeICLServer::received("ccd_getConfig") == ccd_configs);
+    REQUIRE(FakeICLServer::received("mono_getConfig") == mono_configs);
+    // the save when stopping kept the configurations
+    const auto cache = horiba::devices::DiscoveryCache::load(cache_file);
+    REQUIRE(cache->configurations.size() == 2);
+  }
+
+  SECTION("Outdated cached devices are kept until discovered again") {
+    // arrange
+    horiba::devices::DiscoveryCache outdated;
+    outdated.charge_coupled_devices = nlohmann::json::parse(
+        R"([{"index": 0, "serialNumber": "replaced camera"},
+            {"index": 1, "serialNumber": "removed camera"}])");
+    outdated.configurations["replaced camera"] = {{"chipWidth", 2048}};
+    outdated.save(cache_file);
+
+    // act
+    auto device_manager = make_device_manager();
+    device_manager->start();
+    const auto confirmed = device_manager->wait_for_cache_check();
+    const auto cached_ccds = device_manager->charge_coupled_devices();
+    device_manager->discover_devices();
+    const auto ccds = device_manager->charge_coupled_devices();
+    device_manager->stop();
+
+    // assert
+    REQUIRE_FALSE(confirmed);
+    REQUIRE(cached_ccds.size() == 2);
+    REQUIRE(ccds.size() == 1);
+    REQUIRE(ccds[0]->loaded_capabilities() == nullptr);
+  }
+
+  std::filesystem::remove(cache_file);
 }
 
 TEST_CASE("ICL Device Manager test on hardware", "[icl_device_manager_hw]") {
@@ -0,0 +1,149 @@
+#include <horiba_cpp_sdk/communication/websocket_communicator.h>
+#include <horiba_cpp_sdk/core/stitching/simple_spectra_stitch.h>
+#include <horiba_cpp_sdk/core/stitching/weight_average_spectra_stitch.h>
+#include <horiba_cpp_sdk/devices/range_mode_calculator.h>
+#include <horiba_cpp_sdk/devices/single_devices/ccd.h>
+#include <horiba_cpp_sdk/devices/single_devices/mono.h>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+#include "../fake_icl_server.h"
+
+namespace horiba::test {
+
+using namespace horiba::devices;
+using namespace horiba::devices::single_devices;
+using namespace horiba::communication;
+
+namespace {
+constexpr double PRECISION = 1e-6;
+constexpr int CHIP_WIDTH = 1024;
+
+SpectrographGeometry geometry() {
+  SpectrographGeometry geometry;
+  geometry.focal_length_mm = 320.0;
+  geometry.included_angle_deg = 30.0;
+  geometry.pixel_width_um = 26.0;
+  return geometry;
+}
+}  // namespace
+
+TEST_CASE("Range mode calculator maps pixels to wavelengths",
+          "[range_mode_calculator]") {
+  // arrange
+  const RangeModeCalculator calculator(1200.0, CHIP_WIDTH, geometry());
+
+  // act
+  const auto center = calculator.wavelength_at_pixel(500.0, 511.5);
+  const auto [low, high] = calculator.coverage(500.0);
+
+  // assert
+  REQUIRE_THAT(center, Catch::Matchers::WithinAbs(500.0, PRECISION));
+  REQUIRE(low < 500.0);
+  REQUIRE(high > 500.0);
+  // roughly 2.5 nm per mm of chip for this grating
+  REQUIRE(high - low > 40.0);
+  REQUIRE(high - low < 80.0);
+  REQUIRE_THROWS_AS(calculator.wavelength_at_pixel(5000.0, 0.0),
+                    std::invalid_argument);
+}
+
+TEST_CASE("Range mode calculator covers the range with the fewest segments",
+          "[range_mode_calculator]") {
+  // arrange
+  const RangeModeCalculator calculator(1200.0, CHIP_WIDTH, geometry());
+  constexpr double overlap = 10.0;
+
+  // act
+  const auto centers = calculator.center_wavelengths(400.0, 600.0, overlap);
+
+  // assert
+  REQUIRE(centers.size() > 1);
+  REQUIRE_THAT(calculator.coverage(centers.front()).first,
+               Catch::Matchers::WithinAbs(400.0, PRECISION));
+  REQUIRE(calculator.coverage(centers.back()).second >= 600.0);
+  // without the last segment the range would not be covered
+  REQUIRE(calculator.coverage(centers[centers.size() - 2]).second < 600.0);
+  for (std::size_t i = 1; i < centers.size(); i++) {
+    const auto previous_end = calculator.wavelength_at_pixel(
+        centers[i - 1], CHIP_WIDTH - 1 - overlap);
+    REQUIRE(centers[i] > centers[i - 1]);
+    REQUIRE_THAT(calculator.coverage(centers[i]).first,
+                 Catch::Matchers::WithinAbs(previous_end, PRECISION));
+  }
+}
+
+TEST_CASE("Range mode calculator needs more segments for a larger overlap",
+          "[range_mode_calculator]") {
+  // arrange
+  const RangeModeCalculator calculator(1200.0, CHIP_WIDTH, geometry());
+
+  // act
+  const auto simple =
+      calculator.center_wavelengths<core::stitching::SimpleSpectraStitch>(
+          300.0, 900.0);
+  const auto weighted = calculator.center_wavelengths<
+      core::stitching::WeightAverageSpectraStitch>(300.0, 900.0);
+  const auto wide = calculator.center_wavelengths(300.0, 900.0, 500.0);
+
+  // assert
+  REQUIRE(weighted.size() >= simple.size());
+  REQUIRE(wide.size() > weighted.size());
+}
+
+TEST_CASE("Range mode calculator rejects invalid input",
+          "[range_mode_calculator]") {
+  // arrange
+  const RangeModeCalculator calculator(1200.0, CHIP_WIDTH, geometry());
+  auto no_focal_length = geometry();
+  no_focal_length.focal_length_mm = 0.0;
+
+  // act
+  // assert
+  REQUIRE_THROWS_AS(RangeModeCalculator(0.0, CHIP_WIDTH, geometry()),
+                    std::invalid_argument);
+  REQUIRE_THROWS_AS(RangeModeCalculator(1200.0, 1, geometry()),
+                    std::invalid_argument);
+  REQUIRE_THROWS_AS(RangeModeCalculator(1200.0, CHIP_WIDTH, no_focal_length),
+                    std::invalid_argument);
+  REQUIRE_THROWS_AS(calculator.center_wavelengths(600.0, 400.0, 1.0),
+                    std::invalid_argument);
+  REQUIRE_THROWS_AS(calculator.center_wavelengths(400.0, 600.0, CHIP_WIDTH),
+                    std::invalid_argument);
+  REQUIRE_THROWS_AS(calculator.center_wavelengths(400.0, 5000.0, 1.0),
+                    std::invalid_argument);
+}
+
+TEST_CASE("Range mode calculator test with fake ICL",
+          "[range_mode_calculator]") {
+  // arrange
+  auto websocket_communicator = std::make_shared<WebSocketCommunicator>(
+      FakeICLServer::FAKE_ICL_ADDRESS,
+      std::to_string(FakeICLServer::FAKE_ICL_PORT));
+  auto ccd = std::make_shared<ChargeCoupledDevice>(0, websocket_communicator);
+  auto mono = std::make_shared<Monochromator>(0, websocket_communicator);
+
+  SECTION("Range mode calculator takes the grating and chip of the devices") {
+    // arrange
+    ccd->open();
+    mono->open();
+    const RangeModeCalculator expected(1800.0, CHIP_WIDTH, geometry());
+
+    // act
+    const auto calculator = RangeModeCalculator::from_devices(
+        *ccd, *mono, Monochromator::Grating::FIRST, geometry());
+
+    // assert
+    REQUIRE(calculator.coverage(500.0) == expected.coverage(500.0));
+  }
+
+  if (websocket_communicator->is_open()) {
+    websocket_communicator->close();
+  }
+}
+}  // namespace horiba::test
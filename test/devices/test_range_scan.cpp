@@ -0,0 +1,83 @@
+#include <horiba_cpp_sdk/communication/websocket_communicator.h>
+#include <horiba_cpp_sdk/devices/range_scan.h>
+#include <horiba_cpp_sdk/devices/single_devices/ccd.h>
+#include <horiba_cpp_sdk/devices/single_devices/mono.h>
+
+#include <catch2/catch_test_macros.hpp>
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "../fake_icl_server.h"
+
+namespace horiba::test {
+
+using namespace horiba::devices;
+using namespace horiba::devices::single_devices;
+using namespace horiba::communication;
+
+TEST_CASE("Range scan test with fake ICL", "[range_scan]") {
+  // arrange
+  auto websocket_communicator = std::make_shared<WebSocketCommunicator>(
+      FakeICLServer::FAKE_ICL_ADDRESS,
+      std::to_string(FakeICLServer::FAKE_ICL_PORT));
+  auto ccd = std::make_shared<ChargeCoupledDevice>(0, websocket_communicator);
+  auto mono = std::make_shared<Monochromator>(0, websocket_communicator);
+  RangeScan::Options options;
+  options.start_wavelength = 400.0;
+  options.end_wavelength = 600.0;
+  options.move_timeout = std::chrono::seconds(2);
+  options.acquisition_timeout = std::chrono::seconds(2);
+
+  SECTION("Range scan acquires and stitches the segments") {
+    // arrange
+    ccd->open();
+    mono->open();
+    RangeScan scan(ccd, mono, options);
+
+    // act
+    const auto result = scan.run({450.0, 500.0, 550.0});
+
+    // assert
+    REQUIRE(result.segments.size() == 3);
+    REQUIRE(result.timings.size() == 3);
+    REQUIRE(result.timings[1].center_wavelength == 500.0);
+    REQUIRE(result.segments[2].size() == 2);
+    REQUIRE_FALSE(result.segments[2][0].empty());
+    REQUIRE(result.segments[2][0].size() == result.segments[2][1].size());
+    REQUIRE(result.spectrum.size() == 2);
+    REQUIRE_FALSE(result.spectrum[0].empty());
+    REQUIRE(result.spectrum[0].front() <= result.spectrum[0].back());
+    REQUIRE(result.duration.count() > 0);
+  }
+
+  SECTION("Range scan reports the error that stopped it") {
+    // arrange
+    // the communicator is not opened
+    RangeScan scan(ccd, mono, options);
+
+    // act
+    // assert
+    REQUIRE_THROWS_AS(scan.run({450.0, 500.0}), std::runtime_error);
+  }
+
+  SECTION("Range scan needs devices, a range and center wavelengths") {
+    // arrange
+    RangeScan scan(ccd, mono, options);
+    options.end_wavelength = options.start_wavelength;
+
+    // act
+    // assert
+    REQUIRE_THROWS_AS(RangeScan(nullptr, mono, options),
+                      std::invalid_argument);
+    REQUIRE_THROWS_AS(RangeScan(ccd, mono, options), std::invalid_argument);
+    REQUIRE_THROWS_AS(scan.run(std::vector<double>{}), std::invalid_argument);
+  }
+
+  if (websocket_communicator->is_open()) {
+    websocket_communicator->close();
+  }
+}
+}  // namespace horiba::test
@@ -0,0 +1,197 @@
+#include <horiba_cpp_sdk/communication/websocket_communicator.h>
+#include <horiba_cpp_sdk/devices/recipe_executor.h>
+#include <horiba_cpp_sdk/devices/single_devices/ccd.h>
+#include <horiba_cpp_sdk/devices/single_devices/mono.h>
+#include <horiba_cpp_sdk/devices/single_devices/spectracq3.h>
+
+#include <atomic>
+#include <catch2/catch_test_macros.hpp>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../fake_icl_server.h"
+
+namespace horiba::test {
+
+using namespace horiba::devices;
+using namespace horiba::devices::single_devices;
+using namespace horiba::communication;
+
+namespace {
+/**
+ * @brief Waits until the given amount of steps arrived, false if they did not
+ * arrive within a second.
+ */
+bool meet(std::atomic<int>& arrived, int expected) {
+  arrived++;
+  const auto deadline =
+      std::chrono::steady_clock::now() + std::chrono::seconds(1);
+  while (arrived < expected) {
+    if (std::chrono::steady_clock::now() > deadline) {
+      return false;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  return true;
+}
+}  // namespace
+
+TEST_CASE("Recipe test", "[recipe_executor]") {
+  // arrange
+  auto websocket_communicator = std::make_shared<WebSocketCommunicator>(
+      FakeICLServer::FAKE_ICL_ADDRESS,
+      std::to_string(FakeICLServer::FAKE_ICL_PORT));
+  auto ccd = std::make_shared<ChargeCoupledDevice>(0, websocket_communicator);
+  auto mono = std::make_shared<Monochromator>(0, websocket_communicator);
+  auto saq3 = std::make_shared<SpectrAcq3>(0, websocket_communicator);
+  RecipeExecutor executor;
+
+  SECTION("Recipe serializes the steps of a device") {
+    // arrange
+    Recipe recipe;
+    const auto move = recipe.add({"move", {mono}, [] {}});
+    const auto dark = recipe.add({"dark", {ccd}, [] {}});
+    const auto acquire = recipe.add({"acquire", {ccd}, [] {}, {move}});
+    const auto both = recipe.add({"both", {mono, saq3}, [] {}});
+
+    // act
+    const auto dependencies = recipe.dependencies();
+
+    // assert
+    REQUIRE(dependencies[move].empty());
+    REQUIRE(dependencies[dark].empty());
+    REQUIRE(dependencies[acquire] == std::vector<Recipe::StepId>{move, dark});
+    REQUIRE(dependencies[both] == std::vector<Recipe::StepId>{move});
+  }
+
+  SECTION("Recipe uses a device listed twice by a step once") {
+    // arrange
+    Recipe recipe;
+    const auto dark = recipe.add({"dark", {ccd}, [] {}});
+    std::atomic<int> runs{0};
+    const auto twice =
+        recipe.add({"twice", {ccd, mono, ccd}, [&runs] { runs++; }});
+
+    // act
+    const auto dependencies = recipe.dependencies();
+    const auto report = executor.run(recipe);
+
+    // assert
+    REQUIRE(recipe.steps()[twice].devices.size() == 2);
+    REQUIRE(dependencies[twice] == std::vector<Recipe::StepId>{dark});
+    REQUIRE(runs == 1);
+    REQUIRE(report.devices.size() == 2);
+  }
+
+  SECTION("Recipe rejects invalid steps") {
+    // arrange
+    Recipe recipe;
+
+    // act
+    // assert
+    REQUIRE_THROWS_AS(recipe.add({"no operation", {mono}, {}}),
+                      std::invalid_argument);
+    REQUIRE_THROWS_AS(recipe.add({"null device", {nullptr}, [] {}}),
+                      std::invalid_argument);
+    REQUIRE_THROWS_AS(recipe.add({"unknown", {mono}, [] {}, {0}}),
+                      std::invalid_argument);
+  }
+
+  SECTION("Recipe executor runs steps on different devices concurrently") {
+    // arrange
+    Recipe recipe;
+    std::atomic<int> arrived{0};
+    std::atomic<bool> concurrent{true};
+    for (const auto& device :
+         std::vector<std::shared_ptr<Device>>{mono, ccd, saq3}) {
+      recipe.add({"meet", {device}, [&] {
+                    if (!meet(arrived, 3)) {
+                      concurrent = false;
+                    }
+                  }});
+    }
+
+    // act
+    const auto report = executor.run(recipe);
+
+    // assert
+    REQUIRE(concurrent);
+    REQUIRE(report.steps.size() == 3);
+    REQUIRE(report.devices.size() == 3);
+    REQUIRE(report.devices[0].device == mono);
+  }
+
+  SECTION("Recipe executor respects the dependencies") {
+    // arrange
+    Recipe recipe;
+    std::mutex order_mutex;
+    std::vector<std::string> order;
+    const auto record = [&order, &order_mutex](std::string name) {
+      return [&order, &order_mutex, name] {
+        const std::lock_guard<std::mutex> lock(order_mutex);
+        order.push_back(name);
+      };
+    };
+    const auto move = recipe.add({"move", {mono}, [&] {
+                                    std::this_thread::sleep_for(
+                                        std::chrono::milliseconds(30));
+                                    record("move")();
+                                  }});
+    recipe.add({"acquire", {ccd}, record("acquire"), {move}});
+    recipe.add({"process", {}, record("process"), {1}});
+
+    // act
+    const auto report = executor.run(recipe);
+
+    // assert
+    REQUIRE(order == std::vector<std::string>{"move", "acquire", "process"});
+    REQUIRE(report.steps[1].start >= report.steps[0].end);
+    REQUIRE(report.steps[2].start >= report.steps[1].end);
+  }
+
+  SECTION("Recipe executor reports the critical path and idle times") {
+    // arrange
+    Recipe recipe;
+    const auto sleep = [](int milliseconds) {
+      return [milliseconds] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(milliseconds));
+      };
+    };
+    const auto move = recipe.add({"move", {mono}, sleep(50)});
+    recipe.add({"lamp", {saq3}, sleep(5)});
+    recipe.add({"acquire", {ccd}, sleep(50), {move}});
+
+    // act
+    const auto report = executor.run(recipe);
+
+    // assert
+    REQUIRE(report.critical_path == std::vector<Recipe::StepId>{0, 2});
+    REQUIRE(report.critical_path_duration >= std::chrono::milliseconds(100));
+    REQUIRE(report.duration >= report.critical_path_duration);
+    REQUIRE(report.devices.size() == 3);
+    // the CCD waits for the monochromator
+    REQUIRE(report.devices[2].device == ccd);
+    REQUIRE(report.devices[2].idle >= std::chrono::milliseconds(50));
+    REQUIRE(report.devices[1].busy < report.devices[1].idle);
+  }
+
+  SECTION("Recipe executor stops at the first failing step") {
+    // arrange
+    Recipe recipe;
+    bool acquired = false;
+    const auto move = recipe.add(
+        {"move", {mono}, [] { throw std::runtime_error("move failed"); }});
+    recipe.add({"acquire", {ccd}, [&acquired] { acquired = true; }, {move}});
+
+    // act
+    // assert
+    REQUIRE_THROWS_AS(executor.run(recipe), std::runtime_error);
+    REQUIRE_FALSE(acquired);
+  }
+}
+}  // namespace horiba::test
@@ -0,0 +1,181 @@
+#include <horiba_cpp_sdk/communication/websocket_communicator.h>
+#include <horiba_cpp_sdk/devices/scan_planner.h>
+#include <horiba_cpp_sdk/devices/single_devices/mono.h>
+
+#include <catch2/catch_test_macros.hpp>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "../fake_icl_server.h"
+
+namespace horiba::test {
+
+using namespace horiba::devices;
+using namespace horiba::devices::single_devices;
+using namespace horiba::communication;
+
+namespace {
+Monochromator::Profile point(Monochromator::Grating grating,
+                             double wavelength) {
+  Monochromator::Profile profile;
+  profile.turret_grating = grating;
+  profile.wavelength = wavelength;
+  return profile;
+}
+
+Monochromator::Profile point(double slit_position_in_mm, double wavelength) {
+  Monochromator::Profile profile;
+  profile.turret_grating = Monochromator::Grating::FIRST;
+  profile.wavelength = wavelength;
+  profile.slit_positions_in_mm[Monochromator::Slit::A] = slit_position_in_mm;
+  return profile;
+}
+}  // namespace
+
+TEST_CASE("Move cost model fits the measured moves", "[scan_planner]") {
+  // arrange
+  MoveCostModel model;
+  using Axis = MoveCostModel::Axis;
+  model.set_prior(Axis::WAVELENGTH, {std::chrono::milliseconds(100),
+                                     std::chrono::milliseconds(1)});
+
+  // act
+  const auto prior = model.predict(Axis::WAVELENGTH, 50.0);
+  model.record(Axis::WAVELENGTH, 10.0, std::chrono::seconds(1));
+  model.record(Axis::WAVELENGTH, 20.0, std::chrono::seconds(2));
+  const auto fitted = model.predict(Axis::WAVELENGTH, 30.0);
+
+  // assert
+  REQUIRE(prior == std::chrono::milliseconds(150));
+  REQUIRE(fitted == std::chrono::seconds(3));
+  REQUIRE(model.predict(Axis::GRATING, 1.0) > std::chrono::seconds(1));
+}
+
+TEST_CASE("Move cost model assumes a travel from an unknown wavelength",
+          "[scan_planner]") {
+  // arrange
+  MoveCostModel model;
+  using Axis = MoveCostModel::Axis;
+  model.set_prior(Axis::WAVELENGTH, {std::chrono::milliseconds(100),
+                                     std::chrono::milliseconds(1), 300.0});
+  Monochromator::Profile unknown;
+  Monochromator::Profile known;
+  known.wavelength = 490.0;
+  Monochromator::Profile to;
+  to.wavelength = 500.0;
+
+  // act
+  // assert
+  REQUIRE(model.transition(unknown, to) == std::chrono::milliseconds(400));
+  REQUIRE(model.transition(known, to) == std::chrono::milliseconds(110));
+}
+
+TEST_CASE("Scan planner groups by grating and sweeps upwards",
+          "[scan_planner]") {
+  // arrange
+  ScanPlanner planner(std::make_shared<MoveCostModel>());
+  const std::vector<Monochromator::Profile> points{
+      point(Monochromator::Grating::FIRST, 600.0),
+      point(Monochromator::Grating::SECOND, 500.0),
+      point(Monochromator::Grating::FIRST, 400.0),
+      point(Monochromator::Grating::SECOND, 450.0),
+      point(Monochromator::Grating::FIRST, 500.0)};
+  Monochromator::Profile start;
+  start.turret_grating = Monochromator::Grating::FIRST;
+  start.wavelength = 300.0;
+
+  // act
+  const auto plan = planner.plan(points, start);
+
+  // assert
+  REQUIRE(plan.order == std::vector<std::size_t>{2, 4, 0, 3, 1});
+  REQUIRE(plan.expected_duration > std::chrono::seconds(1));
+}
+
+TEST_CASE("Scan planner sweeps once per slit when slits are slow",
+          "[scan_planner]") {
+  // arrange
+  ScanPlanner planner(std::make_shared<MoveCostModel>());
+  const std::vector<Monochromator::Profile> points{
+      point(1.0, 400.0), point(2.0, 410.0), point(1.0, 420.0),
+      point(2.0, 430.0)};
+  const auto start = point(1.0, 400.0);
+
+  // act
+  const auto plan = planner.plan(points, start);
+
+  // assert
+  REQUIRE(plan.order == std::vector<std::size_t>{0, 2, 1, 3});
+  REQUIRE_THROWS_AS(ScanPlanner(nullptr), std::invalid_argument);
+}
+
+TEST_CASE("Scan planner test with fake ICL", "[scan_planner]") {
+  // arrange
+  auto websocket_communicator = std::make_shared<WebSocketCommunicator>(
+      FakeICLServer::FAKE_ICL_ADDRESS,
+      std::to_string(FakeICLServer::FAKE_ICL_PORT));
+  auto mono = std::make_shared<Monochromator>(0, websocket_communicator);
+  auto model = std::make_shared<MoveCostModel>();
+  ScanPlanner planner(model);
+
+  SECTION("Scan planner returns the measurements in the order of the points") {
+    // arrange
+    mono->open();
+    const std::vector<Monochromator::Profile> points{
+        point(Monochromator::Grating::FIRST, 600.0),
+        point(Monochromator::Grating::FIRST, 400.0),
+        point(Monochromator::Grating::FIRST, 500.0)};
+    std::vector<double> visited;
+
+    // act
+    const auto measurements = planner.run(
+        mono, points,
+        [&visited](const Monochromator::Profile& profile) {
+          visited.push_back(profile.wavelength.value());
+          return profile.wavelength.value();
+        },
+        std::chrono::seconds(2));
+
+    // assert
+    REQUIRE(measurements == std::vector<double>{600.0, 400.0, 500.0});
+    REQUIRE(visited == std::vector<double>{400.0, 500.0, 600.0});
+    REQUIRE(mono->known_settings().wavelength == std::optional<double>(600.0));
+    // the wavelength moves were measured
+    REQUIRE(model->predict(MoveCostModel::Axis::WAVELENGTH, 100.0) <
+            std::chrono::milliseconds(100));
+    // the moves from unknown settings were not
+    REQUIRE(model->predict(MoveCostModel::Axis::GRATING, 1.0) >
+            std::chrono::seconds(1));
+  }
+
+  SECTION("Scan planner measures accessory moves from known positions only") {
+    // arrange
+    mono->open();
+    const auto prior = model->predict(MoveCostModel::Axis::SLIT, 0.5);
+    const auto measure = [](const Monochromator::Profile& profile) {
+      return profile.wavelength.value();
+    };
+
+    // act
+    planner.run(mono, {point(0.5, 500.0)}, measure, std::chrono::seconds(2));
+    const auto after_unknown_start =
+        model->predict(MoveCostModel::Axis::SLIT, 0.5);
+    planner.run(mono, {point(1.0, 500.0)}, measure, std::chrono::seconds(2));
+    const auto after_known_start =
+        model->predict(MoveCostModel::Axis::SLIT, 0.5);
+
+    // assert
+    REQUIRE(after_unknown_start == prior);
+    REQUIRE(after_known_start < prior);
+  }
+
+  if (websocket_communicator->is_open()) {
+    websocket_communicator->close();
+  }
+}
+}  // namespace horiba::test
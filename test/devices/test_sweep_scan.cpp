@@ -0,0 +1,94 @@
+#include <horiba_cpp_sdk/communication/websocket_communicator.h>
+#include <horiba_cpp_sdk/devices/single_devices/mono.h>
+#include <horiba_cpp_sdk/devices/single_devices/spectracq3.h>
+#include <horiba_cpp_sdk/devices/sweep_scan.h>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "../fake_icl_server.h"
+
+namespace horiba::test {
+
+using namespace horiba::devices;
+using namespace horiba::devices::single_devices;
+using namespace horiba::communication;
+
+TEST_CASE("Sweep scan places the data points on the path of the mono",
+          "[sweep_scan]") {
+  // arrange
+  constexpr double PRECISION = 1e-9;
+  const std::vector<SweepScan::PositionSample> positions{
+      {0.0, 400.0}, {100.0, 400.0}, {200.0, 450.0}, {300.0, 500.0}};
+  const std::vector<double> elapsed_times{-10.0, 50.0, 150.0, 250.0, 400.0};
+  const std::vector<double> expected{400.0, 400.0, 425.0, 475.0, 500.0};
+
+  // act
+  const auto wavelengths = SweepScan::wavelengths_at(positions, elapsed_times);
+
+  // assert
+  REQUIRE(wavelengths.size() == expected.size());
+  for (std::size_t i = 0; i < expected.size(); i++) {
+    REQUIRE_THAT(wavelengths[i],
+                 Catch::Matchers::WithinAbs(expected[i], PRECISION));
+  }
+  REQUIRE_THROWS_AS(SweepScan::wavelengths_at({}, elapsed_times),
+                    std::invalid_argument);
+}
+
+TEST_CASE("Sweep scan test with fake ICL", "[sweep_scan]") {
+  // arrange
+  auto websocket_communicator = std::make_shared<WebSocketCommunicator>(
+      FakeICLServer::FAKE_ICL_ADDRESS,
+      std::to_string(FakeICLServer::FAKE_ICL_PORT));
+  auto saq3 = std::make_shared<SpectrAcq3>(0, websocket_communicator);
+  auto mono = std::make_shared<Monochromator>(0, websocket_communicator);
+  SweepScan::Options options;
+  options.start_wavelength = 400.0;
+  options.end_wavelength = 700.0;
+  options.scan_count = 1000;
+  options.time_step = 0.01;
+  options.integration_time = 0.005;
+
+  SECTION("Sweep scan needs devices, a range and an acquisition set") {
+    // arrange
+    auto empty_range = options;
+    empty_range.end_wavelength = empty_range.start_wavelength;
+    auto no_scans = options;
+    no_scans.scan_count = 0;
+    auto long_integration = options;
+    long_integration.integration_time = 0.02;
+
+    // act
+    // assert
+    REQUIRE_NOTHROW(SweepScan(saq3, mono, options));
+    REQUIRE_THROWS_AS(SweepScan(nullptr, mono, options),
+                      std::invalid_argument);
+    REQUIRE_THROWS_AS(SweepScan(saq3, nullptr, options),
+                      std::invalid_argument);
+    REQUIRE_THROWS_AS(SweepScan(saq3, mono, empty_range),
+                      std::invalid_argument);
+    REQUIRE_THROWS_AS(SweepScan(saq3, mono, no_scans), std::invalid_argument);
+    REQUIRE_THROWS_AS(SweepScan(saq3, mono, long_integration),
+                      std::invalid_argument);
+  }
+
+  SECTION("Sweep scan fails on closed devices") {
+    // arrange
+    SweepScan scan(saq3, mono, options);
+
+    // act
+    // assert
+    REQUIRE_THROWS_AS(scan.run(), std::runtime_error);
+  }
+
+  if (websocket_communicator->is_open()) {
+    websocket_communicator->close();
+  }
+}
+}  // namespace horiba::test
@@ -5,12 +5,20 @@
 
 #include <boost/asio.hpp>
 #include <boost/beast.hpp>
+#include <cstddef>
 #include <fstream>
 #include <iostream>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <nlohmann/json.hpp>
+#include <optional>
 #include <stdexcept>
+#include <string>
 #include <thread>
+#include <vector>
+
+#include "allocation_counter.h"
 
 namespace horiba::test {
 
@@ -23,12 +31,31 @@ namespace horiba::test {
  *
  * If the sent command is not found in the fake responses it will just return it
  * without errors.
+ *
+ * The "test_error" command is answered with a "test error" error.
+ *
+ * The response to the "test_hold_response" command is held back and only sent
+ * after the response to the next command, to simulate out of order responses.
+ *
+ * The "test_send_binary_messages" command makes the server send one binary
+ * log, information and data message before its response. The first byte of a
+ * binary message is its type tag.
+ *
+ * How often each command has been received is counted, see received().
+ *
+ * The allocations of the server threads are not counted by the
+ * AllocationCounter.
  */
 class FakeICLServer {
  public:
   static const int FAKE_ICL_PORT = 8765;
   static const std::string FAKE_ICL_ADDRESS;
   static std::string FAKE_RESPONSES_FOLDER_PATH;
+  // log, information and data message, tagged by their first byte
+  static inline const std::vector<std::vector<std::uint8_t>>
+      FAKE_BINARY_MESSAGES{{0, 'l', 'o', 'g'},
+                           {1, 'i', 'n', 'f', 'o'},
+                           {2, 0x10, 0x20, 0x30, 0x40}};
 
   FakeICLServer(std::string fake_responses_folder_path)
       : fake_responses_folder_path{std::move(fake_responses_folder_path)} {
@@ -40,6 +67,16 @@ class FakeICLServer {
     server_thread = std::thread([this] { this->run(); });
   }
 
+  /**
+   * @brief How often the command has been received since the start of the
+   * tests, by any server.
+   */
+  static std::size_t received(const std::string& command) {
+    const std::lock_guard<std::mutex> lock(received_mutex);
+    const auto count = received_commands.find(command);
+    return count == received_commands.end() ? 0 : count->second;
+  }
+
   ~FakeICLServer() {
     spdlog::debug("[FakeICLServer] ~FakeICLServer");
     this->run_server.store(false, std::memory_order_release);
@@ -68,6 +105,7 @@ class FakeICLServer {
   boost::asio::ip::tcp::socket socket{ioc};
 
   void run() {
+    AllocationCounter::ignore_current_thread();
     try {
       spdlog::debug("[FakeICLServerThread] server thread starting...");
       start_accept();
@@ -84,13 +122,15 @@ class FakeICLServer {
                                       const boost::system::error_code& error) {
       if (error) {
         spdlog::debug("[FakeICLServerThread] erro accept: {}", error.message());
-      }
+      } else {
+        spdlog::debug("[FakeICLServerThread] got new connection");
 
-      spdlog::debug("[FakeICLServerThread] got new connection");
-
-      std::thread([this, socket = std::move(socket)]() mutable {
-        do_session(std::move(socket));
-      }).detach();
+        // no session without a connection, a session started after the
+        // destructor cancelled the acceptor would outlive the server
+        std::thread([this, socket = std::move(socket)]() mutable {
+          do_session(std::move(socket));
+        }).detach();
+      }
 
       if (this->run_server.load(std::memory_order_acquire)) {
         start_accept();
@@ -136,6 +176,7 @@ class FakeICLServer {
   }
 
   void do_session(boost::asio::ip::tcp::socket socket) {
+    AllocationCounter::ignore_current_thread();
     try {
       spdlog::debug("[FakeICLServer] do_session");
       boost::beast::websocket::stream<boost::asio::ip::tcp::socket> websocket{
@@ -150,6 +191,10 @@ class FakeICLServer {
 
       websocket.accept();
 
+      // response of a "test_hold_response" command, sent after the response
+      // of the next command to simulate out of order responses
+      std::optional<std::string> held_response;
+
       for (;;) {
         boost::beast::flat_buffer buffer;
 
@@ -160,6 +205,10 @@ class FakeICLServer {
 
         const std::string command =
             json_command_request["command"].get<std::string>();
+        {
+          const std::lock_guard<std::mutex> lock(received_mutex);
+          received_commands[command]++;
+        }
         nlohmann::json response;
         if (command.compare(0, 4, "icl_") == 0) {
           response = this->icl_data[command];
@@ -175,10 +224,28 @@ class FakeICLServer {
           response["id"] = json_command_request["id"];
           response["results"] = nlohmann::json::object();
           response["errors"] = nlohmann::json::array();
+          if (command == "test_error") {
+            response["errors"].push_back("test error");
+          }
+        }
+
+        if (command == "test_send_binary_messages") {
+          websocket.binary(true);
+          for (const auto& binary_message : FAKE_BINARY_MESSAGES) {
+            websocket.write(boost::asio::buffer(binary_message));
+          }
         }
 
         websocket.text(websocket.got_text());
+        if (command == "test_hold_response") {
+          held_response = response.dump();
+          continue;
+        }
         websocket.write(boost::asio::buffer(response.dump()));
+        if (held_response.has_value()) {
+          websocket.write(boost::asio::buffer(held_response.value()));
+          held_response.reset();
+        }
       }
     } catch (boost::beast::system_error const& se) {
       if (se.code() != boost::beast::websocket::error::closed) {
@@ -198,6 +265,8 @@ class FakeICLServer {
   nlohmann::json mono_data;
   const std::string fake_responses_folder_path;
   std::mutex mutex;
+  static inline std::mutex received_mutex;
+  static inline std::map<std::string, std::size_t> received_commands;
 };
 
 inline const std::string FakeICLServer::FAKE_ICL_ADDRESS = "127.0.0.1";